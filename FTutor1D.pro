@@ -4,13 +4,13 @@
 #
 #-------------------------------------------------
 
-QT       += core gui xml printsupport
+QT       += core gui xml printsupport concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 TARGET = FTutor1D
 TEMPLATE = app
-QMAKE_CXXFLAGS += -std=c++14
+QMAKE_CXXFLAGS += -std=c++17
 LIBS += -lm
 
 SOURCES += \
@@ -24,7 +24,26 @@ SOURCES += \
     src/predefinedsignalsdialog.cpp \
     src/signal.cpp \
     src/qcustomplot/qcustomplot.cpp \
-    src/fourierspiralwidget.cpp
+    src/fourierspiralwidget.cpp \
+    src/fftplan.cpp \
+    src/spectrogram.cpp \
+    src/spectrogramwidget.cpp \
+    src/notchfilterbank.cpp \
+    src/binarysignalfile.cpp \
+    src/signaltextparser.cpp \
+    src/minmaxpyramid.cpp \
+    src/pagedsignal.cpp \
+    src/audiofile.cpp \
+    src/audioimportdialog.cpp \
+    src/signalbatch.cpp \
+    src/signalexporter.cpp \
+    src/compressedsignalfile.cpp \
+    src/sessionfile.cpp \
+    src/signalgenerator.cpp \
+    src/signalfollower.cpp \
+    src/plotrasterizer.cpp \
+    src/plotoverlay.cpp \
+    src/plotexporter.cpp
 
 HEADERS  += \
     src/aboutdialog.h \
@@ -36,4 +55,23 @@ HEADERS  += \
     src/predefinedsignalsdialog.h \
     src/signal.h \
     src/qcustomplot/qcustomplot.h \
-    src/fourierspiralwidget.h
+    src/fourierspiralwidget.h \
+    src/fftplan.h \
+    src/spectrogram.h \
+    src/spectrogramwidget.h \
+    src/notchfilterbank.h \
+    src/binarysignalfile.h \
+    src/signaltextparser.h \
+    src/minmaxpyramid.h \
+    src/pagedsignal.h \
+    src/audiofile.h \
+    src/audioimportdialog.h \
+    src/signalbatch.h \
+    src/signalexporter.h \
+    src/compressedsignalfile.h \
+    src/sessionfile.h \
+    src/signalgenerator.h \
+    src/signalfollower.h \
+    src/plotrasterizer.h \
+    src/plotoverlay.h \
+    src/plotexporter.h
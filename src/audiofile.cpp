@@ -0,0 +1,330 @@
+/**
+ * @file audiofile.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "audiofile.h"
+
+#include <QtEndian>
+
+#include <cstring>
+#include <algorithm>
+
+// format tags of the WAV fmt chunk
+#define WAVE_FORMAT_PCM 0x0001
+#define WAVE_FORMAT_IEEE_FLOAT 0x0003
+#define WAVE_FORMAT_EXTENSIBLE 0xFFFE
+
+using namespace FT1D;
+
+namespace
+{
+
+/**
+ * @brief sample decodes one sample of format F at @a p to a double in [-1, 1]
+ */
+template<AudioSampleFormat F>
+inline double sample(const uchar* p)
+{
+    switch(F)
+    {
+    case PCM_U8:
+        return (p[0] - 128) * (1.0 / 128.0);
+    case PCM_S16:
+        return qFromLittleEndian<qint16>(p) * (1.0 / 32768.0);
+    case PCM_S24:
+    {
+        // the third byte is sign extended by the arithmetic shift
+        const qint32 value = static_cast<qint32>(static_cast<quint32>(p[0]) << 8 | static_cast<quint32>(p[1]) << 16 | static_cast<quint32>(p[2]) << 24) >> 8;
+        return value * (1.0 / 8388608.0);
+    }
+    case PCM_S32:
+        return qFromLittleEndian<qint32>(p) * (1.0 / 2147483648.0);
+    case PCM_FLOAT32:
+    {
+        const quint32 bits = qFromLittleEndian<quint32>(p);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    case PCM_FLOAT64:
+    {
+        const quint64 bits = qFromLittleEndian<quint64>(p);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    }
+    return 0;
+}
+
+
+/**
+ * @brief convert decodes @a count frames of one channel, or the average of @a channels channels, if @a channels > 1.
+ * The loops have no branches and a constant stride, so the compiler can vectorize them.
+ */
+template<AudioSampleFormat F>
+void convert(const uchar* source, qint64 stride, int bytes, int channels, qint64 count, double* values)
+{
+    if(channels == 1)
+    {
+        for(qint64 i = 0; i < count; i++)
+        {
+            values[i] = sample<F>(source + i * stride);
+        }
+        return;
+    }
+
+    const double scale = 1.0 / channels;
+    for(qint64 i = 0; i < count; i++)
+    {
+        double sum = 0;
+        for(int c = 0; c < channels; c++)
+        {
+            sum += sample<F>(source + i * stride + c * bytes);
+        }
+        values[i] = sum * scale;
+    }
+}
+}
+
+
+AudioFile::AudioFile()
+{
+    data = nullptr;
+    size = 0;
+    samples = nullptr;
+    sampleFormat = PCM_S16;
+    channelCount = 0;
+    rate = 0;
+    frameCount = 0;
+}
+
+
+AudioFile::~AudioFile()
+{
+    close();
+}
+
+
+bool AudioFile::map(const QString& path)
+{
+    close();
+
+    file.setFileName(path);
+    if(!file.open(QIODevice::ReadOnly) || file.size() == 0)
+    {
+        file.close();
+        return false;
+    }
+
+    size = file.size();
+    data = file.map(0, size);
+    if(!data)
+    {
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+
+bool AudioFile::openWav(const QString& path)
+{
+    if(!map(path))
+    {
+        return false;
+    }
+
+    if(size < 12 || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0)
+    {
+        close();
+        return false;
+    }
+
+    int tag = 0;
+    int channels = 0;
+    quint32 sampleRate = 0;
+    int blockAlign = 0;
+    int bits = 0;
+    qint64 dataOffset = -1;
+    qint64 dataSize = 0;
+
+    // chunks follow each other, each padded to an even size
+    qint64 position = 12;
+    while(position + 8 <= size && dataOffset < 0)
+    {
+        const uchar* chunk = data + position;
+        const qint64 length = qFromLittleEndian<quint32>(chunk + 4);
+        const qint64 body = position + 8;
+
+        if(std::memcmp(chunk, "fmt ", 4) == 0 && length >= 16 && body + 16 <= size)
+        {
+            tag = qFromLittleEndian<quint16>(chunk + 8);
+            channels = qFromLittleEndian<quint16>(chunk + 10);
+            sampleRate = qFromLittleEndian<quint32>(chunk + 12);
+            blockAlign = qFromLittleEndian<quint16>(chunk + 20);
+            bits = qFromLittleEndian<quint16>(chunk + 22);
+
+            if(tag == WAVE_FORMAT_EXTENSIBLE && length >= 40 && body + 40 <= size)
+            {
+                // the first two bytes of the sub format GUID are the actual format tag
+                tag = qFromLittleEndian<quint16>(chunk + 32);
+            }
+        }
+        else if(std::memcmp(chunk, "data", 4) == 0)
+        {
+            dataOffset = body;
+            // streamed files may declare a larger size than written
+            dataSize = std::min(length, size - body);
+        }
+
+        position = body + length + (length & 1);
+    }
+
+    bool supported = true;
+    if(tag == WAVE_FORMAT_PCM)
+    {
+        switch(bits)
+        {
+        case 8: sampleFormat = PCM_U8; break;
+        case 16: sampleFormat = PCM_S16; break;
+        case 24: sampleFormat = PCM_S24; break;
+        case 32: sampleFormat = PCM_S32; break;
+        default: supported = false; break;
+        }
+    }
+    else if(tag == WAVE_FORMAT_IEEE_FLOAT)
+    {
+        switch(bits)
+        {
+        case 32: sampleFormat = PCM_FLOAT32; break;
+        case 64: sampleFormat = PCM_FLOAT64; break;
+        default: supported = false; break;
+        }
+    }
+    else
+    {
+        supported = false;
+    }
+
+    if(!supported || dataOffset < 0 || channels <= 0 || sampleRate == 0 || blockAlign != channels * bytesPerSample(sampleFormat))
+    {
+        close();
+        return false;
+    }
+
+    channelCount = channels;
+    rate = sampleRate;
+    samples = data + dataOffset;
+    frameCount = dataSize / blockAlign;
+
+    return true;
+}
+
+
+bool AudioFile::openRaw(const QString& path, AudioSampleFormat format, int channels, double sampleRate, qint64 offset)
+{
+    if(channels <= 0 || sampleRate <= 0 || offset < 0 || !map(path))
+    {
+        return false;
+    }
+
+    sampleFormat = format;
+    channelCount = channels;
+    rate = sampleRate;
+    samples = data + std::min(offset, size);
+    frameCount = (size - std::min(offset, size)) / (channels * bytesPerSample(format));
+
+    if(frameCount == 0)
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+
+void AudioFile::close()
+{
+    if(data)
+    {
+        file.unmap(data);
+        data = nullptr;
+    }
+    file.close();
+
+    samples = nullptr;
+    size = 0;
+    channelCount = 0;
+    rate = 0;
+    frameCount = 0;
+}
+
+
+qint64 AudioFile::read(qint64 firstFrame, qint64 count, int channel, double* values) const
+{
+    if(!isOpen() || firstFrame < 0 || firstFrame >= frameCount || channel >= channelCount)
+    {
+        return 0;
+    }
+
+    count = std::min(count, frameCount - firstFrame);
+
+    const int bytes = bytesPerSample(sampleFormat);
+    const qint64 stride = static_cast<qint64>(channelCount) * bytes;
+    const int mixed = channel < 0 ? channelCount : 1;
+    const uchar* source = samples + firstFrame * stride + (channel < 0 ? 0 : channel * bytes);
+
+    switch(sampleFormat)
+    {
+    case PCM_U8:
+        convert<PCM_U8>(source, stride, bytes, mixed, count, values);
+        break;
+    case PCM_S16:
+        convert<PCM_S16>(source, stride, bytes, mixed, count, values);
+        break;
+    case PCM_S24:
+        convert<PCM_S24>(source, stride, bytes, mixed, count, values);
+        break;
+    case PCM_S32:
+        convert<PCM_S32>(source, stride, bytes, mixed, count, values);
+        break;
+    case PCM_FLOAT32:
+        convert<PCM_FLOAT32>(source, stride, bytes, mixed, count, values);
+        break;
+    case PCM_FLOAT64:
+        convert<PCM_FLOAT64>(source, stride, bytes, mixed, count, values);
+        break;
+    }
+    return count;
+}
+
+
+bool AudioFile::isWavFile(const QString& path)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    char header[12];
+    return file.read(header, sizeof(header)) == sizeof(header)
+            && std::memcmp(header, "RIFF", 4) == 0 && std::memcmp(header + 8, "WAVE", 4) == 0;
+}
+
+
+int AudioFile::bytesPerSample(AudioSampleFormat format)
+{
+    switch(format)
+    {
+    case PCM_U8: return 1;
+    case PCM_S16: return 2;
+    case PCM_S24: return 3;
+    case PCM_S32: return 4;
+    case PCM_FLOAT32: return 4;
+    case PCM_FLOAT64: return 8;
+    }
+    return 1;
+}
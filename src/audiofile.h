@@ -0,0 +1,124 @@
+#ifndef AUDIOFILE_H
+#define AUDIOFILE_H
+
+/**
+ * @file audiofile.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of a memory mapped reader of WAV and headerless PCM audio files.
+ */
+
+#include <QFile>
+#include <QString>
+
+namespace FT1D
+{
+
+/**
+ * @brief The AudioSampleFormat enum denotes encoding of one sample. All formats are little endian.
+ */
+enum AudioSampleFormat
+{
+    PCM_U8,         // unsigned 8-bit integer, 128 is silence
+    PCM_S16,        // signed 16-bit integer
+    PCM_S24,        // signed 24-bit integer, packed in 3 bytes
+    PCM_S32,        // signed 32-bit integer
+    PCM_FLOAT32,    // IEEE 754 single precision
+    PCM_FLOAT64     // IEEE 754 double precision
+};
+
+
+/**
+ * @brief The AudioFile class gives access to interleaved audio samples of a WAV or raw PCM file. The file is memory mapped
+ * and nothing is converted when it is opened; samples are converted to doubles in [-1, 1] only when they are read,
+ * block by block, so that the conversion loops can be vectorized by the compiler.
+ */
+class AudioFile
+{
+public:
+
+    /**
+     * @brief AudioFile constructor, creates a closed file
+     */
+    AudioFile();
+
+    /**
+     * @brief ~AudioFile destructor, unmaps the file
+     */
+    ~AudioFile();
+
+    /**
+     * @brief openWav maps a WAV file (PCM, IEEE float or WAVE_FORMAT_EXTENSIBLE) and reads its format
+     * @param path path to the file
+     * @return true, if the file is a supported WAV file
+     */
+    bool openWav(const QString& path);
+
+    /**
+     * @brief openRaw maps a headerless PCM file
+     * @param path path to the file
+     * @param format encoding of the samples
+     * @param channels number of interleaved channels
+     * @param sampleRate number of frames per second
+     * @param offset number of bytes to skip at the beginning of the file
+     * @return true, if the file could be mapped and contains at least one frame
+     */
+    bool openRaw(const QString& path, AudioSampleFormat format, int channels, double sampleRate, qint64 offset = 0);
+
+    /**
+     * @brief close unmaps the file
+     */
+    void close();
+
+    inline bool isOpen() const { return data != nullptr; }
+    inline AudioSampleFormat format() const { return sampleFormat; }
+    inline int channels() const { return channelCount; }
+    inline double sampleRate() const { return rate; }
+    inline qint64 frames() const { return frameCount; }
+
+    /**
+     * @brief read converts samples of one channel to doubles in [-1, 1]
+     * @param firstFrame index of the first frame
+     * @param count number of frames
+     * @param channel channel to read, -1 for the average of all channels
+     * @param values output, @a count values
+     * @return number of frames converted, less than @a count at the end of the file
+     */
+    qint64 read(qint64 firstFrame, qint64 count, int channel, double* values) const;
+
+    /**
+     * @brief isWavFile checks the RIFF and WAVE identifiers of a file
+     * @param path path to the file
+     * @return true, if the file starts with a RIFF WAVE header
+     */
+    static bool isWavFile(const QString& path);
+
+    /**
+     * @brief bytesPerSample
+     * @param format
+     * @return size of one sample of @a format in bytes
+     */
+    static int bytesPerSample(AudioSampleFormat format);
+
+private:
+
+    /**
+     * @brief map maps the whole file @a path
+     * @return true on success
+     */
+    bool map(const QString& path);
+
+    QFile file;
+    uchar* data;
+    qint64 size;
+
+    // first byte of the first frame
+    const uchar* samples;
+
+    AudioSampleFormat sampleFormat;
+    int channelCount;
+    double rate;
+    qint64 frameCount;
+};
+}
+#endif // AUDIOFILE_H
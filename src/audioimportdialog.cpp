@@ -0,0 +1,209 @@
+/**
+ * @file audioimportdialog.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "audioimportdialog.h"
+
+#include <limits>
+
+using namespace FT1D;
+
+AudioImportDialog::AudioImportDialog(QWidget* parent, const QString& path, const Translation* translation) : QDialog(parent), path(path)
+{
+    setFixedSize(QSize(360, 230));
+    setModal(true);
+
+    raw = !AudioFile::isWavFile(path);
+
+    infoLabel = new QLabel(this);
+    infoLabel->setGeometry(10, 10, 340, 22);
+
+    formatLabel = new QLabel(this);
+    formatLabel->setGeometry(10, 40, 150, 22);
+    formatComboBox = new QComboBox(this);
+    formatComboBox->setGeometry(170, 40, 180, 22);
+    formatComboBox->addItem(QStringLiteral("8-bit unsigned"), PCM_U8);
+    formatComboBox->addItem(QStringLiteral("16-bit signed"), PCM_S16);
+    formatComboBox->addItem(QStringLiteral("24-bit signed"), PCM_S24);
+    formatComboBox->addItem(QStringLiteral("32-bit signed"), PCM_S32);
+    formatComboBox->addItem(QStringLiteral("32-bit float"), PCM_FLOAT32);
+    formatComboBox->addItem(QStringLiteral("64-bit float"), PCM_FLOAT64);
+    formatComboBox->setCurrentIndex(formatComboBox->findData(PCM_S16));
+
+    channelsLabel = new QLabel(this);
+    channelsLabel->setGeometry(10, 70, 150, 22);
+    channelsSpinBox = new QSpinBox(this);
+    channelsSpinBox->setGeometry(170, 70, 180, 22);
+    channelsSpinBox->setRange(1, 64);
+    channelsSpinBox->setValue(1);
+
+    rateLabel = new QLabel(this);
+    rateLabel->setGeometry(10, 100, 150, 22);
+    rateSpinBox = new QSpinBox(this);
+    rateSpinBox->setGeometry(170, 100, 180, 22);
+    rateSpinBox->setRange(1, 10000000);
+    rateSpinBox->setValue(44100);
+    rateSpinBox->setSuffix(QStringLiteral(" Hz"));
+
+    offsetLabel = new QLabel(this);
+    offsetLabel->setGeometry(10, 130, 150, 22);
+    offsetSpinBox = new QSpinBox(this);
+    offsetSpinBox->setGeometry(170, 130, 180, 22);
+    offsetSpinBox->setRange(0, std::numeric_limits<int>::max());
+    offsetSpinBox->setValue(0);
+
+    channelLabel = new QLabel(this);
+    channelLabel->setGeometry(10, 160, 150, 22);
+    channelComboBox = new QComboBox(this);
+    channelComboBox->setGeometry(170, 160, 180, 22);
+
+    okButton = new QPushButton(this);
+    okButton->setGeometry(250, 195, 100, 27);
+    cancelButton = new QPushButton(this);
+    cancelButton->setGeometry(140, 195, 100, 27);
+
+    // WAV files describe their format themselves
+    formatComboBox->setEnabled(raw);
+    channelsSpinBox->setEnabled(raw);
+    rateSpinBox->setEnabled(raw);
+    offsetSpinBox->setEnabled(raw);
+
+    if(translation)
+    {
+        setLocalizedTexts(translation);
+    }
+    else
+    {
+        setDefaultTexts();
+    }
+
+    if(raw)
+    {
+        reopenRaw();
+    }
+    else
+    {
+        audioFile.openWav(path);
+        updateInfo();
+    }
+
+    connect(formatComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, [=](int) { reopenRaw(); });
+    connect(channelsSpinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, [=](int) { reopenRaw(); });
+    connect(rateSpinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, [=](int) { reopenRaw(); });
+    connect(offsetSpinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, [=](int) { reopenRaw(); });
+
+    connect(okButton, &QPushButton::clicked, this, &QDialog::accept);
+    connect(cancelButton, &QPushButton::clicked, this, &QDialog::reject);
+}
+
+
+AudioImportDialog::~AudioImportDialog()
+{
+    delete infoLabel;
+    delete channelLabel;
+    delete channelComboBox;
+    delete formatLabel;
+    delete formatComboBox;
+    delete channelsLabel;
+    delete channelsSpinBox;
+    delete rateLabel;
+    delete rateSpinBox;
+    delete offsetLabel;
+    delete offsetSpinBox;
+    delete okButton;
+    delete cancelButton;
+}
+
+
+int AudioImportDialog::channel() const
+{
+    return channelComboBox->currentData().toInt();
+}
+
+
+void AudioImportDialog::reopenRaw()
+{
+    if(!raw)
+    {
+        return;
+    }
+
+    audioFile.openRaw(path, static_cast<AudioSampleFormat>(formatComboBox->currentData().toInt()),
+                      channelsSpinBox->value(), rateSpinBox->value(), offsetSpinBox->value());
+    updateInfo();
+}
+
+
+void AudioImportDialog::updateInfo()
+{
+    channelComboBox->clear();
+
+    if(!audioFile.isOpen())
+    {
+        infoLabel->setText(QStringLiteral("—"));
+        okButton->setEnabled(false);
+        return;
+    }
+
+    infoLabel->setText(QStringLiteral("%1 × %2 bit, %3 Hz, %4 s")
+                       .arg(audioFile.channels())
+                       .arg(AudioFile::bytesPerSample(audioFile.format()) * 8)
+                       .arg(audioFile.sampleRate())
+                       .arg(audioFile.frames() / audioFile.sampleRate(), 0, 'f', 2));
+
+    for(int c = 0; c < audioFile.channels(); c++)
+    {
+        channelComboBox->addItem(QString::number(c + 1), c);
+    }
+    if(audioFile.channels() > 1)
+    {
+        channelComboBox->addItem(averageText, -1);
+    }
+    okButton->setEnabled(true);
+}
+
+
+void AudioImportDialog::setDefaultTexts()
+{
+    setWindowTitle(QStringLiteral("Import audio..."));
+    formatLabel->setText(QStringLiteral("Sample format:"));
+    channelsLabel->setText(QStringLiteral("Channels:"));
+    rateLabel->setText(QStringLiteral("Sample rate:"));
+    offsetLabel->setText(QStringLiteral("Header bytes to skip:"));
+    channelLabel->setText(QStringLiteral("Import channel:"));
+    okButton->setText(QStringLiteral("OK"));
+    cancelButton->setText(QStringLiteral("Cancel"));
+    averageText = QStringLiteral("Average of all channels");
+}
+
+
+void AudioImportDialog::setLocalizedTexts(const Translation* language)
+{
+    setWindowTitle(language->getTitle());
+    if(windowTitle().isEmpty()) setWindowTitle(QStringLiteral("Import audio..."));
+
+    formatLabel->setText(language->getChildElementText(QStringLiteral("formatLabel")));
+    if(formatLabel->text().isEmpty()) formatLabel->setText(QStringLiteral("Sample format:"));
+
+    channelsLabel->setText(language->getChildElementText(QStringLiteral("channelsLabel")));
+    if(channelsLabel->text().isEmpty()) channelsLabel->setText(QStringLiteral("Channels:"));
+
+    rateLabel->setText(language->getChildElementText(QStringLiteral("rateLabel")));
+    if(rateLabel->text().isEmpty()) rateLabel->setText(QStringLiteral("Sample rate:"));
+
+    offsetLabel->setText(language->getChildElementText(QStringLiteral("offsetLabel")));
+    if(offsetLabel->text().isEmpty()) offsetLabel->setText(QStringLiteral("Header bytes to skip:"));
+
+    channelLabel->setText(language->getChildElementText(QStringLiteral("channelLabel")));
+    if(channelLabel->text().isEmpty()) channelLabel->setText(QStringLiteral("Import channel:"));
+
+    okButton->setText(language->getChildElementText(QStringLiteral("okButton")));
+    if(okButton->text().isEmpty()) okButton->setText(QStringLiteral("OK"));
+
+    cancelButton->setText(language->getChildElementText(QStringLiteral("cancelButton")));
+    if(cancelButton->text().isEmpty()) cancelButton->setText(QStringLiteral("Cancel"));
+
+    averageText = language->getChildElementText(QStringLiteral("averageText"));
+    if(averageText.isEmpty()) averageText = QStringLiteral("Average of all channels");
+}
@@ -0,0 +1,113 @@
+#ifndef AUDIOIMPORTDIALOG_H
+#define AUDIOIMPORTDIALOG_H
+
+/**
+ * @file audioimportdialog.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of the dialog, in which an audio file to import is configured.
+ */
+
+#include "audiofile.h"
+#include "localization.h"
+
+#include <QDialog>
+#include <QLabel>
+#include <QComboBox>
+#include <QSpinBox>
+#include <QPushButton>
+
+namespace FT1D
+{
+
+/**
+ * @brief The AudioImportDialog class lets the user choose the channel of an audio file to import. WAV files describe
+ * their format themselves; for headerless PCM files the sample format, the number of channels, the sample rate
+ * and the length of a header to skip are set in the dialog.
+ */
+class AudioImportDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief AudioImportDialog constructor, opens the file @a path
+     * @param parent parent object
+     * @param path path to a WAV or raw PCM file
+     * @param translation provides localized names for this dialog
+     */
+    AudioImportDialog(QWidget* parent, const QString& path, const Translation* translation);
+
+    /**
+     * @brief ~AudioImportDialog destructor
+     */
+    virtual ~AudioImportDialog();
+
+    /**
+     * @brief audio
+     * @return the configured audio file, open if the configuration is valid
+     */
+    inline const AudioFile& audio() const
+    {
+        return audioFile;
+    }
+
+    /**
+     * @brief channel
+     * @return the chosen channel, -1 for the average of all channels
+     */
+    int channel() const;
+
+private:
+
+    /**
+     * @brief reopenRaw opens the file as raw PCM with the values set in the dialog
+     */
+    void reopenRaw();
+
+    /**
+     * @brief updateInfo describes the opened file and fills the list of channels
+     */
+    void updateInfo();
+
+    /**
+     * @brief setDefaultTexts sets defaults values to each text or title or label in the window.
+     */
+    void setDefaultTexts();
+
+    /**
+     * @brief setLocalizedTexts sets text, title or label values according to given Translation object`
+     * @param language Translation object used to set texts
+     */
+    void setLocalizedTexts(const Translation* language);
+
+    // Attributes
+    AudioFile audioFile;
+    QString path;
+    bool raw;
+
+    QLabel* infoLabel;
+
+    QLabel* channelLabel;
+    QComboBox* channelComboBox;
+
+    QLabel* formatLabel;
+    QComboBox* formatComboBox;
+
+    QLabel* channelsLabel;
+    QSpinBox* channelsSpinBox;
+
+    QLabel* rateLabel;
+    QSpinBox* rateSpinBox;
+
+    QLabel* offsetLabel;
+    QSpinBox* offsetSpinBox;
+
+    QPushButton* okButton;
+    QPushButton* cancelButton;
+
+    // localized "Average of all channels"
+    QString averageText;
+};
+}
+#endif // AUDIOIMPORTDIALOG_H
@@ -0,0 +1,202 @@
+/**
+ * @file binarysignalfile.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "binarysignalfile.h"
+
+#include <QtEndian>
+#include <QVector>
+
+#include <cstring>
+#include <algorithm>
+
+// number of samples converted and written at once
+#define FT1B_WRITE_CHUNK 65536
+
+using namespace FT1D;
+
+BinarySignalFile::BinarySignalFile()
+{
+    data = nullptr;
+}
+
+
+BinarySignalFile::~BinarySignalFile()
+{
+    close();
+}
+
+
+bool BinarySignalFile::open(const QString& path)
+{
+    close();
+
+#if Q_BYTE_ORDER != Q_LITTLE_ENDIAN
+    // samples are mapped directly, they would have to be swapped
+    return false;
+#endif
+
+    file.setFileName(path);
+    if(!file.open(QIODevice::ReadOnly) || file.size() < FT1B_HEADER_SIZE)
+    {
+        file.close();
+        return false;
+    }
+
+    data = file.map(0, file.size());
+    if(!data)
+    {
+        file.close();
+        return false;
+    }
+
+    if(!isValidHeader(header(), file.size()))
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+
+void BinarySignalFile::close()
+{
+    if(data)
+    {
+        file.unmap(data);
+        data = nullptr;
+    }
+    file.close();
+}
+
+
+bool BinarySignalFile::verify() const
+{
+    if(!isOpen())
+    {
+        return false;
+    }
+    return checksum(samples(), count() * sampleSize(header().dtype)) == header().checksum;
+}
+
+
+quint64 BinarySignalFile::checksum(const uchar* bytes, qint64 size, quint64 seed)
+{
+    quint64 hash = seed;
+
+    qint64 i = 0;
+    for(; i + 8 <= size; i += 8)
+    {
+        hash ^= qFromLittleEndian<quint64>(bytes + i);
+        hash *= Q_UINT64_C(0x100000001b3);
+        hash ^= hash >> 29;
+    }
+
+    if(i < size)
+    {
+        uchar tail[8] = {0};
+        std::memcpy(tail, bytes + i, size - i);
+        hash ^= qFromLittleEndian<quint64>(tail);
+        hash *= Q_UINT64_C(0x100000001b3);
+        hash ^= hash >> 29;
+    }
+    return hash;
+}
+
+
+bool BinarySignalFile::isValidHeader(const BinarySignalHeader& header, qint64 fileSize)
+{
+    const int size = sampleSize(header.dtype);
+
+    return fileSize >= FT1B_HEADER_SIZE
+            && std::memcmp(header.magic, FT1B_MAGIC, sizeof(FT1B_MAGIC)) == 0
+            && header.version >= 1 && header.version <= FT1B_VERSION
+            && size != 0
+            && header.count <= static_cast<quint64>((fileSize - FT1B_HEADER_SIZE) / size);
+}
+
+
+bool BinarySignalFile::isBinarySignalFile(const QString& path)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    char magic[sizeof(FT1B_MAGIC)];
+    return file.read(magic, sizeof(magic)) == sizeof(magic) && std::memcmp(magic, FT1B_MAGIC, sizeof(magic)) == 0;
+}
+
+
+bool BinarySignalFile::write(const QString& path, double x0, double spacing, const double* values, qint64 count, BinarySampleType dtype)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return false;
+    }
+
+    BinarySignalHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, FT1B_MAGIC, sizeof(FT1B_MAGIC));
+    header.version = FT1B_VERSION;
+    header.dtype = dtype;
+    header.count = static_cast<quint64>(count);
+    header.x0 = x0;
+    header.spacing = spacing;
+
+    // the checksum is filled in after the samples are written
+    if(file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header))
+    {
+        return false;
+    }
+
+    quint64 hash = FT1B_CHECKSUM_SEED;
+
+    if(dtype == FT1B_FLOAT32)
+    {
+        QVector<float> chunk(FT1B_WRITE_CHUNK);
+        for(qint64 start = 0; start < count; start += FT1B_WRITE_CHUNK)
+        {
+            const int size = static_cast<int>(std::min<qint64>(FT1B_WRITE_CHUNK, count - start));
+            std::copy(values + start, values + start + size, chunk.begin());
+
+            const qint64 bytes = size * static_cast<qint64>(sizeof(float));
+            hash = checksum(reinterpret_cast<const uchar*>(chunk.constData()), bytes, hash);
+            if(file.write(reinterpret_cast<const char*>(chunk.constData()), bytes) != bytes)
+            {
+                return false;
+            }
+        }
+    }
+    else
+    {
+        const qint64 bytes = count * static_cast<qint64>(sizeof(double));
+        hash = checksum(reinterpret_cast<const uchar*>(values), bytes, hash);
+        if(file.write(reinterpret_cast<const char*>(values), bytes) != bytes)
+        {
+            return false;
+        }
+    }
+
+    header.checksum = hash;
+    return file.seek(0) && file.write(reinterpret_cast<const char*>(&header), sizeof(header)) == sizeof(header);
+}
+
+
+int BinarySignalFile::sampleSize(quint32 dtype)
+{
+    switch(dtype)
+    {
+    case FT1B_FLOAT64:
+        return sizeof(double);
+    case FT1B_FLOAT32:
+        return sizeof(float);
+    case FT1B_COMPLEX128:
+        return 2 * sizeof(double);
+    default:
+        return 0;
+    }
+}
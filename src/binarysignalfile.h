@@ -0,0 +1,205 @@
+#ifndef BINARYSIGNALFILE_H
+#define BINARYSIGNALFILE_H
+
+/**
+ * @file binarysignalfile.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of the binary signal file format (.ft1b) and a memory mapped reader of it.
+ */
+
+#include <QFile>
+#include <QString>
+
+namespace FT1D
+{
+
+// first eight bytes of every binary signal file
+#define FT1B_MAGIC "FT1DBIN"
+
+// current version of the format, files of newer versions are refused
+#define FT1B_VERSION 1
+
+// initial value of the checksum
+#define FT1B_CHECKSUM_SEED Q_UINT64_C(0xcbf29ce484222325)
+
+// the samples start at this offset, so they are aligned for any sample type
+#define FT1B_HEADER_SIZE 64
+
+/**
+ * @brief The BinarySampleType enum denotes type of the samples stored in a binary signal file
+ */
+enum BinarySampleType
+{
+    FT1B_FLOAT64 = 1,   // IEEE 754 double precision
+    FT1B_FLOAT32 = 2,   // IEEE 754 single precision
+    FT1B_COMPLEX128 = 3 // pairs of double precision real and imaginary parts, used for exported spectra
+};
+
+
+/**
+ * @brief The BinarySignalHeader struct is the header of a binary signal file. All values are little endian.
+ * The signal is sampled uniformly, the x coordinate of sample i is x0 + i * spacing.
+ */
+struct BinarySignalHeader
+{
+    char magic[8];          // FT1B_MAGIC, zero terminated
+    quint32 version;        // FT1B_VERSION
+    quint32 dtype;          // BinarySampleType
+    quint64 count;          // number of samples
+    double x0;              // x coordinate of the first sample
+    double spacing;         // x distance of two consecutive samples
+    quint64 checksum;       // checksum of the sample bytes, see BinarySignalFile::checksum
+    char reserved[FT1B_HEADER_SIZE - 48];
+};
+
+static_assert(sizeof(BinarySignalHeader) == FT1B_HEADER_SIZE, "unexpected size of the binary signal header");
+
+
+/**
+ * @brief The BinarySignalFile class gives access to the samples of a binary signal file. The file is memory mapped,
+ * opening it only validates the header, so it takes the same time regardless of the number of samples.
+ */
+class BinarySignalFile
+{
+public:
+
+    /**
+     * @brief BinarySignalFile constructor, creates a closed file
+     */
+    BinarySignalFile();
+
+    /**
+     * @brief ~BinarySignalFile destructor, unmaps the file
+     */
+    ~BinarySignalFile();
+
+    /**
+     * @brief open maps the file @a path and validates its header
+     * @param path path to the file
+     * @return true, if the file is a valid binary signal file
+     */
+    bool open(const QString& path);
+
+    /**
+     * @brief close unmaps the file
+     */
+    void close();
+
+    /**
+     * @brief isOpen
+     * @return true, if a file is mapped
+     */
+    inline bool isOpen() const
+    {
+        return data != nullptr;
+    }
+
+    /**
+     * @brief header
+     * @return header of the mapped file, valid only if isOpen()
+     */
+    inline const BinarySignalHeader& header() const
+    {
+        return *reinterpret_cast<const BinarySignalHeader*>(data);
+    }
+
+    /**
+     * @brief count
+     * @return number of samples
+     */
+    inline qint64 count() const
+    {
+        return static_cast<qint64>(header().count);
+    }
+
+    /**
+     * @brief isComplex
+     * @return true, if the samples are complex (FT1B_COMPLEX128); sample() is valid only for real samples
+     */
+    inline bool isComplex() const
+    {
+        return header().dtype == FT1B_COMPLEX128;
+    }
+
+    /**
+     * @brief sample
+     * @param index index of the sample
+     * @return value of the sample converted to double
+     */
+    inline double sample(qint64 index) const
+    {
+        if(header().dtype == FT1B_FLOAT32)
+        {
+            return reinterpret_cast<const float*>(data + FT1B_HEADER_SIZE)[index];
+        }
+        return reinterpret_cast<const double*>(data + FT1B_HEADER_SIZE)[index];
+    }
+
+    /**
+     * @brief samples
+     * @return pointer to the raw sample array in the mapping
+     */
+    inline const uchar* samples() const
+    {
+        return data + FT1B_HEADER_SIZE;
+    }
+
+    /**
+     * @brief verify computes checksum of the samples and compares it to the header. Reads the whole file,
+     * so it is not done by open().
+     * @return true, if the checksum matches
+     */
+    bool verify() const;
+
+    /**
+     * @brief checksum computes checksum of @a size bytes, processed as little endian 64-bit words (the tail is zero padded).
+     * Data may be processed in parts, passing the checksum of the previous parts as @a seed; all parts but the last
+     * must have size divisible by 8.
+     * @param bytes data
+     * @param size number of bytes
+     * @param seed checksum of the preceding data, FT1B_CHECKSUM_SEED for the first part
+     * @return checksum
+     */
+    static quint64 checksum(const uchar* bytes, qint64 size, quint64 seed = FT1B_CHECKSUM_SEED);
+
+    /**
+     * @brief isValidHeader checks the magic bytes, the version and the sample type of a header
+     * @param header header to check
+     * @param fileSize size of the whole file in bytes
+     * @return true, if the header is supported and the file contains all samples declared by it
+     */
+    static bool isValidHeader(const BinarySignalHeader& header, qint64 fileSize);
+
+    /**
+     * @brief isBinarySignalFile checks the magic bytes of a file
+     * @param path path to the file
+     * @return true, if the file starts with FT1B_MAGIC
+     */
+    static bool isBinarySignalFile(const QString& path);
+
+    /**
+     * @brief write writes a binary signal file
+     * @param path path to the file
+     * @param x0 x coordinate of the first sample
+     * @param spacing x distance of two consecutive samples
+     * @param values samples
+     * @param count number of samples
+     * @param dtype type, in which the samples are stored
+     * @return true on success
+     */
+    static bool write(const QString& path, double x0, double spacing, const double* values, qint64 count, BinarySampleType dtype = FT1B_FLOAT64);
+
+    /**
+     * @brief sampleSize
+     * @param dtype sample type
+     * @return size of one sample in bytes, 0 for an unknown type
+     */
+    static int sampleSize(quint32 dtype);
+
+private:
+    QFile file;
+    uchar* data;
+};
+}
+#endif // BINARYSIGNALFILE_H
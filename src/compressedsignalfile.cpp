@@ -0,0 +1,320 @@
+/**
+ * @file compressedsignalfile.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "compressedsignalfile.h"
+
+#include <QByteArray>
+#include <QtConcurrent>
+#include <QAtomicInt>
+
+#include <cstring>
+#include <numeric>
+#include <algorithm>
+#include <limits>
+
+// number of blocks compressed at once when writing, bounds the memory held by compressed blocks not yet written
+#define FT1Z_WRITE_BATCH 64
+
+using namespace FT1D;
+
+namespace
+{
+
+inline quint64 bitsOf(double value)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+
+inline double valueOf(quint64 bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+/**
+ * @brief encodeBlock predicts each sample from the previous one and compresses the residuals stored as byte planes.
+ * The high bytes of the residuals of a smooth signal are mostly zero, the planes put them next to each other.
+ */
+QByteArray encodeBlock(const double* values, int count, CompressedSignalCoding coding)
+{
+    QByteArray planes(count * 8, Qt::Uninitialized);
+    uchar* out = reinterpret_cast<uchar*>(planes.data());
+
+    quint64 previous = 0;
+    for(int i = 0; i < count; i++)
+    {
+        const quint64 bits = bitsOf(values[i]);
+        const quint64 residual = coding == FT1Z_XOR ? bits ^ previous : bits - previous;
+        previous = bits;
+
+        for(int b = 0; b < 8; b++)
+        {
+            out[b * count + i] = static_cast<uchar>(residual >> (8 * b));
+        }
+    }
+
+    return qCompress(planes);
+}
+}
+
+
+CompressedSignalFile::CompressedSignalFile()
+{
+    data = nullptr;
+}
+
+
+CompressedSignalFile::~CompressedSignalFile()
+{
+    close();
+}
+
+
+bool CompressedSignalFile::open(const QString& path)
+{
+    close();
+
+#if Q_BYTE_ORDER != Q_LITTLE_ENDIAN
+    // the header and the index are mapped directly, they would have to be swapped
+    return false;
+#endif
+
+    file.setFileName(path);
+    if(!file.open(QIODevice::ReadOnly) || file.size() < FT1Z_HEADER_SIZE)
+    {
+        file.close();
+        return false;
+    }
+
+    data = file.map(0, file.size());
+    if(!data)
+    {
+        file.close();
+        return false;
+    }
+
+    const CompressedSignalHeader& h = header();
+    const quint64 size = static_cast<quint64>(file.size());
+
+    // the count is not bounded by the size of the compressed file; the samples are read into a QVector and
+    // the blocks into buffers of blockSamples, so both are limited to what the writer produces
+
+    bool valid = std::memcmp(h.magic, FT1Z_MAGIC, sizeof(FT1Z_MAGIC)) == 0
+            && h.version >= 1 && h.version <= FT1Z_VERSION
+            && (h.coding == FT1Z_DELTA || h.coding == FT1Z_XOR)
+            && h.blockSamples == FT1Z_BLOCK_SAMPLES
+            && h.count <= static_cast<quint64>(std::numeric_limits<int>::max())
+            && h.blockCount == (h.count + h.blockSamples - 1) / h.blockSamples
+            && FT1Z_HEADER_SIZE + (quint64(h.blockCount) + 1) * sizeof(quint64) <= size;
+
+    // the blocks follow the index, in order, and end within the file
+    quint64 previous = FT1Z_HEADER_SIZE + (quint64(h.blockCount) + 1) * sizeof(quint64);
+    for(quint32 b = 0; valid && b <= h.blockCount; b++)
+    {
+        const quint64 offset = blockOffset(b);
+        valid = offset >= previous && offset <= size;
+        previous = offset;
+    }
+
+    if(!valid)
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+
+void CompressedSignalFile::close()
+{
+    if(data)
+    {
+        file.unmap(data);
+        data = nullptr;
+    }
+    file.close();
+}
+
+
+quint64 CompressedSignalFile::blockOffset(int block) const
+{
+    return reinterpret_cast<const quint64*>(data + FT1Z_HEADER_SIZE)[block];
+}
+
+
+bool CompressedSignalFile::decodeBlock(int block, double* out) const
+{
+    const qint64 blockSamples = header().blockSamples;
+    const int count = static_cast<int>(std::min<qint64>(blockSamples, this->count() - block * blockSamples));
+
+    const quint64 offset = blockOffset(block);
+    const QByteArray planes = qUncompress(data + offset, static_cast<int>(blockOffset(block + 1) - offset));
+    if(planes.size() != count * 8)
+    {
+        return false;
+    }
+
+    const uchar* in = reinterpret_cast<const uchar*>(planes.constData());
+    const bool xorCoding = header().coding == FT1Z_XOR;
+
+    quint64 previous = 0;
+    for(int i = 0; i < count; i++)
+    {
+        quint64 residual = 0;
+        for(int b = 0; b < 8; b++)
+        {
+            residual |= static_cast<quint64>(in[b * count + i]) << (8 * b);
+        }
+
+        previous = xorCoding ? residual ^ previous : residual + previous;
+        out[i] = valueOf(previous);
+    }
+    return true;
+}
+
+
+bool CompressedSignalFile::read(qint64 first, qint64 count, double* out) const
+{
+    if(!isOpen() || first < 0 || count < 0 || first + count > this->count())
+    {
+        return false;
+    }
+
+    const qint64 blockSamples = header().blockSamples;
+    QVector<double> block(static_cast<int>(blockSamples));
+
+    qint64 index = first;
+    while(index < first + count)
+    {
+        const int b = static_cast<int>(index / blockSamples);
+        const qint64 blockStart = b * blockSamples;
+        const qint64 blockEnd = std::min(blockStart + blockSamples, first + count);
+
+        // whole blocks are decoded in place
+        double* target = index == blockStart && blockEnd - blockStart == std::min(blockSamples, this->count() - blockStart)
+                ? out + (index - first) : block.data();
+        if(!decodeBlock(b, target))
+        {
+            return false;
+        }
+        if(target == block.data())
+        {
+            std::copy(block.constData() + (index - blockStart), block.constData() + (blockEnd - blockStart), out + (index - first));
+        }
+        index = blockEnd;
+    }
+    return true;
+}
+
+
+bool CompressedSignalFile::readAll(double* out) const
+{
+    if(!isOpen())
+    {
+        return false;
+    }
+
+    QVector<int> blocks(static_cast<int>(header().blockCount));
+    std::iota(blocks.begin(), blocks.end(), 0);
+
+    const qint64 blockSamples = header().blockSamples;
+    QAtomicInt damaged;
+    QtConcurrent::blockingMap(blocks, [&](const int& b)
+    {
+        if(!decodeBlock(b, out + b * blockSamples))
+        {
+            damaged.storeRelease(1);
+        }
+    });
+    return !damaged.loadAcquire();
+}
+
+
+bool CompressedSignalFile::isCompressedSignalFile(const QString& path)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    char magic[sizeof(FT1Z_MAGIC)];
+    return file.read(magic, sizeof(magic)) == sizeof(magic) && std::memcmp(magic, FT1Z_MAGIC, sizeof(magic)) == 0;
+}
+
+
+bool CompressedSignalFile::write(const QString& path, double x0, double spacing, const double* values, qint64 count, CompressedSignalCoding coding,
+                                 const QAtomicInt* cancelled, const std::function<void(qint64)>& progress)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return false;
+    }
+
+    CompressedSignalHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, FT1Z_MAGIC, sizeof(FT1Z_MAGIC));
+    header.version = FT1Z_VERSION;
+    header.coding = coding;
+    header.count = static_cast<quint64>(count);
+    header.x0 = x0;
+    header.spacing = spacing;
+    header.blockSamples = FT1Z_BLOCK_SAMPLES;
+    header.blockCount = static_cast<quint32>((count + FT1Z_BLOCK_SAMPLES - 1) / FT1Z_BLOCK_SAMPLES);
+
+    // the index is filled in after the blocks are written
+    QVector<quint64> offsets(static_cast<int>(header.blockCount) + 1);
+    const qint64 indexBytes = offsets.size() * static_cast<qint64>(sizeof(quint64));
+    if(file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header)
+            || file.write(reinterpret_cast<const char*>(offsets.constData()), indexBytes) != indexBytes)
+    {
+        return false;
+    }
+
+    quint64 offset = FT1Z_HEADER_SIZE + indexBytes;
+    for(int first = 0; first < static_cast<int>(header.blockCount); first += FT1Z_WRITE_BATCH)
+    {
+        const int batch = std::min<int>(FT1Z_WRITE_BATCH, header.blockCount - first);
+
+        QVector<int> blocks(batch);
+        std::iota(blocks.begin(), blocks.end(), first);
+
+        QVector<QByteArray> compressed(batch);
+        QtConcurrent::blockingMap(blocks, [&](const int& b)
+        {
+            const qint64 start = b * static_cast<qint64>(FT1Z_BLOCK_SAMPLES);
+            const int size = static_cast<int>(std::min<qint64>(FT1Z_BLOCK_SAMPLES, count - start));
+            compressed[b - first] = encodeBlock(values + start, size, coding);
+        });
+
+        for(int i = 0; i < batch; i++)
+        {
+            offsets[first + i] = offset;
+            if(file.write(compressed[i].constData(), compressed[i].size()) != compressed[i].size())
+            {
+                return false;
+            }
+            offset += compressed[i].size();
+        }
+
+        if(cancelled && cancelled->loadAcquire())
+        {
+            return false;
+        }
+        if(progress)
+        {
+            progress(std::min<qint64>((first + batch) * static_cast<qint64>(FT1Z_BLOCK_SAMPLES), count));
+        }
+    }
+    offsets[header.blockCount] = offset;
+
+    return file.seek(FT1Z_HEADER_SIZE) && file.write(reinterpret_cast<const char*>(offsets.constData()), indexBytes) == indexBytes;
+}
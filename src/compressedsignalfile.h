@@ -0,0 +1,185 @@
+#ifndef COMPRESSEDSIGNALFILE_H
+#define COMPRESSEDSIGNALFILE_H
+
+/**
+ * @file compressedsignalfile.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of the compressed signal file format (.ft1z) and its reader.
+ */
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <QAtomicInt>
+
+#include <functional>
+
+namespace FT1D
+{
+
+// first eight bytes of every compressed signal file
+#define FT1Z_MAGIC "FT1DZIP"
+
+// current version of the format, files of newer versions are refused
+#define FT1Z_VERSION 1
+
+// the block index starts at this offset
+#define FT1Z_HEADER_SIZE 64
+
+// number of samples in each block but the last one
+#define FT1Z_BLOCK_SAMPLES 65536
+
+/**
+ * @brief The CompressedSignalCoding enum denotes how the samples of a block are predicted before compression.
+ * Both codings work on the bit patterns of the doubles, so they are lossless.
+ */
+enum CompressedSignalCoding
+{
+    FT1Z_DELTA = 1,     // difference of the bit patterns of consecutive samples, good for slowly changing signals
+    FT1Z_XOR = 2        // exclusive or of the bit patterns of consecutive samples, good for noisy signals
+};
+
+
+/**
+ * @brief The CompressedSignalHeader struct is the header of a compressed signal file. All values are little endian.
+ * The signal is sampled uniformly, the x coordinate of sample i is x0 + i * spacing.
+ * The header is followed by blockCount + 1 offsets of the blocks from the start of the file, the last one is the file size.
+ * Each block is the output of qCompress of the predicted samples, stored as byte planes (all first bytes, all second bytes, ...).
+ */
+struct CompressedSignalHeader
+{
+    char magic[8];          // FT1Z_MAGIC, zero terminated
+    quint32 version;        // FT1Z_VERSION
+    quint32 coding;         // CompressedSignalCoding
+    quint64 count;          // number of samples
+    double x0;              // x coordinate of the first sample
+    double spacing;         // x distance of two consecutive samples
+    quint32 blockSamples;   // samples in each block but the last one
+    quint32 blockCount;     // number of blocks
+    char reserved[FT1Z_HEADER_SIZE - 48];
+};
+
+static_assert(sizeof(CompressedSignalHeader) == FT1Z_HEADER_SIZE, "unexpected size of the compressed signal header");
+
+
+/**
+ * @brief The CompressedSignalFile class reads compressed signal files. The file is memory mapped and each block
+ * is decompressed independently, so a range of samples is decoded without touching the other blocks
+ * and a whole file is decoded by all cores.
+ */
+class CompressedSignalFile
+{
+public:
+
+    /**
+     * @brief CompressedSignalFile constructor, creates a closed file
+     */
+    CompressedSignalFile();
+
+    /**
+     * @brief ~CompressedSignalFile destructor, unmaps the file
+     */
+    ~CompressedSignalFile();
+
+    /**
+     * @brief open maps the file @a path and validates its header and block index. Files with blocks of other than
+     * FT1Z_BLOCK_SAMPLES samples or with more samples than a QVector can hold are refused.
+     * @param path path to the file
+     * @return true, if the file is a valid compressed signal file
+     */
+    bool open(const QString& path);
+
+    /**
+     * @brief close unmaps the file
+     */
+    void close();
+
+    /**
+     * @brief isOpen
+     * @return true, if a file is mapped
+     */
+    inline bool isOpen() const
+    {
+        return data != nullptr;
+    }
+
+    /**
+     * @brief header
+     * @return header of the mapped file, valid only if isOpen()
+     */
+    inline const CompressedSignalHeader& header() const
+    {
+        return *reinterpret_cast<const CompressedSignalHeader*>(data);
+    }
+
+    /**
+     * @brief count
+     * @return number of samples
+     */
+    inline qint64 count() const
+    {
+        return static_cast<qint64>(header().count);
+    }
+
+    /**
+     * @brief read decodes samples @a first .. @a first + @a count - 1, decompressing only the blocks containing them
+     * @param first index of the first sample
+     * @param count number of samples
+     * @param out output, at least @a count values
+     * @return false, if the range is out of the file or a block is damaged
+     */
+    bool read(qint64 first, qint64 count, double* out) const;
+
+    /**
+     * @brief readAll decodes all samples, the blocks are decompressed in parallel
+     * @param out output, count() values
+     * @return false, if a block is damaged
+     */
+    bool readAll(double* out) const;
+
+    /**
+     * @brief isCompressedSignalFile checks the magic bytes of a file
+     * @param path path to the file
+     * @return true, if the file starts with FT1Z_MAGIC
+     */
+    static bool isCompressedSignalFile(const QString& path);
+
+    /**
+     * @brief write writes a compressed signal file. Blocks are compressed in parallel.
+     * @param path path to the file
+     * @param x0 x coordinate of the first sample
+     * @param spacing x distance of two consecutive samples
+     * @param values samples
+     * @param count number of samples
+     * @param coding prediction applied before compression
+     * @param cancelled if not null and set to non-zero, the writing stops before the next batch of blocks
+     * @param progress if set, receives the number of samples written after each batch of blocks
+     * @return true on success, false also if cancelled
+     */
+    static bool write(const QString& path, double x0, double spacing, const double* values, qint64 count,
+                      CompressedSignalCoding coding = FT1Z_XOR, const QAtomicInt* cancelled = nullptr,
+                      const std::function<void(qint64)>& progress = nullptr);
+
+private:
+
+    /**
+     * @brief decodeBlock decompresses block @a block
+     * @param block index of the block
+     * @param out output, samples of the block
+     * @return false, if the block is damaged
+     */
+    bool decodeBlock(int block, double* out) const;
+
+    /**
+     * @brief blockOffset
+     * @param block index of the block, blockCount for the end of the last block
+     * @return offset of the block from the start of the file
+     */
+    quint64 blockOffset(int block) const;
+
+    QFile file;
+    uchar* data;
+};
+}
+#endif // COMPRESSEDSIGNALFILE_H
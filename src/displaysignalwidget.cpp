@@ -1,6 +1,35 @@
 #include "displaysignalwidget.h"
+#include "signalgenerator.h"
+
+#include <QElapsedTimer>
+#include <QFontDatabase>
 
 #include<limits>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+// visible ranges with at most this number of samples are displayed sample by sample
+#define PAGED_DETAIL_SAMPLES 4096
+
+// envelopes of visible ranges with at most this number of samples are computed from the samples, longer ones from the pyramid
+#define PAGED_SCAN_SAMPLES (1 << 20)
+
+// in-memory signals with more visible samples per pixel column are displayed as a min/max envelope
+#define LOD_SAMPLES_PER_PIXEL 2
+
+// markers are drawn once the samples are at least this number of pixels apart
+#define LOD_MARKER_SPACING 4
+
+// size of the plot and length of the signal drawn by benchmark()
+#define BENCHMARK_PLOT_WIDTH 1200
+#define BENCHMARK_PLOT_HEIGHT 600
+#define BENCHMARK_SIGNAL_LENGTH 512
+
+// distance of the overlay from the corner of the axis rect, in pixels
+#define OVERLAY_LABEL_MARGIN 4
 
 using namespace FT1D;
 
@@ -8,7 +37,16 @@ FT1D::DisplaySignalWidget::DisplaySignalWidget(FT1D::DisplaySignalWidgetType typ
 {
     // does not work in initialisation section.
     p_signal = nullptr;
-    shadow_signal = nullptr;
+    p_paged = nullptr;
+    lodLowerGraph = nullptr;
+    lodPyramidValid = false;
+    lodEnvelope = false;
+    shadowGraph = nullptr;
+    interactionsEnabled = true;
+
+    rasterizer = nullptr;
+    rasterFrame = nullptr;
+    overlayLabel = nullptr;
 
     this->type = type;
     centering = false;
@@ -28,11 +66,31 @@ FT1D::DisplaySignalWidget::DisplaySignalWidget(FT1D::DisplaySignalWidgetType typ
     plot->setGeometry(QRect(0, 0, 470, 270));
     plot->setCursor(QCursor(Qt::CrossCursor));
 
+    // from the bottom: static content (background, grid, original period), shadow of the previous signal,
+    // the signal, the cursor line, axes. The middle three are buffered, so that hovering redraws only the cursor
+    // and dragging a point only the signal
+    plot->addLayer(QStringLiteral("period"), plot->layer(QStringLiteral("main")), QCustomPlot::limBelow);
+    plot->addLayer(QStringLiteral("shadow"), plot->layer(QStringLiteral("main")), QCustomPlot::limBelow);
+    plot->addLayer(QStringLiteral("cursor"), plot->layer(QStringLiteral("main")), QCustomPlot::limAbove);
+    shadowLayer = plot->layer(QStringLiteral("shadow"));
+    dataLayer = plot->layer(QStringLiteral("main"));
+    cursorLayer = plot->layer(QStringLiteral("cursor"));
+    shadowLayer->setMode(QCPLayer::lmBuffered);
+    dataLayer->setMode(QCPLayer::lmBuffered);
+    cursorLayer->setMode(QCPLayer::lmBuffered);
+
     verticalLine = new QCPItemLine(plot);
     QPen pen;
     pen.setColor( Qt::red );
     verticalLine->setPen(pen );
     verticalLine->setVisible(false);
+    verticalLine->setLayer(cursorLayer);
+
+    // when rasterized, every replot may have changed the data or the ranges; unchanged snapshots are ignored by the rasterizer
+    connect(plot, &QCustomPlot::afterReplot, this, &DisplaySignalWidget::requestFrame);
+    // a frame is either a full replot or a replot of a single buffered layer
+    connect(plot, &QCustomPlot::afterReplot, this, &DisplaySignalWidget::recordFrame);
+    connect(plot, &QCustomPlot::afterLayerReplot, this, &DisplaySignalWidget::recordFrame);
 
     // create graph background:
     if( type == EDIT_MODE)
@@ -49,6 +107,7 @@ FT1D::DisplaySignalWidget::DisplaySignalWidget(FT1D::DisplaySignalWidgetType typ
         plotBackground->setBrush(QBrush(QColor(0,200,0,100)));
         plotBackground->setPen(Qt::NoPen);
         plotBackground->setVisible(false);
+        plotBackground->setLayer(QStringLiteral("period"));
     }
 
     // setup interactions
@@ -76,9 +135,9 @@ FT1D::DisplaySignalWidget::DisplaySignalWidget(FT1D::DisplaySignalWidgetType typ
 
         connect(plot, &QCustomPlot::mousePress,   this, [=](QMouseEvent* e)
         {
-            if(plot->graphCount() == 2)
+            // the shadow of the previous signal disappears
+            if(removeShadowGraph())
             {
-                plot->removeGraph(0);
                 update();
             }
             if(sibling) { sibling->plot->axisRect()->mousePressEvent(e); }
@@ -172,6 +231,40 @@ FT1D::DisplaySignalWidget::DisplaySignalWidget(FT1D::DisplaySignalWidgetType typ
     {
         actionEditMode = nullptr;
     }
+
+    interpolatedCurve = nullptr;
+    factor = 1;
+
+    if(type == MAGNITUDE)
+    {
+        menuInterpolation = new QMenu(this);
+        interpolationGroup = new QActionGroup(this);
+
+        for(int value : {1, 2, 4, 8, 16})
+        {
+            QAction* action = interpolationGroup->addAction(value == 1 ? QString() : QStringLiteral("%1×").arg(value));
+            action->setCheckable(true);
+            action->setChecked(value == 1);
+            action->setData(value);
+            menuInterpolation->addAction(action);
+        }
+
+        connect(interpolationGroup, &QActionGroup::triggered, this, [=](QAction* action)
+        {
+            factor = action->data().toInt();
+            if(factor == 1)
+            {
+                interpolatedValues.clear();
+                displayInterpolatedSpectrum();
+            }
+            emit interpolationFactorChanged(factor);
+        });
+    }
+    else
+    {
+        menuInterpolation = nullptr;
+        interpolationGroup = nullptr;
+    }
 }
 
 bool FT1D::DisplaySignalWidget::event(QEvent* e)
@@ -179,7 +272,7 @@ bool FT1D::DisplaySignalWidget::event(QEvent* e)
     if (e->type()==QEvent::Leave)
     {
         verticalLine->setVisible(false);
-        plot->replot();
+        cursorLayer->replot();
         emit mouseLeave();
     }
 
@@ -189,7 +282,11 @@ bool FT1D::DisplaySignalWidget::event(QEvent* e)
 
 FT1D::DisplaySignalWidget::~DisplaySignalWidget()
 {
+    // waits for the worker
+    delete rasterizer;
+
     delete verticalLine;
+    delete overlayLabel;
 
     delete plotBackground;
     delete plot;
@@ -198,11 +295,33 @@ FT1D::DisplaySignalWidget::~DisplaySignalWidget()
     delete actionDisplayLines;
     delete actionAutoScaling;
     delete actionEditMode;
+
+    delete interpolationGroup;
+    delete menuInterpolation;
 }
 
 
 void FT1D::DisplaySignalWidget::plotXAxisChanged(const QCPRange& range)
 {
+    if(p_paged != nullptr)
+    {
+        const double margin = (p_paged->max_x() - p_paged->min_x()) * 0.1 + p_paged->spacing();
+        if(range.lower < p_paged->min_x() - margin)
+        {
+            plot->xAxis->setRangeLower(p_paged->min_x() - margin);
+            return;
+        }
+        if(range.upper > p_paged->max_x() + margin)
+        {
+            plot->xAxis->setRangeUpper(p_paged->max_x() + margin);
+            return;
+        }
+
+        displayPagedRange();
+        plot->replot();
+        return;
+    }
+
     if(p_signal!= nullptr && type != EDIT_MODE && !p_signal->empty())
     {
         if(range.lower < p_signal->allowed_min_x())
@@ -231,10 +350,18 @@ void FT1D::DisplaySignalWidget::plotXAxisChanged(const QCPRange& range)
 
             if(plot->graph() != nullptr)
             {
-                plot->graph()->setData(p_signal->x(), p_signal->y());
+                displaySignalRange();
+                displayShadowRange();
+                displayInterpolatedSpectrum();
                 plot->replot();
             }
         }
+        else
+        {
+            // the plot is replotted by whoever changed the range
+            displaySignalRange();
+            displayShadowRange();
+        }
     }
 //    if(sibling)
 //    {
@@ -255,6 +382,26 @@ void FT1D::DisplaySignalWidget::plotXAxisChanged(const QCPRange& range)
 
 void FT1D::DisplaySignalWidget::plotDefaultScale()
 {
+    if(p_paged != nullptr)
+    {
+        double offset = (p_paged->max_x() - p_paged->min_x()) * 0.1;
+        if(offset < 0.000001)
+        {
+            offset = 0.5;
+        }
+        plot->xAxis->setRange(p_paged->min_x() - offset, p_paged->max_x() + offset);
+
+        offset = (p_paged->max_y() - p_paged->min_y()) * 0.1;
+        if(offset < 0.000001)
+        {
+            offset = 0.5;
+        }
+        plot->yAxis->setRange(p_paged->min_y() - offset, p_paged->max_y() + offset);
+
+        plot->replot();
+        return;
+    }
+
     if(p_signal != nullptr)
     {
 
@@ -314,6 +461,10 @@ void FT1D::DisplaySignalWidget::contextMenuRequest(QPoint pos)
     menu->addAction(actionDefaultScale);
     menu->addAction(actionDisplayLines);
     menu->addAction(actionAutoScaling);
+    if(menuInterpolation)
+    {
+        menu->addMenu(menuInterpolation);
+    }
     if(actionEditMode)
     {
         menu->addAction(actionEditMode);
@@ -325,6 +476,7 @@ void FT1D::DisplaySignalWidget::contextMenuRequest(QPoint pos)
 void FT1D::DisplaySignalWidget::displaySignal(Signal* signal, bool shadowPrevious)
 {
     p_signal = signal;
+    p_paged = nullptr;
 
     plot->clearGraphs();
     plot->clearItems();
@@ -332,46 +484,59 @@ void FT1D::DisplaySignalWidget::displaySignal(Signal* signal, bool shadowPreviou
     plot->clearFocus();
     plot->clearMask();
 
+    // deleted by clearPlottables
+    interpolatedCurve = nullptr;
+    lodLowerGraph = nullptr;
+    shadowGraph = nullptr;
+    shadowGraphSignal.clear();
+    lodPyramidValid = false;
+    lodEnvelope = false;
+
     if(p_signal == nullptr)
     {
         return;
     }
     else
     {
+        if(type == MAGNITUDE)
+        {
+            // added first, so that it is drawn below the coefficients
+            interpolatedCurve = new QCPCurve(plot->xAxis, plot->yAxis);
+            plot->addPlottable(interpolatedCurve);
+            interpolatedCurve->setSelectable(false);
+            interpolatedCurve->setPen(QPen(QColor(0, 0, 255, 120)));
+            displayInterpolatedSpectrum();
+        }
+
         if(shadowPrevious && shadow_signal)
         {
-            QCPGraph* shadowGraph = plot->addGraph();
+            // the data of the visible range are set by plotXAxisChanged below, like for the signal
+            shadowGraphSignal = shadow_signal;
+            shadowGraph = plot->addGraph();
             shadowGraph->setSelectable(false);
             shadowGraph->setName(QStringLiteral("shadowGraph"));
+            shadowGraph->setLayer(shadowLayer);
+            shadowGraph->setPen(QPen(Qt::gray));
+            shadowGraph->setBrush(Qt::NoBrush);
+        }
 
-            shadowGraph->setData(shadow_signal->x(), shadow_signal->y());
-            shadowGraph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssCircle, Qt::gray, Qt::gray,5));
-
-            if(actionDisplayLines->isChecked())
-            {
-                shadowGraph->setPen(QPen(Qt::gray));
-                shadowGraph->setLineStyle(QCPGraph::lsLine);
-                shadowGraph->setBrush(Qt::NoBrush);
-            }
-            else
-            {
-                shadowGraph->setLineStyle(QCPGraph::lsNone);
-            }
+        if(type != EDIT_MODE)
+        {
+            // below the signal, which stays the last graph
+            lodLowerGraph = plot->addGraph();
+            lodLowerGraph->setSelectable(false);
+            lodLowerGraph->setPen(QPen(QColor::fromRgb(255,165,0)));
         }
 
         QCPGraph* graph = plot->addGraph();
 
         if(type == EDIT_MODE)
         {
+            StageTimer upload(overlay.stageTarget(STAGE_UPLOAD));
             graph->setData(p_signal->original.keys().toVector(), p_signal->original.values().toVector());
             graph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssCircle, Qt::blue, Qt::blue,5));
         }
-        else
-        {
-            graph->setData(p_signal->x(), p_signal->y());
-            graph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssCircle, Qt::blue, Qt::blue,5));
-
-        }
+        // otherwise the data of the visible range are set by plotXAxisChanged below
 
         if(actionDisplayLines->isChecked())
         {
@@ -414,11 +579,399 @@ void FT1D::DisplaySignalWidget::displaySignal(Signal* signal, bool shadowPreviou
 
     }
 
-    if(shadow_signal)
+    shadow_signal = QSharedPointer<const Signal>(new Signal(*p_signal));
+}
+
+
+void FT1D::DisplaySignalWidget::appendSamples(const QVector<double>& values)
+{
+    if(p_signal == nullptr || plot->graphCount() == 0)
+    {
+        return;
+    }
+
+    // the pyramid is extended, not built again
+    if(lodPyramidValid)
+    {
+        lodPyramid.append(values.constData(), values.size());
+        lodPyramid.finish();
+    }
+
+    if(actionAutoScaling->isChecked())
+    {
+        plotDefaultScale();
+    }
+    plotXAxisChanged(plot->xAxis->range());
+    plot->replot();
+}
+
+
+bool FT1D::DisplaySignalWidget::removeShadowGraph()
+{
+    if(shadowGraph)
+    {
+        plot->removeGraph(shadowGraph);
+        shadowGraph = nullptr;
+        shadowGraphSignal.clear();
+        shadowLayer->replot();
+        return true;
+    }
+    return false;
+}
+
+
+void FT1D::DisplaySignalWidget::displaySignalRange()
+{
+    StageTimer upload(overlay.stageTarget(STAGE_UPLOAD));
+
+    if(p_signal == nullptr || lodLowerGraph == nullptr || plot->graph() == nullptr)
+    {
+        return;
+    }
+
+    QCPGraph* graph = plot->graph();
+    const QVector<double> xs = p_signal->x();
+    const QVector<double> ys = p_signal->y();
+
+    if(xs.isEmpty())
+    {
+        graph->clearData();
+        lodLowerGraph->clearData();
+        return;
+    }
+
+    // one more sample on each side, so that the lines leave the plot
+    const QCPRange range = plot->xAxis->range();
+    const int first = std::max(static_cast<int>(std::lower_bound(xs.constBegin(), xs.constEnd(), range.lower) - xs.constBegin()) - 1, 0);
+    const int last = std::min(static_cast<int>(std::upper_bound(xs.constBegin(), xs.constEnd(), range.upper) - xs.constBegin()), xs.size() - 1);
+    const int visible = last - first + 1;
+    const int pixels = std::max(plot->axisRect()->width(), 1);
+
+    if(visible <= pixels * LOD_SAMPLES_PER_PIXEL)
+    {
+        const bool wasEnvelope = lodEnvelope;
+        lodEnvelope = false;
+        lodLowerGraph->clearData();
+        graph->setChannelFillGraph(nullptr);
+        graph->setBrush(Qt::NoBrush);
+
+        // while a point is dragged the keys stay the same, only the values are copied
+        QCPDataMap* data = graph->data();
+        if(!wasEnvelope && data->size() == visible && data->firstKey() == xs[first] && data->lastKey() == xs[last])
+        {
+            data->setValues(0, ys.constData() + first, visible);
+        }
+        else
+        {
+            data->set(xs.constData() + first, ys.constData() + first, visible);
+        }
+
+        graph->setLineStyle(actionDisplayLines->isChecked() ? QCPGraph::lsLine : QCPGraph::lsNone);
+
+        // markers of samples closer than a few pixels would only overlap
+        if(visible * LOD_MARKER_SPACING <= pixels)
+        {
+            graph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssCircle, Qt::blue, Qt::blue,5));
+        }
+        else
+        {
+            graph->setScatterStyle(actionDisplayLines->isChecked() ? QCPScatterStyle() : QCPScatterStyle(QCPScatterStyle::ssDot, Qt::blue, 1));
+        }
+        return;
+    }
+
+    lodEnvelope = true;
+    if(!lodPyramidValid)
+    {
+        // the extended signal repeats the original one, so the pyramid of the original covers all copies
+        lodPyramid.clear();
+        const QVector<double> values = p_signal->original.values().toVector();
+        lodPyramid.append(values.constData(), values.size());
+        lodPyramid.finish();
+        lodPyramidValid = true;
+    }
+
+    QVector<double> keys;
+    QVector<double> lows;
+    QVector<double> highs;
+    keys.reserve(2 * pixels);
+    lows.reserve(2 * pixels);
+    highs.reserve(2 * pixels);
+
+    // the visible range is split at the boundaries of the copies, each part gets its share of the pixel columns
+    const int length = p_signal->original_length();
+    for(int start = first; start <= last; )
+    {
+        const int offset = start % length;
+        const int end = std::min(last, start + length - offset - 1);
+        const int count = end - start + 1;
+        const int columns = std::max(static_cast<int>(static_cast<qint64>(pixels) * count / visible), 1);
+
+        if(count <= PAGED_SCAN_SAMPLES)
+        {
+            const int bucket = (count + columns - 1) / columns;
+            for(int i = start; i <= end; i += bucket)
+            {
+                const auto minmax = std::minmax_element(ys.constBegin() + i, ys.constBegin() + std::min(i + bucket, end + 1));
+                keys.push_back(xs[i]);
+                lows.push_back(*minmax.first);
+                highs.push_back(*minmax.second);
+            }
+        }
+        else
+        {
+            QVector<double> starts, blockLows, blockHighs;
+            lodPyramid.envelope(offset, offset + count - 1, columns, starts, blockLows, blockHighs);
+            for(int i = 0; i < starts.size(); i++)
+            {
+                keys.push_back(xs[start + std::max(static_cast<int>(starts[i]) - offset, 0)]);
+                lows.push_back(blockLows[i]);
+                highs.push_back(blockHighs[i]);
+            }
+        }
+        start = end + 1;
+    }
+
+    graph->setScatterStyle(QCPScatterStyle());
+    graph->setLineStyle(QCPGraph::lsLine);
+    graph->setPen(QPen(QColor::fromRgb(255,165,0)));
+    graph->setBrush(QBrush(QColor(255, 165, 0, 90)));
+    graph->setChannelFillGraph(lodLowerGraph);
+    graph->setData(keys, highs);
+    lodLowerGraph->setData(keys, lows);
+}
+
+
+void FT1D::DisplaySignalWidget::displayShadowRange()
+{
+    if(shadowGraph == nullptr)
+    {
+        return;
+    }
+
+    StageTimer upload(overlay.stageTarget(STAGE_UPLOAD));
+
+    const QVector<double> xs = shadowGraphSignal->x();
+    const QVector<double> ys = shadowGraphSignal->y();
+
+    const QCPRange range = plot->xAxis->range();
+    const int first = std::max(static_cast<int>(std::lower_bound(xs.constBegin(), xs.constEnd(), range.lower) - xs.constBegin()) - 1, 0);
+    const int last = std::min(static_cast<int>(std::upper_bound(xs.constBegin(), xs.constEnd(), range.upper) - xs.constBegin()), xs.size() - 1);
+    const int visible = last - first + 1;
+    const int pixels = std::max(plot->axisRect()->width(), 1);
+
+    if(visible <= 0)
     {
-        delete shadow_signal;
+        shadowGraph->clearData();
+        return;
     }
-    shadow_signal = new Signal(*p_signal);
+
+    if(visible <= pixels * LOD_SAMPLES_PER_PIXEL)
+    {
+        shadowGraph->data()->set(xs.constData() + first, ys.constData() + first, visible);
+        shadowGraph->setLineStyle(actionDisplayLines->isChecked() ? QCPGraph::lsLine : QCPGraph::lsNone);
+
+        if(visible * LOD_MARKER_SPACING <= pixels)
+        {
+            shadowGraph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssCircle, Qt::gray, Qt::gray,5));
+        }
+        else
+        {
+            shadowGraph->setScatterStyle(actionDisplayLines->isChecked() ? QCPScatterStyle() : QCPScatterStyle(QCPScatterStyle::ssDot, Qt::gray, 1));
+        }
+        return;
+    }
+
+    // the shadow is only a hint, a line through the minimum and the maximum of each pixel column outlines its envelope
+    QVector<double> keys;
+    QVector<double> values;
+    keys.reserve(2 * pixels + 2);
+    values.reserve(2 * pixels + 2);
+
+    const int bucket = (visible + pixels - 1) / pixels;
+    for(int i = first; i <= last; i += bucket)
+    {
+        const int end = std::min(i + bucket, last + 1);
+        const auto minmax = std::minmax_element(ys.constBegin() + i, ys.constBegin() + end);
+        const double middle = (xs[i] + xs[end - 1]) * 0.5;
+        keys.push_back(middle);
+        values.push_back(*minmax.first);
+        // the keys of a graph are unique, the maximum is placed just after the minimum
+        keys.push_back(std::nextafter(middle, std::numeric_limits<double>::infinity()));
+        values.push_back(*minmax.second);
+    }
+
+    shadowGraph->setScatterStyle(QCPScatterStyle());
+    shadowGraph->setLineStyle(QCPGraph::lsLine);
+    shadowGraph->setData(keys, values);
+}
+
+
+void FT1D::DisplaySignalWidget::displayPagedSignal(const PagedSignal* signal)
+{
+    p_signal = nullptr;
+    p_paged = signal;
+
+    plot->clearGraphs();
+    plot->clearItems();
+    plot->clearPlottables();
+    plot->clearFocus();
+    plot->clearMask();
+
+    interpolatedCurve = nullptr;
+    shadowGraph = nullptr;
+    shadowGraphSignal.clear();
+
+    shadow_signal.clear();
+
+    // the upper envelope, or the samples, filled down to the lower envelope
+    QCPGraph* graph = plot->addGraph();
+    QCPGraph* lowerGraph = plot->addGraph();
+
+    graph->setPen(QPen(QColor::fromRgb(255,165,0)));
+    graph->setBrush(QBrush(QColor(255, 165, 0, 90)));
+    graph->setChannelFillGraph(lowerGraph);
+    lowerGraph->setPen(QPen(QColor::fromRgb(255,165,0)));
+
+    plotDefaultScale();
+    displayPagedRange();
+    plot->replot();
+}
+
+
+void FT1D::DisplaySignalWidget::displayPagedRange()
+{
+    StageTimer upload(overlay.stageTarget(STAGE_UPLOAD));
+
+    if(p_paged == nullptr || plot->graphCount() < 2)
+    {
+        return;
+    }
+
+    QCPGraph* graph = plot->graph(0);
+    QCPGraph* lowerGraph = plot->graph(1);
+
+    const QCPRange range = plot->xAxis->range();
+    const qint64 first = p_paged->indexAt(range.lower);
+    const qint64 last = p_paged->indexAt(range.upper);
+    const qint64 visible = last - first + 1;
+
+    // two envelope points per pixel column
+    const int columns = std::max(plot->axisRect()->width(), 1) * 2;
+
+    QVector<double> keys;
+    QVector<double> lows;
+    QVector<double> highs;
+
+    if(visible <= PAGED_DETAIL_SAMPLES)
+    {
+        highs.resize(static_cast<int>(visible));
+        const qint64 count = p_paged->read(first, visible, highs.data());
+        highs.resize(static_cast<int>(count));
+
+        keys.resize(highs.size());
+        for(int i = 0; i < keys.size(); i++)
+        {
+            keys[i] = p_paged->x(first + i);
+        }
+
+        graph->setData(keys, highs);
+        graph->setScatterStyle(actionDisplayLines->isChecked() ? QCPScatterStyle() : QCPScatterStyle(QCPScatterStyle::ssCircle, Qt::blue, Qt::blue, 5));
+        graph->setLineStyle(actionDisplayLines->isChecked() ? QCPGraph::lsLine : QCPGraph::lsNone);
+        lowerGraph->clearData();
+        return;
+    }
+
+    if(visible <= PAGED_SCAN_SAMPLES)
+    {
+        // short enough to summarize the samples themselves, more precise than the pyramid
+        const qint64 bucket = (visible + columns - 1) / columns;
+        QVector<double> values(static_cast<int>(visible));
+        const qint64 count = p_paged->read(first, visible, values.data());
+
+        for(qint64 start = 0; start < count; start += bucket)
+        {
+            const auto minmax = std::minmax_element(values.constBegin() + start, values.constBegin() + std::min(start + bucket, count));
+            keys.push_back(p_paged->x(first + start));
+            lows.push_back(*minmax.first);
+            highs.push_back(*minmax.second);
+        }
+    }
+    else
+    {
+        p_paged->pyramid().envelope(first, last, columns, keys, lows, highs);
+        for(double& key : keys)
+        {
+            key = p_paged->x(static_cast<qint64>(key));
+        }
+    }
+
+    graph->setScatterStyle(QCPScatterStyle());
+    graph->setLineStyle(QCPGraph::lsLine);
+    graph->setData(keys, highs);
+    lowerGraph->setData(keys, lows);
+}
+
+
+void FT1D::DisplaySignalWidget::viewRange(QCPRange& x, QCPRange& y) const
+{
+    x = plot->xAxis->range();
+    y = plot->yAxis->range();
+}
+
+
+void FT1D::DisplaySignalWidget::setViewRange(const QCPRange& x, const QCPRange& y)
+{
+    // plotXAxisChanged updates the sibling and the displayed part of the signal
+    plot->yAxis->setRange(y);
+    plot->xAxis->setRange(x);
+    plot->replot();
+}
+
+
+void FT1D::DisplaySignalWidget::setInterpolatedSpectrum(const QVector<double>& values)
+{
+    interpolatedValues = values;
+    displayInterpolatedSpectrum();
+    plot->replot();
+}
+
+
+void FT1D::DisplaySignalWidget::displayInterpolatedSpectrum()
+{
+    StageTimer upload(overlay.stageTarget(STAGE_UPLOAD));
+
+    if(!interpolatedCurve)
+    {
+        return;
+    }
+
+    const int length = p_signal ? p_signal->original_length() : 0;
+    if(factor == 1 || length == 0 || interpolatedValues.size() != length * factor)
+    {
+        interpolatedCurve->clearData();
+        return;
+    }
+
+    // the coefficients are at integer x, the extended signal repeats them with period length
+    const QVector<double> x = p_signal->x();
+    const double step = 1.0 / factor;
+
+    QVector<double> curveX;
+    QVector<double> curveY;
+    curveX.reserve(x.size() * factor);
+    curveY.reserve(x.size() * factor);
+
+    for(int i = 0; i < x.size(); i++)
+    {
+        const double* values = interpolatedValues.constData() + (i % length) * factor;
+        for(int r = 0; r < factor; r++)
+        {
+            curveX.push_back(x[i] + r * step);
+            curveY.push_back(values[r]);
+        }
+    }
+    interpolatedCurve->setData(curveX, curveY);
 }
 
 
@@ -442,7 +995,11 @@ void FT1D::DisplaySignalWidget::enableCentering(bool enabled)
 {
     centering = enabled;
 
-    if(p_signal != nullptr)
+    if(p_paged != nullptr)
+    {
+        displayPagedSignal(p_paged);
+    }
+    else if(p_signal != nullptr)
     {
         displaySignal(p_signal);
     }
@@ -452,6 +1009,12 @@ void FT1D::DisplaySignalWidget::enableCentering(bool enabled)
 void FT1D::DisplaySignalWidget::displayWithLines(bool value)
 {
     actionDisplayLines->setChecked(value);
+    if(p_paged != nullptr)
+    {
+        displayPagedRange();
+        plot->replot();
+        return;
+    }
     displaySignal(p_signal);
 }
 
@@ -462,6 +1025,11 @@ void FT1D::DisplaySignalWidget::setDefaultTexts()
     actionDisplayLines->setText(QStringLiteral("Display with lines in this graph"));
     actionAutoScaling->setText(QStringLiteral("Automatic scaling"));
     if(actionEditMode) actionEditMode->setText(QStringLiteral("Open edit mode"));
+    if(menuInterpolation)
+    {
+        menuInterpolation->setTitle(QStringLiteral("Interpolated spectrum"));
+        interpolationGroup->actions().first()->setText(QStringLiteral("Off"));
+    }
 }
 
 
@@ -487,6 +1055,16 @@ void FT1D::DisplaySignalWidget::setLocalizedTexts(const Translation* language)
             actionEditMode->setText(language->getChildElementText("actionEditMode"));
             if(actionEditMode->text().isEmpty()) actionEditMode->setText(QStringLiteral("Open edit mode"));
         }
+
+        if(menuInterpolation)
+        {
+            menuInterpolation->setTitle(language->getChildElementText("menuInterpolation"));
+            if(menuInterpolation->title().isEmpty()) menuInterpolation->setTitle(QStringLiteral("Interpolated spectrum"));
+
+            QAction* actionInterpolationOff = interpolationGroup->actions().first();
+            actionInterpolationOff->setText(language->getChildElementText("actionInterpolationOff"));
+            if(actionInterpolationOff->text().isEmpty()) actionInterpolationOff->setText(QStringLiteral("Off"));
+        }
     }
 }
 
@@ -495,14 +1073,17 @@ void FT1D::DisplaySignalWidget::plotMousePress(QMouseEvent* event)
 {
     // there was some code for range dragging when axis selected.
 
-    if(!plot->graph() || p_signal == nullptr)
+    if(!plot->graph() || p_signal == nullptr || !interactionsEnabled)
     {
         return;
     }
 
-    if(plot->graphCount() == 2)
+    removeShadowGraph();
+
+    // the envelope does not show the samples themselves
+    if(lodEnvelope)
     {
-        plot->removeGraph(0);
+        return;
     }
 
     double x = plot->xAxis->pixelToCoord(event->pos().x());
@@ -537,10 +1118,7 @@ void FT1D::DisplaySignalWidget::plotMousePress(QMouseEvent* event)
 
 void FT1D::DisplaySignalWidget::plotMouseWheel(QWheelEvent* e)
 {
-    if(plot->graphCount() == 2)
-    {
-        plot->removeGraph(0);
-    }
+    removeShadowGraph();
 
     // if an axis is selected, only allow the direction of that axis to be zoomed
     // if no axis is selected, both directions may be zoomed
@@ -624,9 +1202,9 @@ void FT1D::DisplaySignalWidget::plotMouseMove(QMouseEvent * event)
             }
         }
 
-        plot->graph()->data()->clear();
-        plot->graph()->setData(p_signal->x(), p_signal->y());
-        plot->replot();
+        lodPyramidValid = false;
+        displaySignalRange();
+        replotData();
         emit needUpdateFiltered();
     }
     else
@@ -661,7 +1239,7 @@ void FT1D::DisplaySignalWidget::plotMouseMove(QMouseEvent * event)
         emit needFrequencyUpdate(idx, val);
         emit displayValueStatusBar(pos, idx);
 
-        plot->replot();
+        cursorLayer->replot();
     }
 }
 
@@ -773,13 +1351,20 @@ void FT1D::DisplaySignalWidget::editModePlotMouseMove(QMouseEvent* event)
     {
         p_signal->original[selectedPointX] = y;
 
-        plot->graph()->data()->clear();
-        plot->graph()->setData(p_signal->original.keys().toVector(), p_signal->original.values().toVector());
-        plot->replot();
+        QCPDataMap::iterator point = plot->graph()->data()->find(selectedPointX);
+        if(point != plot->graph()->data()->end())
+        {
+            point->value = y;
+        }
+        else
+        {
+            plot->graph()->setData(p_signal->original.keys().toVector(), p_signal->original.values().toVector());
+        }
+        replotData();
         emit editModeNeedUpdate();
     }
 
-    plot->replot();
+    cursorLayer->replot();
 }
 
 
@@ -828,6 +1413,7 @@ double FT1D::DisplaySignalWidget::roundToClosestMultiple(double toRound, double
 
 void FT1D::DisplaySignalWidget::setInteractionsEnabled(bool val)
 {
+    interactionsEnabled = val;
     actionDefaultScale->setEnabled(val);
     actionDisplayLines->setEnabled(val);
     actionAutoScaling->setEnabled(val);
@@ -849,8 +1435,223 @@ void FT1D::DisplaySignalWidget::setInteractionsEnabled(bool val)
     }
 }
 
+void FT1D::DisplaySignalWidget::setRasterized(bool enabled)
+{
+    if(enabled == (rasterizer != nullptr))
+    {
+        return;
+    }
+
+    if(enabled)
+    {
+        plot->addLayer(QStringLiteral("raster"), dataLayer, QCustomPlot::limAbove);
+        plot->layer(QStringLiteral("raster"))->setMode(QCPLayer::lmBuffered);
+        rasterFrame = new RasterFrame(plot, QStringLiteral("raster"));
+        rasterizer = new PlotRasterizer(this);
+
+        connect(rasterizer, &PlotRasterizer::frameReady, this, [=]()
+        {
+            rasterFrame->setFrame(rasterizer->frame(), *rasterizer->frameSnapshot());
+            rasterFrame->layer()->replot();
+        });
+
+        // the plottables stay on the data layer, so that nothing else changes, they are just not drawn by the plot
+        dataLayer->setVisible(false);
+        requestFrame();
+    }
+    else
+    {
+        delete rasterizer;
+        rasterizer = nullptr;
+        QCPLayer* rasterLayer = rasterFrame->layer();
+        delete rasterFrame;
+        rasterFrame = nullptr;
+        plot->removeLayer(rasterLayer);
+
+        dataLayer->setVisible(true);
+    }
+    plot->replot();
+}
+
+
+void FT1D::DisplaySignalWidget::requestFrame()
+{
+    if(rasterizer)
+    {
+        rasterizer->render(QSharedPointer<const PlotSnapshot>(new PlotSnapshot(plot, dataLayer)));
+    }
+}
+
+
+void FT1D::DisplaySignalWidget::replotData()
+{
+    if(rasterizer)
+    {
+        requestFrame();
+    }
+    else
+    {
+        dataLayer->replot();
+    }
+}
+
+
+void FT1D::DisplaySignalWidget::setOverlayVisible(bool visible)
+{
+    if(visible == (overlayLabel != nullptr))
+    {
+        return;
+    }
+
+    if(visible)
+    {
+        // a child of the plot, drawn over it, so that the plot itself does not change
+        overlayLabel = new QLabel(plot);
+        overlayLabel->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+        overlayLabel->setStyleSheet(QStringLiteral("QLabel { background-color: rgba(0, 0, 0, 160); color: white; padding: 3px; }"));
+        overlayLabel->setAttribute(Qt::WA_TransparentForMouseEvents);
+        overlay = PlotOverlay();
+        overlayLabel->show();
+        plot->replot();
+    }
+    else
+    {
+        delete overlayLabel;
+        overlayLabel = nullptr;
+    }
+}
+
+
+void FT1D::DisplaySignalWidget::recordFrame()
+{
+    if(overlayLabel == nullptr)
+    {
+        return;
+    }
+
+    const double paintTime = plot->replotTime();
+    overlay.addFrame(paintTime + overlay.stageTime(STAGE_TRANSFORM) + overlay.stageTime(STAGE_UPLOAD), paintTime, plot->replotCount());
+    overlayLabel->setText(overlay.text());
+    overlayLabel->adjustSize();
+
+    const QRect rect = plot->axisRect()->rect();
+    overlayLabel->move(rect.right() - overlayLabel->width() - OVERLAY_LABEL_MARGIN, rect.top() + OVERLAY_LABEL_MARGIN);
+}
+
+
+void FT1D::DisplaySignalWidget::setPlotSize(const QSize& size)
+{
+    plot->setViewport(QRect(QPoint(0, 0), size));
+    // the axis rect is laid out for the viewport by a replot
+    plot->replot();
+    plotXAxisChanged(plot->xAxis->range());
+}
+
+
+bool FT1D::DisplaySignalWidget::savePlot(const QString& path, bool pdf, int width, int height)
+{
+    return pdf ? plot->savePdf(path, false, width, height) : plot->savePng(path, width, height);
+}
+
+
 void FT1D::DisplaySignalWidget::setSibling(FT1D::DisplaySignalWidget*& other)
 {
     this->sibling = other;
     other->sibling = this;
 }
+
+
+void FT1D::DisplaySignalWidget::benchmark(int frames)
+{
+    GeneratorParameters parameters;
+    parameters.shape = SHAPE_SINE;
+    parameters.length = BENCHMARK_SIGNAL_LENGTH;
+
+    Signal signal;
+    SignalGenerator::generate(parameters, signal);
+
+    DisplaySignalWidget widget(PHASE, false);
+    widget.plot->resize(BENCHMARK_PLOT_WIDTH, BENCHMARK_PLOT_HEIGHT);
+    widget.plot->setViewport(widget.plot->rect());
+    widget.displaySignal(&signal);
+
+    const QVector<double> xs = signal.x();
+    const int length = signal.original_length();
+
+    // [0] hovering, [1] dragging a point; full replot, only the buffered layer
+    double full[2] = {0, 0};
+    double layered[2] = {0, 0};
+
+    for(int i = 0; i < frames; i++)
+    {
+        const double x = xs[i % xs.size()];
+        widget.verticalLine->setVisible(true);
+        widget.verticalLine->start->setCoords(x, -999999999);
+        widget.verticalLine->end->setCoords(x, 999999999);
+
+        widget.plot->replot();
+        full[0] += widget.plot->replotTime();
+        widget.cursorLayer->replot();
+        layered[0] += widget.plot->replotTime();
+
+        signal.updateAll(i % length, std::sin(i * 0.1));
+        widget.displaySignalRange();
+
+        widget.plot->replot();
+        full[1] += widget.plot->replotTime();
+        widget.dataLayer->replot();
+        layered[1] += widget.plot->replotTime();
+    }
+
+    // composing the buffers on the screen is not included, the widget is not shown
+    std::cout << std::fixed << std::setprecision(3)
+              << "hover: " << full[0] / frames << " ms per frame with a full replot, "
+              << layered[0] / frames << " ms with the cursor layer only" << std::endl
+              << "drag:  " << full[1] / frames << " ms per frame with a full replot, "
+              << layered[1] / frames << " ms with the signal layer only" << std::endl;
+}
+
+
+void FT1D::DisplaySignalWidget::benchmarkMarkers(int count)
+{
+    QVector<QPointF> positions(count);
+    std::srand(1);
+    for(int i = 0; i < count; i++)
+    {
+        positions[i] = QPointF(std::rand() % (BENCHMARK_PLOT_WIDTH * 8) / 8.0, std::rand() % (BENCHMARK_PLOT_HEIGHT * 8) / 8.0);
+    }
+
+    QImage image(BENCHMARK_PLOT_WIDTH, BENCHMARK_PLOT_HEIGHT, QImage::Format_ARGB32_Premultiplied);
+    const QCPScatterStyle style(QCPScatterStyle::ssCircle, Qt::blue, Qt::blue, 5);
+
+    // [0] the style of the plots, [1] antialiased, as the markers of the spiral could be
+    double perShape[2] = {0, 0};
+    double sprites[2] = {0, 0};
+    QElapsedTimer timer;
+
+    for(int antialiased = 0; antialiased < 2; antialiased++)
+    {
+        image.fill(Qt::white);
+        QCPPainter painter(&image);
+        painter.setAntialiasing(antialiased == 1);
+        style.applyTo(&painter, QPen());
+
+        timer.start();
+        for(int i = 0; i < count; i++)
+        {
+            style.drawShape(&painter, positions[i]);
+        }
+        perShape[antialiased] = timer.nsecsElapsed() * 1e-6;
+
+        // the first call renders the sprite, it is included
+        timer.start();
+        style.drawShapes(&painter, positions);
+        sprites[antialiased] = timer.nsecsElapsed() * 1e-6;
+    }
+
+    std::cout << std::fixed << std::setprecision(3)
+              << count << " markers: " << perShape[0] << " ms drawn one by one, "
+              << sprites[0] << " ms copied from a sprite" << std::endl
+              << count << " antialiased markers: " << perShape[1] << " ms drawn one by one, "
+              << sprites[1] << " ms copied from a sprite" << std::endl;
+}
@@ -10,8 +10,14 @@
 
 #include "qcustomplot/qcustomplot.h"
 #include "signal.h"
+#include "pagedsignal.h"
+#include "minmaxpyramid.h"
+#include "plotrasterizer.h"
+#include "plotoverlay.h"
 #include "localization.h"
 
+#include <QSharedPointer>
+
 namespace FT1D
 {
 
@@ -57,6 +63,20 @@ public:
      */
     void displaySignal(Signal* signal, bool shadowPrevious = false);
 
+    /**
+     * @brief appendSamples updates the plot after samples were appended to the displayed signal.
+     * Only the visible range is given to the plot again and the min/max summary is extended by the new samples.
+     * @param values values of the appended samples
+     */
+    void appendSamples(const QVector<double>& values);
+
+    /**
+     * @brief displayPagedSignal displays an out-of-core signal. The whole signal is shown as a min/max envelope,
+     * the samples themselves are read from the file when the visible range is short enough. The signal cannot be edited.
+     * @param signal signal to display, must stay open while it is displayed
+     */
+    void displayPagedSignal(const PagedSignal* signal);
+
 
     /**
      * @brief plotReplot replots the plot.
@@ -81,17 +101,103 @@ public:
     void setLocalizedTexts(const Translation* language);
 
     /**
-     * @brief setInteractionsEnabled disables or enables interaction in the widget
+     * @brief setInteractionsEnabled disables or enables interaction in the widget, including moving of the points
      * @param val true to enable, false to disable.
      */
     void setInteractionsEnabled(bool val);
 
+    /**
+     * @brief setRasterized switches drawing of the signal to a worker thread. The graphs are rasterized from immutable snapshots
+     * of the data and the axis ranges; the plot only copies the latest finished frame, so dragging and zooming a large plot
+     * stays responsive while the signal catches up.
+     * @param enabled true to draw the signal on the worker thread, false to draw it with the rest of the plot
+     */
+    void setRasterized(bool enabled);
+
+    /**
+     * @brief isRasterized
+     * @return true, if the signal is drawn on a worker thread
+     */
+    inline bool isRasterized() const
+    {
+        return rasterizer != nullptr;
+    }
+
+    /**
+     * @brief setOverlayVisible shows or hides the overlay with the frame time, the number of replots and the times of the stages
+     * of the update which produced the last frame. Nothing is measured while it is hidden.
+     * @param visible
+     */
+    void setOverlayVisible(bool visible);
+
+    /**
+     * @brief setPlotSize lays the plot out for @a size without resizing the widget, e.g. for a widget which is only exported,
+     * and displays the visible range in the detail appropriate for it. The size is kept until the widget is resized.
+     * @param size size of the plot in pixels
+     */
+    void setPlotSize(const QSize& size);
+
+    /**
+     * @brief savePlot saves the plot to a file, without the axis labels of the widget
+     * @param path path to the file
+     * @param pdf true to save a PDF file, false to save a PNG image
+     * @param width width of the saved plot in pixels, the size of the plot if 0
+     * @param height height of the saved plot in pixels, the size of the plot if 0
+     * @return true in case of success
+     */
+    bool savePlot(const QString& path, bool pdf, int width = 0, int height = 0);
+
     /**
      * @brief setSibling sets a pointer to a sibling widget. This widget is rescaled together with this
      * @param other a valid pointer to another widget. Causion: pointer validity is not checked!
      */
     void setSibling(DisplaySignalWidget*& other);
 
+    /**
+     * @brief viewRange gets the visible part of the plot
+     * @param x output, range of the x axis
+     * @param y output, range of the y axis
+     */
+    void viewRange(QCPRange& x, QCPRange& y) const;
+
+    /**
+     * @brief setViewRange shows the given part of the plot, e.g. when a session is restored
+     * @param x range of the x axis
+     * @param y range of the y axis
+     */
+    void setViewRange(const QCPRange& x, const QCPRange& y);
+
+    /**
+     * @brief setInterpolatedSpectrum sets the zero-padded spectrum drawn as a curve below the fourier coefficients. Used only by the MAGNITUDE widget.
+     * The coefficients stay editable, the curve is recomputed by the application after each change.
+     * @param values magnitudes of the zero-padded transform, interpolationFactor() values per coefficient
+     */
+    void setInterpolatedSpectrum(const QVector<double>& values);
+
+    /**
+     * @brief interpolationFactor
+     * @return zero-padding factor of the interpolated spectrum selected in the context menu, 1 if the interpolated spectrum is off
+     */
+    inline int interpolationFactor() const
+    {
+        return factor;
+    }
+
+    /**
+     * @brief benchmark measures drawing of a plot while the cursor line moves and while a point is dragged,
+     * once with a full replot and once with only the buffered layer which changed, and prints the times to standard output.
+     * Requires a QApplication.
+     * @param frames number of frames drawn in each case
+     */
+    static void benchmark(int frames);
+
+    /**
+     * @brief benchmarkMarkers measures painting of scatter markers to an offscreen image, once drawn one by one
+     * and once copied from the cached sprite, and prints the times to standard output. Requires a QApplication.
+     * @param count number of markers painted in each case
+     */
+    static void benchmarkMarkers(int count);
+
     /**
      * @brief forceXAxisUpdate Artificially triggers plotXAxisChanged callback
      */
@@ -146,6 +252,12 @@ signals:
      */
     void mouseLeave();
 
+    /**
+     * @brief interpolationFactorChanged notifies the application that a different zero-padding factor was selected
+     * @param factor new factor, 1 means the interpolated spectrum is off
+     */
+    void interpolationFactorChanged(int factor);
+
 
 public slots:
     /**
@@ -231,6 +343,51 @@ private:
     void placePlotBackground(QCPItemRect*& section);
 
 
+    /**
+     * @brief displayInterpolatedSpectrum sets the data of the interpolated curve, repeated over the extended range of the displayed signal
+     */
+    void displayInterpolatedSpectrum();
+
+    /**
+     * @brief displaySignalRange gives the plot the part of the in-memory signal visible in it. When there are more than
+     * LOD_SAMPLES_PER_PIXEL samples per pixel column, a min/max envelope of one bucket per column is given instead,
+     * computed from the samples or, for long ranges, from lodPyramid.
+     */
+    void displaySignalRange();
+
+    /**
+     * @brief displayShadowRange gives the shadow graph the part of the previous signal visible in the plot. Markers are
+     * drawn under the same condition as for the signal, instead of a dense range a line through the minimum and
+     * the maximum of each pixel column is given.
+     */
+    void displayShadowRange();
+
+    /**
+     * @brief removeShadowGraph removes the shadow of the previous signal, if it is displayed, and redraws its layer
+     * @return true, if it was displayed
+     */
+    bool removeShadowGraph();
+
+    /**
+     * @brief requestFrame passes a snapshot of the data layer to the rasterizer, if the plot is rasterized
+     */
+    void requestFrame();
+
+    /**
+     * @brief replotData redraws the data layer after the signal changed, or requests a new frame if the plot is rasterized
+     */
+    void replotData();
+
+    /**
+     * @brief recordFrame records the last replot of the plot in the overlay, if it is visible
+     */
+    void recordFrame();
+
+    /**
+     * @brief displayPagedRange fetches the part of the out-of-core signal visible in the plot, in the detail appropriate for the zoom
+     */
+    void displayPagedRange();
+
     /**
      * @brief roundToClosestMultiple rounds @a toRound to the closes multiple of @a base
      * @param toRound
@@ -254,13 +411,48 @@ private:    // attributes
     QCustomPlot *plot;
 
     Signal* p_signal;
-    Signal* shadow_signal;
+    // the previously displayed signal. Its data are implicitly shared with p_signal, so taking it copies nothing;
+    // they are copied only when p_signal is modified while the shadow exists
+    QSharedPointer<const Signal> shadow_signal;
+
+    // the displayed out-of-core signal, p_signal is null while it is displayed
+    const PagedSignal* p_paged;
+
+    // level of detail of p_signal: the lower envelope, drawn below the signal graph; null in EDIT_MODE
+    QCPGraph* lodLowerGraph;
+    // min/max summary of the values of p_signal, built when the envelope is displayed for the first time
+    MinMaxPyramid lodPyramid;
+    bool lodPyramidValid;
+    // true while the envelope is displayed instead of the samples
+    bool lodEnvelope;
+
+    // the previous signal in gray, on shadowLayer; null unless displaySignal was asked to keep it
+    QCPGraph* shadowGraph;
+    // the signal drawn by shadowGraph, taken from shadow_signal before it is replaced by the new signal;
+    // kept until the shadow is removed, so that a change of the range draws the same previous signal
+    QSharedPointer<const Signal> shadowGraphSignal;
 
     bool centering;
 
+    // false while setInteractionsEnabled disabled the interaction, the points cannot be moved then
+    bool interactionsEnabled;
+
     QCPItemRect* plotBackground;
     QCPItemLine* verticalLine;
 
+    // buffered layers of the plot, owned by it: the shadow graph, the signal and the cursor line
+    QCPLayer* shadowLayer;
+    QCPLayer* dataLayer;
+    QCPLayer* cursorLayer;
+
+    // draws the data layer on a worker thread and the frame displaying its result on the "raster" layer; null unless rasterized
+    PlotRasterizer* rasterizer;
+    RasterFrame* rasterFrame;
+
+    // timings of the plot and the label displaying them; null unless the overlay is visible
+    PlotOverlay overlay;
+    QLabel* overlayLabel;
+
     bool haveSelectedPoint;
     double selectedPointX;
 
@@ -269,6 +461,13 @@ private:    // attributes
     QAction* actionAutoScaling;
     QAction* actionEditMode;
 
+    // interpolated spectrum, only in the MAGNITUDE widget
+    QMenu* menuInterpolation;
+    QActionGroup* interpolationGroup;
+    QCPCurve* interpolatedCurve;
+    QVector<double> interpolatedValues;
+    int factor;
+
     QLabel* plotxAxisLabel;
     QLabel* plotyAxisLabel;
 
@@ -0,0 +1,186 @@
+/**
+ * @file fftplan.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "fftplan.h"
+
+#include <cmath>
+#include <cassert>
+#include <utility>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using namespace FT1D;
+
+FFTPlan::FFTPlan(int length)
+{
+    assert(length > 0);
+
+    n = length;
+
+    if(!isPowerOfTwo(n))
+    {
+        const int m = nextPowerOfTwo(2 * n - 1);
+        inner = QSharedPointer<FFTPlan>(new FFTPlan(m));
+
+        chirp.resize(n);
+        for(int k = 0; k < n; k++)
+        {
+            // k^2 is reduced modulo 2n first, the angle stays small and precise
+            const long long square = (static_cast<long long>(k) * k) % (2LL * n);
+            chirp[k] = std::polar(1.0, -M_PI * square / n);
+        }
+
+        chirpSpectrum.fill(std::complex<double>(), m);
+        chirpSpectrum[0] = std::conj(chirp[0]);
+        for(int k = 1; k < n; k++)
+        {
+            chirpSpectrum[k] = chirpSpectrum[m - k] = std::conj(chirp[k]);
+        }
+        inner->forward(chirpSpectrum.data());
+        return;
+    }
+
+    int bits = 0;
+    while((1 << bits) < n)
+    {
+        bits++;
+    }
+
+    bitReversal.resize(n);
+    for(int i = 0; i < n; i++)
+    {
+        int reversed = 0;
+        for(int b = 0; b < bits; b++)
+        {
+            if(i & (1 << b))
+            {
+                reversed |= 1 << (bits - 1 - b);
+            }
+        }
+        bitReversal[i] = reversed;
+    }
+
+    twiddles.resize(n / 2);
+    for(int k = 0; k < n / 2; k++)
+    {
+        twiddles[k] = std::polar(1.0, -2.0 * M_PI * k / n);
+    }
+}
+
+
+void FFTPlan::forward(std::complex<double>* data) const
+{
+    if(inner)
+    {
+        bluestein(data);
+    }
+    else
+    {
+        transform(data, false);
+    }
+}
+
+
+void FFTPlan::inverse(std::complex<double>* data) const
+{
+    if(inner)
+    {
+        // inverse transform is the conjugate of the forward transform of the conjugate
+        for(int i = 0; i < n; i++)
+        {
+            data[i] = std::conj(data[i]);
+        }
+        bluestein(data);
+        for(int i = 0; i < n; i++)
+        {
+            data[i] = std::conj(data[i]);
+        }
+    }
+    else
+    {
+        transform(data, true);
+    }
+}
+
+
+void FFTPlan::bluestein(std::complex<double>* data) const
+{
+    const int m = inner->length();
+    const std::complex<double>* w = chirp.constData();
+    const std::complex<double>* spectrum = chirpSpectrum.constData();
+
+    QVector<std::complex<double> > buffer(m);
+    std::complex<double>* a = buffer.data();
+
+    for(int k = 0; k < n; k++)
+    {
+        a[k] = data[k] * w[k];
+    }
+
+    inner->forward(a);
+    for(int k = 0; k < m; k++)
+    {
+        a[k] *= spectrum[k];
+    }
+    inner->inverse(a);
+
+    const double normalization = 1.0 / m;
+    for(int k = 0; k < n; k++)
+    {
+        data[k] = w[k] * a[k] * normalization;
+    }
+}
+
+
+void FFTPlan::transform(std::complex<double>* data, bool inverse) const
+{
+    const int* reversal = bitReversal.constData();
+    for(int i = 0; i < n; i++)
+    {
+        if(i < reversal[i])
+        {
+            std::swap(data[i], data[reversal[i]]);
+        }
+    }
+
+    const std::complex<double>* w = twiddles.constData();
+
+    for(int half = 1; half < n; half *= 2)
+    {
+        // twiddle for the j-th butterfly of this pass is w[j * stride]
+        const int stride = n / (2 * half);
+
+        for(int start = 0; start < n; start += 2 * half)
+        {
+            for(int j = 0; j < half; j++)
+            {
+                std::complex<double> twiddle = inverse ? std::conj(w[j * stride]) : w[j * stride];
+                std::complex<double> odd = data[start + j + half] * twiddle;
+
+                data[start + j + half] = data[start + j] - odd;
+                data[start + j] += odd;
+            }
+        }
+    }
+}
+
+
+bool FFTPlan::isPowerOfTwo(int value)
+{
+    return value > 0 && (value & (value - 1)) == 0;
+}
+
+
+int FFTPlan::nextPowerOfTwo(int value)
+{
+    int power = 1;
+    while(power < value)
+    {
+        power *= 2;
+    }
+    return power;
+}
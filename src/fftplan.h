@@ -0,0 +1,103 @@
+#ifndef FFTPLAN_H
+#define FFTPLAN_H
+
+/**
+ * @file fftplan.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of FFTPlan, a precomputed fast fourier transform of a fixed length.
+ */
+
+#include <QVector>
+#include <QSharedPointer>
+
+#include <complex>
+
+namespace FT1D
+{
+
+/**
+ * @brief The FFTPlan class precomputes twiddle factors and the bit reversal permutation of an iterative
+ * radix-2 fast fourier transform of a fixed length. Lengths, which are not a power of two, are transformed
+ * by Bluestein's algorithm, as a convolution with a chirp computed by a power of two plan.
+ * The plan is immutable after construction, so one instance can be shared by several threads transforming
+ * different buffers at the same time.
+ * The transforms are not normalized, forward followed by inverse multiplies the data by length().
+ */
+class FFTPlan
+{
+public:
+
+    /**
+     * @brief FFTPlan constructor, precomputes the tables for transforms of length @a length
+     * @param length length of the transform, must be positive
+     */
+    explicit FFTPlan(int length);
+
+    /**
+     * @brief length
+     * @return length of the transform
+     */
+    inline int length() const
+    {
+        return n;
+    }
+
+    /**
+     * @brief forward computes the forward transform of @a data in place
+     * @param data array of length() complex values
+     */
+    void forward(std::complex<double>* data) const;
+
+    /**
+     * @brief inverse computes the inverse transform of @a data in place
+     * @param data array of length() complex values
+     */
+    void inverse(std::complex<double>* data) const;
+
+    /**
+     * @brief isPowerOfTwo
+     * @param value
+     * @return true, if @a value is a positive power of two
+     */
+    static bool isPowerOfTwo(int value);
+
+    /**
+     * @brief nextPowerOfTwo
+     * @param value
+     * @return the smallest power of two greater or equal to @a value
+     */
+    static int nextPowerOfTwo(int value);
+
+private:
+
+    /**
+     * @brief transform the butterfly passes shared by forward and inverse transform
+     * @param data array of length() complex values
+     * @param inverse true for the inverse transform (conjugated twiddles)
+     */
+    void transform(std::complex<double>* data, bool inverse) const;
+
+    /**
+     * @brief bluestein computes the forward transform of a length, which is not a power of two
+     * @param data array of length() complex values
+     */
+    void bluestein(std::complex<double>* data) const;
+
+    // length of the transform
+    int n;
+
+    // bitReversal[i] is the index, to which the i-th input is moved before the butterflies
+    QVector<int> bitReversal;
+
+    // twiddles[k] = exp(-2 pi i k / n), for k < n / 2
+    QVector<std::complex<double> > twiddles;
+
+    // used only for lengths, which are not a power of two:
+    // chirp[k] = exp(-pi i k^2 / n), chirpSpectrum is the transform of its conjugate padded to the length of the inner plan
+    QVector<std::complex<double> > chirp;
+    QVector<std::complex<double> > chirpSpectrum;
+    QSharedPointer<FFTPlan> inner;
+};
+}
+#endif // FFTPLAN_H
@@ -5,6 +5,9 @@
 
 #include "filterdialog.h"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace FT1D;
 
 FilterDialog::FilterDialog(FilterType type, Signal& magnitude, const Translation* language, QWidget *parent)
@@ -113,6 +116,20 @@ FilterDialog::FilterDialog(FilterType type, Signal& magnitude, const Translation
         reject();
     });
 
+    notchLabel = nullptr;
+    notchComboBox = nullptr;
+    addNotchButton = nullptr;
+    removeNotchButton = nullptr;
+    positionLabel = nullptr;
+    positionSpinBox = nullptr;
+    widthLabel = nullptr;
+    widthSpinBox = nullptr;
+    profileComboBox = nullptr;
+    harmonicsLabel = nullptr;
+    harmonicsSpinBox = nullptr;
+    harmonicsButton = nullptr;
+    draggedNotch = -1;
+
 
     switch(type)
     {
@@ -137,6 +154,9 @@ FilterDialog::FilterDialog(FilterType type, Signal& magnitude, const Translation
     case HPBUTTERWORTH:
         initButterworthHighPass();
         break;
+    case NOTCH:
+        initNotchBank();
+        break;
     default:
         reject();
         break;
@@ -156,7 +176,7 @@ void FilterDialog::initLowPass()
 
     connect(okButton,&QPushButton::clicked,this,[=](bool)
     {
-        idealLowPassFilter(firstSlider->value());
+        idealLowPassFilter(magnitude, firstSlider->value());
         accept();
     });
 
@@ -207,7 +227,7 @@ void FilterDialog::initHighPass()
 
     connect(okButton,&QPushButton::clicked,this,[=](bool)
     {
-        idealHighPassFilter(maxFrequency - firstSlider->value());
+        idealHighPassFilter(magnitude, maxFrequency - firstSlider->value());
         accept();
     });
 
@@ -275,7 +295,7 @@ void FilterDialog::initBandPass()
 
     connect(okButton,&QPushButton::clicked,this,[=](bool)
     {
-        bandPassFilter(firstLineEdit->text().toInt(), secondLineEdit->text().toInt());
+        bandPassFilter(magnitude, firstLineEdit->text().toInt(), secondLineEdit->text().toInt());
         accept();
     });
 
@@ -357,7 +377,7 @@ void FilterDialog::initGaussianLowPass()
 
     connect(okButton,&QPushButton::clicked,this,[=](bool)
     {
-        gaussianLowPassFilter(firstSlider->value());
+        gaussianLowPassFilter(magnitude, firstSlider->value());
         accept();
     });
 
@@ -405,7 +425,7 @@ void FilterDialog::initGaussianHighPass()
 
     connect(okButton,&QPushButton::clicked,this,[=](bool)
     {
-        gaussianHighPassFilter(maxFrequency - firstSlider->value());
+        gaussianHighPassFilter(magnitude, maxFrequency - firstSlider->value());
         accept();
     });
 
@@ -459,7 +479,7 @@ void FilterDialog::initButterworthLowPass()
 
     connect(okButton,&QPushButton::clicked,this,[=](bool)
     {
-        butterworthLowPassFilter(firstSlider->value(),spinBox->value());
+        butterworthLowPassFilter(magnitude, firstSlider->value(),spinBox->value());
         accept();
     });
 
@@ -518,7 +538,7 @@ void FilterDialog::initButterworthHighPass()
 
     connect(okButton,&QPushButton::clicked,this,[=](bool)
     {
-        butterworthHighPassFilter(maxFrequency - firstSlider->value(),spinBox->value());
+        butterworthHighPassFilter(magnitude, maxFrequency - firstSlider->value(),spinBox->value());
         accept();
     });
 
@@ -563,6 +583,215 @@ void FilterDialog::initButterworthHighPass()
     spinBox->setValue(2);
 }
 
+void FilterDialog::initNotchBank()
+{
+    notchLabel = new QLabel(this);
+    notchLabel->setGeometry(320, 70, 50, 25);
+
+    notchComboBox = new QComboBox(this);
+    notchComboBox->setGeometry(370, 70, 100, 25);
+
+    addNotchButton = new QPushButton(this);
+    addNotchButton->setGeometry(475, 70, 80, 25);
+
+    removeNotchButton = new QPushButton(this);
+    removeNotchButton->setGeometry(560, 70, 80, 25);
+
+    positionLabel = new QLabel(QStringLiteral("ω₀: "), this);
+    positionLabel->setGeometry(320, 105, 25, 25);
+
+    positionSpinBox = new QDoubleSpinBox(this);
+    positionSpinBox->setGeometry(345, 105, 70, 25);
+    positionSpinBox->setRange(0, maxFrequency);
+    positionSpinBox->setDecimals(1);
+    positionSpinBox->setSingleStep(0.5);
+
+    widthLabel = new QLabel(this);
+    widthLabel->setGeometry(420, 105, 45, 25);
+
+    widthSpinBox = new QDoubleSpinBox(this);
+    widthSpinBox->setGeometry(465, 105, 60, 25);
+    widthSpinBox->setRange(0.1, std::max(1, maxFrequency));
+    widthSpinBox->setDecimals(1);
+    widthSpinBox->setSingleStep(0.5);
+
+    profileComboBox = new QComboBox(this);
+    profileComboBox->setGeometry(530, 105, 110, 25);
+    profileComboBox->addItem(QStringLiteral("Ideal"), IDEAL_NOTCH);
+    profileComboBox->addItem(QStringLiteral("Gaussian"), GAUSSIAN_NOTCH);
+    profileComboBox->addItem(QStringLiteral("Butterworth"), BUTTERWORTH_NOTCH);
+
+    harmonicsLabel = new QLabel(this);
+    harmonicsLabel->setGeometry(320, 140, 70, 25);
+
+    harmonicsSpinBox = new QSpinBox(this);
+    harmonicsSpinBox->setGeometry(390, 140, 50, 25);
+    harmonicsSpinBox->setRange(1, 99);
+    harmonicsSpinBox->setValue(3);
+
+    harmonicsButton = new QPushButton(this);
+    harmonicsButton->setGeometry(445, 140, 110, 25);
+
+    // markers of the notch positions, the selected one is red
+    plot->addGraph();
+    plot->graph(1)->setLineStyle(QCPGraph::lsNone);
+    plot->graph(1)->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssTriangle, Qt::darkGray, Qt::darkGray, 8));
+    plot->addGraph();
+    plot->graph(2)->setLineStyle(QCPGraph::lsNone);
+    plot->graph(2)->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssTriangle, Qt::red, Qt::red, 8));
+
+    connect(notchComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, [=](int index)
+    {
+        selectNotch(index);
+        notchGraph();
+    });
+
+    connect(addNotchButton, &QPushButton::clicked, this, [=](bool)
+    {
+        const int index = notchComboBox->currentIndex();
+        const double width = index >= 0 ? notches.width(index) : 1.0;
+        const NotchProfile profile = index >= 0 ? notches.profile(index) : IDEAL_NOTCH;
+        updateNotchList(notches.addNotch(maxFrequency / 2.0, width, profile));
+    });
+
+    connect(removeNotchButton, &QPushButton::clicked, this, [=](bool)
+    {
+        const int index = notchComboBox->currentIndex();
+        if(index >= 0)
+        {
+            notches.removeNotch(index);
+            updateNotchList(std::min(index, notches.count() - 1));
+        }
+    });
+
+    connect(positionSpinBox, static_cast<void (QDoubleSpinBox::*)(double)>(&QDoubleSpinBox::valueChanged), this, [=](double value)
+    {
+        const int index = notchComboBox->currentIndex();
+        if(index >= 0)
+        {
+            notches.setPosition(index, value);
+            notchComboBox->setItemText(index, QStringLiteral("%1: %2").arg(index + 1).arg(value, 0, 'f', 1));
+            notchGraph();
+        }
+    });
+
+    connect(widthSpinBox, static_cast<void (QDoubleSpinBox::*)(double)>(&QDoubleSpinBox::valueChanged), this, [=](double value)
+    {
+        const int index = notchComboBox->currentIndex();
+        if(index >= 0)
+        {
+            notches.setWidth(index, value);
+            notchGraph();
+        }
+    });
+
+    connect(profileComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, [=](int)
+    {
+        const int index = notchComboBox->currentIndex();
+        if(index >= 0)
+        {
+            notches.setProfile(index, static_cast<NotchProfile>(profileComboBox->currentData().toInt()));
+            notchGraph();
+        }
+    });
+
+    connect(harmonicsButton, &QPushButton::clicked, this, [=](bool)
+    {
+        const int index = notchComboBox->currentIndex();
+        if(index >= 0)
+        {
+            notches.addHarmonics(index, harmonicsSpinBox->value(), maxFrequency);
+            updateNotchList(index);
+        }
+    });
+
+    // notches are dragged horizontally by their markers
+    connect(plot, &QCustomPlot::mousePress, this, [=](QMouseEvent* event)
+    {
+        const int index = notches.nearestNotch(plot->xAxis->pixelToCoord(event->pos().x()));
+        if(index >= 0 && std::abs(plot->xAxis->coordToPixel(notches.position(index)) - event->pos().x()) <= 6)
+        {
+            draggedNotch = index;
+            notchComboBox->setCurrentIndex(index);
+        }
+    });
+
+    connect(plot, &QCustomPlot::mouseMove, this, [=](QMouseEvent* event)
+    {
+        if(draggedNotch >= 0)
+        {
+            const double position = std::max(0.0, std::min<double>(maxFrequency, plot->xAxis->pixelToCoord(event->pos().x())));
+            positionSpinBox->setValue(std::round(position * 10.0) / 10.0);
+        }
+    });
+
+    connect(plot, &QCustomPlot::mouseRelease, this, [=](QMouseEvent*)
+    {
+        draggedNotch = -1;
+    });
+
+    connect(okButton,&QPushButton::clicked,this,[=](bool)
+    {
+        notchFilter();
+        accept();
+    });
+
+    filterName->setText("Notch filter bank");
+    filterFormula->setText("G(ω) = G₁(ω) · G₂(ω) · … · Gₖ(ω)");
+
+    notchLabel->setText(QStringLiteral("Notch:"));
+    addNotchButton->setText(QStringLiteral("Add"));
+    removeNotchButton->setText(QStringLiteral("Remove"));
+    widthLabel->setText(QStringLiteral("Width:"));
+    harmonicsLabel->setText(QStringLiteral("Harmonics:"));
+    harmonicsButton->setText(QStringLiteral("Add harmonics"));
+
+    updateNotchList(notches.addNotch(maxFrequency / 2.0, 1.0, IDEAL_NOTCH));
+}
+
+
+void FilterDialog::selectNotch(int index)
+{
+    const bool valid = index >= 0 && index < notches.count();
+
+    positionSpinBox->blockSignals(true);
+    widthSpinBox->blockSignals(true);
+    profileComboBox->blockSignals(true);
+
+    if(valid)
+    {
+        positionSpinBox->setValue(notches.position(index));
+        widthSpinBox->setValue(notches.width(index));
+        profileComboBox->setCurrentIndex(profileComboBox->findData(notches.profile(index)));
+    }
+
+    positionSpinBox->blockSignals(false);
+    widthSpinBox->blockSignals(false);
+    profileComboBox->blockSignals(false);
+
+    positionSpinBox->setEnabled(valid);
+    widthSpinBox->setEnabled(valid);
+    profileComboBox->setEnabled(valid);
+    removeNotchButton->setEnabled(valid);
+    harmonicsButton->setEnabled(valid);
+}
+
+
+void FilterDialog::updateNotchList(int selected)
+{
+    notchComboBox->blockSignals(true);
+    notchComboBox->clear();
+    for(int i = 0; i < notches.count(); i++)
+    {
+        notchComboBox->addItem(QStringLiteral("%1: %2").arg(i + 1).arg(notches.position(i), 0, 'f', 1));
+    }
+    notchComboBox->setCurrentIndex(selected);
+    notchComboBox->blockSignals(false);
+
+    selectNotch(selected);
+    notchGraph();
+}
+
 
 void FilterDialog::ilpfGraph(int c)
 {
@@ -732,18 +961,52 @@ void FilterDialog::bhpfGraph(double omega0, int n)
     plot->replot();
 }
 
-void FilterDialog::idealLowPassFilter(int value)
+void FilterDialog::notchGraph()
+{
+    // sampled finer than the spectrum, so that narrow notches between the bins are visible
+    const int samplesPerBin = 8;
+
+    QVector<double> keys;
+    keys.reserve(maxFrequency * samplesPerBin + 1);
+    for(int i = 0; i <= maxFrequency * samplesPerBin; i++)
+    {
+        keys.push_back(static_cast<double>(i) / samplesPerBin);
+    }
+
+    plot->graph(0)->setData(keys, notches.evaluate(keys));
+
+    QVector<double> markerKeys;
+    QVector<double> markerValues;
+    for(int i = 0; i < notches.count(); i++)
+    {
+        markerKeys.push_back(notches.position(i));
+        markerValues.push_back(0);
+    }
+    plot->graph(1)->setData(markerKeys, markerValues);
+
+    plot->graph(2)->clearData();
+    const int selected = notchComboBox->currentIndex();
+    if(selected >= 0 && selected < notches.count())
+    {
+        plot->graph(2)->addData(notches.position(selected), 0);
+    }
+
+    plot->replot();
+}
+
+
+void FilterDialog::idealLowPassFilter(Signal& spectrum, int value)
 {
-    QVector<double> x;
+    const int nyquist = spectrum.original_length() / 2;
     QVector<double> y;
+    y.reserve(spectrum.original_length());
 
     int i = 0;
     int frekv = 0;
 
 
-    while(i <= maxFrequency)
+    while(i <= nyquist)
     {
-        x.push_back(i);
         y.push_back(frekv <= value ? 1 : 0);
         i++;
         frekv++;
@@ -751,40 +1014,36 @@ void FilterDialog::idealLowPassFilter(int value)
 
     frekv--;
 
-    if(magnitude.original_length() % 2 == 1)
+    if(spectrum.original_length() % 2 == 1)
     {
-        x.push_back(i);
         y.push_back(frekv <= value ? 1 : 0);
         i++;
     }
 
     frekv--;
 
-    while(i < magnitude.original_length())
+    while(i < spectrum.original_length())
     {
-        x.push_back(i);
         y.push_back(frekv <= value ? 1 : 0);
         i++;
         frekv--;
     }
 
-    Signal filter(x,y);
-
-    // apply filter on magnitude
-    magnitude = magnitude.applyFilter(filter);
+    // apply filter on the magnitude spectrum
+    spectrum.applyFilterInPlace(y);
 }
 
-void FilterDialog::idealHighPassFilter(int value)
+void FilterDialog::idealHighPassFilter(Signal& spectrum, int value)
 {
-    QVector<double> x;
+    const int nyquist = spectrum.original_length() / 2;
     QVector<double> y;
+    y.reserve(spectrum.original_length());
 
     int i = 0;
     int frekv = 0;
 
-    while(i <= maxFrequency)
+    while(i <= nyquist)
     {
-        x.push_back(i);
         y.push_back(frekv >= value ? 1 : 0);
         i++;
         frekv++;
@@ -792,39 +1051,34 @@ void FilterDialog::idealHighPassFilter(int value)
 
     frekv--;
 
-    if(magnitude.original_length() % 2 == 1)
+    if(spectrum.original_length() % 2 == 1)
     {
-        x.push_back(i);
         y.push_back(frekv >= value ? 1 : 0);
         i++;
     }
 
     frekv--;
 
-    while(i < magnitude.original_length())
+    while(i < spectrum.original_length())
     {
-        x.push_back(i);
         y.push_back(frekv >= value ? 1 : 0);
         i++;
         frekv--;
     }
 
-    Signal filter(x,y);
-
-    magnitude = magnitude.applyFilter(filter);
+    spectrum.applyFilterInPlace(y);
 }
 
-void FilterDialog::bandPassFilter(double min, double max)
+void FilterDialog::bandPassFilter(Signal& spectrum, double min, double max)
 {
-    QVector<double> x;
     QVector<double> y;
+    y.reserve(spectrum.original_length());
 
     int i = 0;
     int frekv = 0;
 
     while(i <= max)
     {
-        x.push_back(i);
         y.push_back(min <= frekv && frekv <= max ? 1 : 0);
         i++;
         frekv++;
@@ -832,39 +1086,35 @@ void FilterDialog::bandPassFilter(double min, double max)
 
     frekv--;
 
-    if(magnitude.original_length() % 2 == 1)
+    if(spectrum.original_length() % 2 == 1)
     {
-        x.push_back(i);
         y.push_back(min <= frekv && frekv <= max ? 1 : 0);
         i++;
     }
 
     frekv--;
 
-    while(i < magnitude.original_length())
+    while(i < spectrum.original_length())
     {
-        x.push_back(i);
         y.push_back(min <= frekv && frekv <= max ? 1 : 0);
         i++;
         frekv--;
     }
 
-    Signal filter(x,y);
-
-    magnitude = magnitude.applyFilter(filter);
+    spectrum.applyFilterInPlace(y);
 }
 
-void FilterDialog::gaussianLowPassFilter(double omega0)
+void FilterDialog::gaussianLowPassFilter(Signal& spectrum, double omega0)
 {
-    QVector<double> x;
+    const int nyquist = spectrum.original_length() / 2;
     QVector<double> y;
+    y.reserve(spectrum.original_length());
 
     int i = 0;
     int frekv = 0;
 
-    while(i <= maxFrequency)
+    while(i <= nyquist)
     {
-        x.push_back(i);
         y.push_back(exp(- (double)(frekv * frekv) / ( 2.0 * omega0 * omega0)));
         i++;
         frekv++;
@@ -872,39 +1122,35 @@ void FilterDialog::gaussianLowPassFilter(double omega0)
 
     frekv--;
 
-    if(magnitude.original_length() % 2 == 1)
+    if(spectrum.original_length() % 2 == 1)
     {
-        x.push_back(i);
         y.push_back(exp(- (double)(frekv * frekv) / ( 2.0 * omega0 * omega0)));
         i++;
     }
 
     frekv--;
 
-    while(i < magnitude.original_length())
+    while(i < spectrum.original_length())
     {
-        x.push_back(i);
         y.push_back(exp(- (double)(frekv * frekv) / ( 2.0 * omega0 * omega0)));
         i++;
         frekv--;
     }
 
-    Signal filter(x,y);
-
-    magnitude = magnitude.applyFilter(filter);
+    spectrum.applyFilterInPlace(y);
 }
 
-void FilterDialog::gaussianHighPassFilter(double omega0)
+void FilterDialog::gaussianHighPassFilter(Signal& spectrum, double omega0)
 {
-    QVector<double> x;
+    const int nyquist = spectrum.original_length() / 2;
     QVector<double> y;
+    y.reserve(spectrum.original_length());
 
     int i = 0;
     int frekv = 0;
 
-    while(i <= maxFrequency)
+    while(i <= nyquist)
     {
-        x.push_back(i);
         y.push_back(omega0 == 0? 1.0 : 1.0 - exp(- (double)(frekv * frekv) / (2.0 * omega0 * omega0)));
         i++;
         frekv++;
@@ -912,39 +1158,35 @@ void FilterDialog::gaussianHighPassFilter(double omega0)
 
     frekv--;
 
-    if(magnitude.original_length() % 2 == 1)
+    if(spectrum.original_length() % 2 == 1)
     {
-        x.push_back(i);
         y.push_back(omega0 == 0? 1.0 : 1.0 - exp(- (double)(frekv * frekv) / (2.0 * omega0 * omega0)));
         i++;
     }
 
     frekv--;
 
-    while(i < magnitude.original_length())
+    while(i < spectrum.original_length())
     {
-        x.push_back(i);
         y.push_back(omega0 == 0? 1.0 : 1.0 - exp(- (double)(frekv * frekv) / (2.0 * omega0 * omega0)));
         i++;
         frekv--;
     }
 
-    Signal filter(x,y);
-
-    magnitude = magnitude.applyFilter(filter);
+    spectrum.applyFilterInPlace(y);
 }
 
-void FilterDialog::butterworthLowPassFilter(double omega0, int n)
+void FilterDialog::butterworthLowPassFilter(Signal& spectrum, double omega0, int n)
 {
-    QVector<double> x;
+    const int nyquist = spectrum.original_length() / 2;
     QVector<double> y;
+    y.reserve(spectrum.original_length());
 
     int i = 0;
     int frekv = 0;
 
-    while(i <= maxFrequency)
+    while(i <= nyquist)
     {
-        x.push_back(i);
         y.push_back(omega0 == 0? 0 : 1.0 / (1.0 + pow(((double)frekv / omega0), 2.0 * n)));
         i++;
         frekv++;
@@ -952,42 +1194,37 @@ void FilterDialog::butterworthLowPassFilter(double omega0, int n)
 
     frekv--;
 
-    if(magnitude.original_length() % 2 == 1)
+    if(spectrum.original_length() % 2 == 1)
     {
-        x.push_back(i);
         y.push_back(omega0 == 0? 0 : 1.0 / (1.0 + pow(((double)frekv / omega0), 2.0 * n)));
         i++;
     }
 
     frekv--;
 
-    while(i < magnitude.original_length())
+    while(i < spectrum.original_length())
     {
-        x.push_back(i);
         y.push_back(omega0 == 0? 0 : 1.0 / (1.0 + pow(((double)frekv / omega0), 2.0 * n)));
         i++;
         frekv--;
     }
 
-    Signal filter(x,y);
-
-    magnitude = magnitude.applyFilter(filter);
+    spectrum.applyFilterInPlace(y);
 }
 
-void FilterDialog::butterworthHighPassFilter(double omega0, int n)
+void FilterDialog::butterworthHighPassFilter(Signal& spectrum, double omega0, int n)
 {
-    QVector<double> x;
+    const int nyquist = spectrum.original_length() / 2;
     QVector<double> y;
+    y.reserve(spectrum.original_length());
 
-    x.push_back(0);
     y.push_back(0);
 
     int i = 1;
     int frekv = 1;
 
-    while(i <= maxFrequency)
+    while(i <= nyquist)
     {
-        x.push_back(i);
         y.push_back(1.0 / (1.0 + pow((omega0 / (double)frekv), 2.0 * n)));
         i++;
         frekv++;
@@ -995,26 +1232,69 @@ void FilterDialog::butterworthHighPassFilter(double omega0, int n)
 
     frekv--;
 
-    if(magnitude.original_length() % 2 == 1)
+    if(spectrum.original_length() % 2 == 1)
     {
-        x.push_back(i);
         y.push_back(1.0 / (1.0 + pow((omega0 / (double)frekv), 2.0 * n)));
         i++;
     }
 
     frekv--;
 
-    while(i < magnitude.original_length())
+    while(i < spectrum.original_length())
     {
-        x.push_back(i);
         y.push_back(1.0 / (1.0 + pow((omega0 / (double)frekv), 2.0 * n)));
         i++;
         frekv--;
     }
 
-    Signal filter(x,y);
+    spectrum.applyFilterInPlace(y);
+}
+
+
+bool FilterDialog::applyFilter(FilterType type, Signal& spectrum, double omega0, double second)
+{
+    switch(type)
+    {
+    case ILPF:
+        idealLowPassFilter(spectrum, static_cast<int>(omega0));
+        return true;
+    case IHPF:
+        idealHighPassFilter(spectrum, static_cast<int>(omega0));
+        return true;
+    case BANDPASS:
+        bandPassFilter(spectrum, omega0, second);
+        return true;
+    case LPGAUSS:
+        gaussianLowPassFilter(spectrum, omega0);
+        return true;
+    case HPGAUSS:
+        gaussianHighPassFilter(spectrum, omega0);
+        return true;
+    case LPBUTTERWORTH:
+        butterworthLowPassFilter(spectrum, omega0, static_cast<int>(second));
+        return true;
+    case HPBUTTERWORTH:
+        butterworthHighPassFilter(spectrum, omega0, static_cast<int>(second));
+        return true;
+    default:
+        return false;
+    }
+}
+
 
-    magnitude = magnitude.applyFilter(filter);
+void FilterDialog::notchFilter()
+{
+    const int length = magnitude.original_length();
+
+    // the spectrum is not centered, index i belongs to frequency min(i, length - i)
+    QVector<double> frequencies;
+    frequencies.reserve(length);
+    for(int i = 0; i < length; i++)
+    {
+        frequencies.push_back(std::min(i, length - i));
+    }
+
+    magnitude.applyFilterInPlace(notches.evaluate(frequencies));
 }
 
 
@@ -1044,6 +1324,19 @@ FilterDialog::~FilterDialog()
     delete plot;
 
     delete spinBox;
+
+    delete notchLabel;
+    delete notchComboBox;
+    delete addNotchButton;
+    delete removeNotchButton;
+    delete positionLabel;
+    delete positionSpinBox;
+    delete widthLabel;
+    delete widthSpinBox;
+    delete profileComboBox;
+    delete harmonicsLabel;
+    delete harmonicsSpinBox;
+    delete harmonicsButton;
 }
 
 void FilterDialog::setDefaultTexts(FilterType type)
@@ -1072,6 +1365,9 @@ void FilterDialog::setDefaultTexts(FilterType type)
     case HPBUTTERWORTH:
         filterName->setText(QStringLiteral("Butterworth high-pass filter"));
         break;
+    case NOTCH:
+        filterName->setText(QStringLiteral("Notch filter bank"));
+        break;
     default:
         break;
     }
@@ -1135,6 +1431,24 @@ void FilterDialog::setLocalizedTexts(const Translation* language, FilterType typ
             if(tr) filterName->setText(tr->getChildElementText(QStringLiteral("filterName")));
             if(filterName->text().isEmpty()) filterName->setText(QStringLiteral("Butterworth high-pass filter"));
             break;
+        case NOTCH:
+            tr = language->getTranslationForUseCase(QStringLiteral("NotchBank"));
+            if(!tr) break;
+            filterName->setText(tr->getChildElementText(QStringLiteral("filterName")));
+            if(filterName->text().isEmpty()) filterName->setText(QStringLiteral("Notch filter bank"));
+            notchLabel->setText(tr->getChildElementText(QStringLiteral("notchLabel")));
+            if(notchLabel->text().isEmpty()) notchLabel->setText(QStringLiteral("Notch:"));
+            addNotchButton->setText(tr->getChildElementText(QStringLiteral("addNotchButton")));
+            if(addNotchButton->text().isEmpty()) addNotchButton->setText(QStringLiteral("Add"));
+            removeNotchButton->setText(tr->getChildElementText(QStringLiteral("removeNotchButton")));
+            if(removeNotchButton->text().isEmpty()) removeNotchButton->setText(QStringLiteral("Remove"));
+            widthLabel->setText(tr->getChildElementText(QStringLiteral("widthLabel")));
+            if(widthLabel->text().isEmpty()) widthLabel->setText(QStringLiteral("Width:"));
+            harmonicsLabel->setText(tr->getChildElementText(QStringLiteral("harmonicsLabel")));
+            if(harmonicsLabel->text().isEmpty()) harmonicsLabel->setText(QStringLiteral("Harmonics:"));
+            harmonicsButton->setText(tr->getChildElementText(QStringLiteral("harmonicsButton")));
+            if(harmonicsButton->text().isEmpty()) harmonicsButton->setText(QStringLiteral("Add harmonics"));
+            break;
         default:
             break;
         }
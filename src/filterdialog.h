@@ -9,6 +9,7 @@
 #include "localization.h"
 #include "qcustomplot/qcustomplot.h"
 #include "signal.h"
+#include "notchfilterbank.h"
 
 
 namespace FT1D
@@ -25,7 +26,8 @@ enum FilterType
     HPGAUSS,        // gaussian high-pass
     LPBUTTERWORTH,  // butterworth low-pass
     HPBUTTERWORTH,  // butterworth high-pass
-    BANDPASS        // ideal band-pass
+    BANDPASS,       // ideal band-pass
+    NOTCH           // bank of band-stop filters
 };
 
 /**
@@ -51,6 +53,16 @@ public:
      */
     virtual ~FilterDialog();
 
+    /**
+     * @brief applyFilter applies a filter to the magnitude signal without the dialog, e.g. when exporting plots
+     * @param type type of the filter; the notch filter bank is configured only in the dialog and is not supported
+     * @param spectrum the magnitude signal
+     * @param omega0 cut-off frequency, the lower threshold of the band-pass filter
+     * @param second the upper threshold of the band-pass filter or the order of the butterworth filters, otherwise unused
+     * @return false, if @a type is not supported
+     */
+    static bool applyFilter(FilterType type, Signal& spectrum, double omega0, double second = 0);
+
 private:
 
 // attributes
@@ -82,6 +94,25 @@ private:
 
     QSpinBox* spinBox;
 
+    // controls of the notch filter bank, created only for NOTCH
+    QLabel* notchLabel;
+    QComboBox* notchComboBox;
+    QPushButton* addNotchButton;
+    QPushButton* removeNotchButton;
+    QLabel* positionLabel;
+    QDoubleSpinBox* positionSpinBox;
+    QLabel* widthLabel;
+    QDoubleSpinBox* widthSpinBox;
+    QComboBox* profileComboBox;
+    QLabel* harmonicsLabel;
+    QSpinBox* harmonicsSpinBox;
+    QPushButton* harmonicsButton;
+
+    NotchFilterBank notches;
+
+    // index of the notch being dragged in the plot, -1 if none
+    int draggedNotch;
+
     const Translation*& translation;
     Signal& magnitude;
 
@@ -125,6 +156,23 @@ private:
      */
     void initButterworthHighPass();
 
+    /**
+     * @brief initNotchBank sets up the window for use with the notch filter bank
+     */
+    void initNotchBank();
+
+    /**
+     * @brief selectNotch shows properties of notch @a index in the controls
+     * @param index index of the notch, -1 if there is none
+     */
+    void selectNotch(int index);
+
+    /**
+     * @brief updateNotchList refills the list of notches and selects notch @a selected
+     * @param selected index of the notch to select
+     */
+    void updateNotchList(int selected);
+
     /**
      * @brief ilpfGraph plots ideal low-pass filter funtion
      * @param omega0 threshold
@@ -170,50 +218,67 @@ private:
      */
     void bhpfGraph(double omega0, int n);
 
+    /**
+     * @brief notchGraph plots the gain of the notch filter bank and markers of the notch positions
+     */
+    void notchGraph();
+
     /**
      * @brief idealLowPassFilter applies ideal low-pass filter to the magnitude signal
+     * @param spectrum the magnitude signal
      * @param omega0
      */
-    void idealLowPassFilter(int omega0);
+    static void idealLowPassFilter(Signal& spectrum, int omega0);
 
     /**
      * @brief idealHighPassFilter applies ideal low-pass filter to the magnitude signal
+     * @param spectrum the magnitude signal
      * @param omega0
      */
-    void idealHighPassFilter(int omega0);
+    static void idealHighPassFilter(Signal& spectrum, int omega0);
 
     /**
      * @brief bandPassFilter applies ideal band-pass filter to the magnitude signal
+     * @param spectrum the magnitude signal
      * @param from lower threshold
      * @param to upper threshold
      */
-    void bandPassFilter(double from, double to);
+    static void bandPassFilter(Signal& spectrum, double from, double to);
 
     /**
      * @brief gaussianLowPassFilter applies gaussian low-pass filter to the magnitude signal
+     * @param spectrum the magnitude signal
      * @param omega0
      */
-    void gaussianLowPassFilter(double omega0);
+    static void gaussianLowPassFilter(Signal& spectrum, double omega0);
 
     /**
      * @brief gaussianHighPassFilter applies gaussian high-pass filter to the magnitude signal
+     * @param spectrum the magnitude signal
      * @param omega0
      */
-    void gaussianHighPassFilter(double omega0);
+    static void gaussianHighPassFilter(Signal& spectrum, double omega0);
 
     /**
      * @brief butterworthLowPassFilter applies butterworth low-pass filter to the magnitude signal
+     * @param spectrum the magnitude signal
      * @param omega0
      * @param n
      */
-    void butterworthLowPassFilter(double omega0, int n);
+    static void butterworthLowPassFilter(Signal& spectrum, double omega0, int n);
 
     /**
      * @brief butterworthHighPassFilter applies butterworth high-pass filter to the magnitude signal
+     * @param spectrum the magnitude signal
      * @param omega0
      * @param n
      */
-    void butterworthHighPassFilter(double omega0, int n);
+    static void butterworthHighPassFilter(Signal& spectrum, double omega0, int n);
+
+    /**
+     * @brief notchFilter applies the notch filter bank to the magnitude signal
+     */
+    void notchFilter();
 
     /**
      * @brief setDefaultTexts sets defaults values to each text or title or label in the window.
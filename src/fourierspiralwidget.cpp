@@ -1,7 +1,15 @@
 ﻿#include "fourierspiralwidget.h"
 #include "signal.h"
+#include "qcustomplot/qcustomplot.h"
 
 #include <QPainter>
+#include <QElapsedTimer>
+
+#include <cmath>
+#include <cstdlib>
+
+// number of points of the continuous basis function per period
+#define SPIRAL_POINTS_PER_PERIOD 15
 
 
 // COORDINATE SYSTEMS:
@@ -65,206 +73,316 @@ FourierSpiralWidget::FourierSpiralWidget(QWidget *parent) : QWidget(parent)
     signalLength = 0;
     modify = false;
     displayingEnabled = false;
+
+    staticSceneValid = false;
+    staticSceneLength = 0;
+    staticSceneMagnitude = 0;
+
+    tableFrequency = 0;
+    tableLength = 0;
+
+    overlayVisible = false;
+
+    setDefaultTexts();
+}
+
+namespace
+{
+/**
+ * @brief drawDiscs draws discs with a black outline. The disc is rendered once and copied to all the points.
+ * @param painter painter to use for drawing
+ * @param points centres of the discs
+ * @param fill colour of the discs
+ * @param radius radius of the discs, the outline is centred on it
+ */
+void drawDiscs(QCPPainter& painter, const QVector<QPointF>& points, const QColor& fill, qreal radius)
+{
+    painter.setPen(QPen(Qt::black, 1));
+    painter.setBrush(fill);
+    QCPScatterStyle(QCPScatterStyle::ssCircle, 2 * radius).drawShapes(&painter, points);
+    painter.setBrush(Qt::NoBrush);
 }
+}
+
 
 void FourierSpiralWidget::paintEvent(QPaintEvent * /* event */)
 {
-    QPainter painter(this);
+    QElapsedTimer timer;
+    if(overlayVisible)
+    {
+        timer.start();
+    }
 
-    // draw white colour to the background
-    painter.fillRect(0,0,this->width(), this->height(),Qt::white);
+    updateStaticScene();
 
-    drawBackground(painter);
-    drawAxes(painter);
-    drawTexts(painter);
+    QCPPainter painter(this);
+    painter.drawPixmap(0, 0, staticScene);
+
+    if(displayingEnabled)
+    {
+        paintBasisFunction(painter);
+    }
 
+    if(overlayVisible)
+    {
+        const double frameTime = timer.nsecsElapsed() * 1e-6;
+        overlay.addFrame(frameTime, frameTime - overlay.stageTime(STAGE_TRANSFORM) - overlay.stageTime(STAGE_UPLOAD));
+        overlay.draw(painter, rect());
+    }
+}
+
+
+void FourierSpiralWidget::paintBasisFunction(QCPPainter& painter)
+{
     float magScale = 1;
     float phaseShift = 0;
 
     if(modify)
     {
-        const float mag_max = (fabs(maxMagnitude) < 2.0f ||  !modify)? 2.0f : ceil(fabs(maxMagnitude));
+        const float mag_max = magnitudeAxisMax();
 
         magScale = magnitude * 2.0f / mag_max;
         phaseShift = phase;
     }
 
     const float x_step = (max_x - min_x) / (signalLength + 1);
+    const int length = static_cast<int>(signalLength);
 
-    if(displayingEnabled)
+    // x coordinates of the samples
+    QVector<float> sampleX(length);
+    float* sx = sampleX.data();
+    for(int i = 0; i < length; i++)
     {
-        if(frequency == 0)
-        {
-            painter.setPen((Qt::black));
-            painter.setBrush(QColor::fromRgb(0xFF,0xCC,0x00));
+        sx[i] = min_x + (i + 1) * x_step;
+    }
 
-            painter.drawEllipse((projection * QVector4D(min_x, 0.0, -1.0f * magScale ,1.0)).toPointF(),2,2);
+    QVector<QPointF> points;
 
+    if(frequency == 0)
+    {
+        const float z = -1.0f * magScale;
 
-            // projection
+        painter.setPen((Qt::black));
+        painter.setBrush(QColor::fromRgb(0xFF,0xCC,0x00));
 
-            painter.setPen(QPen(QColor::fromRgb(0x33,0x99,0x00),2));
-            painter.drawLine((projection * QVector4D(min_x + x_step, min_y - 0.5, -1.0f * magScale ,1.0)).toPointF(),
-                             (projection * QVector4D(max_x - x_step, min_y - 0.5, -1.0f * magScale ,1.0)).toPointF());
+        painter.drawEllipse((projection * QVector4D(min_x, 0.0, z ,1.0)).toPointF(),2,2);
 
 
-            painter.setPen((Qt::black));
-            painter.setBrush(QColor::fromRgb(0xFF,0xCC,0x00));
+        // projection
 
-            for(size_t i = 0; i < signalLength; i++)
-            {
-                painter.drawEllipse((projection * QVector4D(min_x + (i + 1)*x_step, min_y - 0.5, -1.0f * magScale, 1.0)).toPointF(), 2.5, 2.5);
-            }
+        painter.setPen(QPen(QColor::fromRgb(0x33,0x99,0x00),2));
+        painter.drawLine((projection * QVector4D(min_x + x_step, min_y - 0.5, z ,1.0)).toPointF(),
+                         (projection * QVector4D(max_x - x_step, min_y - 0.5, z ,1.0)).toPointF());
 
-            // projection
-            painter.setPen(QPen(QColor::fromRgb(0xFF,0x33,0x00),2));
+        project(sampleX, QVector<float>(length, min_y - 0.5f), QVector<float>(length, z), points);
+        drawDiscs(painter, points, QColor::fromRgb(0xFF,0xCC,0x00), 2.5);
 
-            painter.drawLine((projection * QVector4D(min_x + x_step, 0.0f,  min_z - 0.5f, 1.0)).toPointF(),
-                             (projection * QVector4D(max_x - x_step, 0.0f,  min_z - 0.5f, 1.0)).toPointF());
+        // projection
+        painter.setPen(QPen(QColor::fromRgb(0xFF,0x33,0x00),2));
 
-            painter.setPen((Qt::black));
-            painter.setBrush(QColor::fromRgb(0x00,0x33,0xFF));
+        painter.drawLine((projection * QVector4D(min_x + x_step, 0.0f,  min_z - 0.5f, 1.0)).toPointF(),
+                         (projection * QVector4D(max_x - x_step, 0.0f,  min_z - 0.5f, 1.0)).toPointF());
 
-            for(size_t i = 0; i < signalLength; i++)
-            {
-                painter.drawEllipse((projection * QVector4D(min_x + (i + 1)*x_step, 0.0f,  min_z - 0.5f, 1.0f)).toPointF(), 2.5, 2.5);
-            }
+        project(sampleX, QVector<float>(length, 0.0f), QVector<float>(length, min_z - 0.5f), points);
+        drawDiscs(painter, points, QColor::fromRgb(0x00,0x33,0xFF), 2.5);
 
-            // basis function
-            painter.setPen(QPen(QColor::fromRgb(0xCC,0,0xCC),3));
+        // basis function
+        painter.setPen(QPen(QColor::fromRgb(0xCC,0,0xCC),3));
 
-            painter.drawLine((projection * QVector4D(min_x + x_step, 0.0f, -1.0f * magScale, 1.0)).toPointF(),
-                             (projection * QVector4D(max_x - x_step, 0.0f, -1.0f * magScale, 1.0)).toPointF());
+        painter.drawLine((projection * QVector4D(min_x + x_step, 0.0f, z, 1.0)).toPointF(),
+                         (projection * QVector4D(max_x - x_step, 0.0f, z, 1.0)).toPointF());
 
-            painter.setPen((Qt::black));
-            painter.setBrush(Qt::yellow);
+        project(sampleX, QVector<float>(length, 0.0f), QVector<float>(length, z), points);
+        drawDiscs(painter, points, Qt::yellow, 2.5);
+        return;
+    }
 
-            for(size_t i = 0; i < signalLength; i++)
-            {
-                painter.drawEllipse((projection * QVector4D(min_x + (i + 1)*x_step, 0.0f, -1.0f * magScale, 1.0f)).toPointF(), 2.5, 2.5);
-            }
+    // computing the points of the basis function
+    StageTimer transform(overlay.stageTarget(STAGE_TRANSFORM));
 
-        }
-        else
-        {
-            const float xLength = (max_x - min_x) - x_step;
-            const float numberPointsPerPeriod = 15;
+    updateBasisTables();
 
-            size_t numberPointsTotal = fabs(frequency) * numberPointsPerPeriod;
-            float spacing = xLength / numberPointsTotal;
+    const int curveCount = curveSin.size();
+    const float xLength = (max_x - min_x) - x_step;
+    const float spacing = xLength / (curveCount - 1);
 
-            QVector<float> y;   // continuous
-            QVector<float> z;
+    // sin(t + phase) and -cos(t + phase), scaled by the magnitude, from the tables of sin(t) and cos(t)
+    const float rotSin = std::sin(phaseShift) * magScale;
+    const float rotCos = std::cos(phaseShift) * magScale;
 
-            QVector<float> dy;  // discrete points
-            QVector<float> dz;
+    QVector<float> curveX(curveCount);   // continuous
+    QVector<float> y(curveCount);
+    QVector<float> z(curveCount);
+    float* cx = curveX.data();
+    float* cy = y.data();
+    float* cz = z.data();
+    const float* cs = curveSin.constData();
+    const float* cc = curveCos.constData();
 
-            y.reserve(numberPointsTotal + 1);
-            z.reserve(numberPointsTotal + 1);
+    for(int i = 0; i < curveCount; i++)
+    {
+        cx[i] = min_x + x_step + spacing * i;
+        cy[i] = cs[i] * rotCos + cc[i] * rotSin;
+        cz[i] = cs[i] * rotSin - cc[i] * rotCos;
+    }
 
-            for(size_t i = 0; i <= numberPointsTotal; i++)
-            {
-                float newY = sinf(frequency * 2.0*M_PI/ (numberPointsTotal) * i + phaseShift ) * magScale;
-                float newZ = -cosf(frequency * 2.0*M_PI/ (numberPointsTotal) * i + phaseShift ) * magScale;
-                y.push_back(newY);
-                z.push_back(newZ);
-            }
+    QVector<float> dy(length);  // discrete points
+    QVector<float> dz(length);
+    float* py = dy.data();
+    float* pz = dz.data();
+    const float* ss = sampleSin.constData();
+    const float* sc = sampleCos.constData();
 
-            for(size_t i = 0; i < signalLength; i++)
-            {
-                float newY = sinf(frequency * 2.0*M_PI/ (signalLength) * i + phaseShift ) * magScale;
-                float newZ = -cosf(frequency * 2.0*M_PI/ (signalLength) * i + phaseShift ) * magScale;
-                dy.push_back(newY);
-                dz.push_back(newZ);
-            }
+    for(int i = 0; i < length; i++)
+    {
+        py[i] = ss[i] * rotCos + sc[i] * rotSin;
+        pz[i] = ss[i] * rotSin - sc[i] * rotCos;
+    }
+    transform.stop();
 
-            QVector<QPointF> points;
 
+    // draw the circle to the background
+    float theta_base = 2.0f * M_PI / 20.0f;
 
-            // draw the circle to the background
-            float theta_base = 2.0f * M_PI / 20.0f;
+    for(size_t ii = 0; ii < 20; ii++)
+    {
+        points.push_back((projection * QVector4D(min_x, cosf(theta_base * ii) * magScale, sinf(theta_base * ii) * magScale, 1.0f)).toPointF());
+    }
 
-            for(size_t ii = 0; ii < 20; ii++)
-            {
-                points.push_back((projection * QVector4D(min_x, cosf(theta_base * ii) * magScale, sinf(theta_base * ii) * magScale, 1.0f)).toPointF());
-            }
+    painter.setPen(QPen(QColor::fromRgb(255,128,128),1.5));
+    painter.drawPolygon(&points[0],20);
 
-            painter.setPen(QPen(QColor::fromRgb(255,128,128),1.5));
-            painter.drawPolygon(&points[0],20);
+    // draw points there.
+    project(QVector<float>(length, min_x), dy, dz, points);
+    drawDiscs(painter, points, QColor::fromRgb(0xFF,0xCC,0x00), 2.0);
 
-            // draw points there.
-            painter.setPen((Qt::black));
-            painter.setBrush(QColor::fromRgb(0xFF,0xCC,0x00));
-            for(size_t i = 0; i < signalLength; i++)
-            {
-                painter.drawEllipse((projection * QVector4D(min_x, dy[i], dz[i], 1.0)).toPointF(), 2.0,2.0);
-            }
 
+    // first draw projection to the lower plane - real projection of the basis function
 
+    project(curveX, QVector<float>(curveCount, min_y - 0.5f), z, points);
+    painter.setPen(QPen(QColor::fromRgb(0x33,0x99,0x00),2));
+    painter.drawPolyline(points.constData(), points.size());
 
-            // first draw projection to the lower plane - real projection of the basis function
+    project(sampleX, QVector<float>(length, min_y - 0.5f), dz, points);
+    drawDiscs(painter, points, QColor::fromRgb(0xFF,0xCC,0x00), 2.5);
 
-            points.clear();
-            for(size_t i = 0; i <= numberPointsTotal; i++)
-            {
-                points.push_back((projection * QVector4D(min_x + x_step + spacing * i, min_y - 0.5, z[i], 1)).toPointF());
-            }
-            painter.setPen(QPen(QColor::fromRgb(0x33,0x99,0x00),2));
-            painter.drawPolyline(&points[0],numberPointsTotal + 1);
 
+    // second, draw projection to the further plane - imaginary projection of the basis function
 
-            painter.setPen((Qt::black));
-            painter.setBrush(QColor::fromRgb(0xFF,0xCC,0x00));
+    project(curveX, y, QVector<float>(curveCount, -2.5f), points);
+    painter.setPen(QPen(QColor::fromRgb(0xFF,0x33,0x00),2));
+    painter.drawPolyline(points.constData(), points.size());
 
-            for(size_t i = 0; i < signalLength; i++)
-            {
-                painter.drawEllipse((projection * QVector4D(min_x + (i + 1)*x_step, min_y - 0.5, dz[i], 1.0)).toPointF(), 2.5,2.5);
-            }
+    project(sampleX, dy, QVector<float>(length, min_z - 0.5f), points);
+    drawDiscs(painter, points, QColor::fromRgb(0x00,0x33,0xFF), 2.5);
 
 
-            // second, draw projection to the further plane - imaginary projection of the basis function
+    // last, draw the basis funtion to the space.
 
-            points.clear();
+    project(curveX, y, z, points);
+    painter.setPen(QPen(QColor::fromRgb(0xCC,0,0xCC),3));
+    painter.drawPolyline(points.constData(), points.size());
 
-            for(size_t i = 0; i <= numberPointsTotal; i++)
-            {
-                points.push_back((projection * QVector4D(min_x + x_step + spacing * i, y[i], -2.5, 1)).toPointF());
-            }
-            painter.setPen(QPen(QColor::fromRgb(0xFF,0x33,0x00),2));
-            painter.drawPolyline(&points[0],numberPointsTotal + 1);
+    project(sampleX, dy, dz, points);
+    drawDiscs(painter, points, Qt::yellow, 3);
+}
 
-            painter.setPen((Qt::black));
-            painter.setBrush(QColor::fromRgb(0x00,0x33,0xFF));
 
-            for(size_t i = 0; i < signalLength; i++)
-            {
-                painter.drawEllipse((projection * QVector4D(min_x + (i + 1)*x_step, dy[i], min_z - 0.5f, 1.0)).toPointF(), 2.5,2.5);
-            }
+void FourierSpiralWidget::updateBasisTables()
+{
+    if(tableFrequency == frequency && tableLength == signalLength && !curveSin.isEmpty())
+    {
+        return;
+    }
 
-            // last, draw the basis funtion to the space.
+    const int curveCount = std::abs(frequency) * SPIRAL_POINTS_PER_PERIOD + 1;
+    curveSin.resize(curveCount);
+    curveCos.resize(curveCount);
+    for(int i = 0; i < curveCount; i++)
+    {
+        const double t = frequency * 2.0 * M_PI / (curveCount - 1) * i;
+        curveSin[i] = std::sin(t);
+        curveCos[i] = std::cos(t);
+    }
 
-            points.clear();
+    const int length = static_cast<int>(signalLength);
+    sampleSin.resize(length);
+    sampleCos.resize(length);
+    for(int i = 0; i < length; i++)
+    {
+        const double t = frequency * 2.0 * M_PI / length * i;
+        sampleSin[i] = std::sin(t);
+        sampleCos[i] = std::cos(t);
+    }
 
-            for(size_t i = 0; i <= numberPointsTotal; i++)
-            {
-                points.push_back((projection * QVector4D(min_x + x_step + spacing * i, y[i], z[i], 1)).toPointF());
-            }
+    tableFrequency = frequency;
+    tableLength = signalLength;
+}
 
 
-            painter.setPen(QPen(QColor::fromRgb(0xCC,0,0xCC),3));
-            painter.drawPolyline(&points[0],numberPointsTotal + 1);
+void FourierSpiralWidget::project(const QVector<float>& x, const QVector<float>& y, const QVector<float>& z, QVector<QPointF>& points) const
+{
+    StageTimer upload(overlay.stageTarget(STAGE_UPLOAD));
 
-            painter.setPen((Qt::black));
-            painter.setBrush(Qt::yellow);
+    // the projection is affine and the widget coordinates are given by its first two rows (stored column by column)
+    const float* m = projection.constData();
+    const float ax = m[0], ay = m[4], az = m[8], at = m[12];
+    const float bx = m[1], by = m[5], bz = m[9], bt = m[13];
 
-            const float x_step = (max_x - min_x) / (signalLength + 1);
+    const int count = x.size();
+    const float* px = x.constData();
+    const float* py = y.constData();
+    const float* pz = z.constData();
 
-            for(size_t i = 0; i < signalLength; i++)
-            {
-                painter.drawEllipse((projection * QVector4D(min_x + (i + 1)*x_step, dy[i], dz[i], 1.0f)).toPointF(), 3,3);
-            }
-        }
+    points.resize(count);
+    QPointF* out = points.data();
+    for(int i = 0; i < count; i++)
+    {
+        out[i] = QPointF(ax * px[i] + ay * py[i] + az * pz[i] + at,
+                         bx * px[i] + by * py[i] + bz * pz[i] + bt);
+    }
+}
+
+
+void FourierSpiralWidget::resizeEvent(QResizeEvent* event)
+{
+    staticSceneValid = false;
+    QWidget::resizeEvent(event);
+}
+
+
+float FourierSpiralWidget::magnitudeAxisMax() const
+{
+    return (fabs(maxMagnitude) < 2.0f ||  !modify)? 2.0f : ceil(fabs(maxMagnitude));
+}
+
+
+void FourierSpiralWidget::updateStaticScene()
+{
+    const qreal ratio = devicePixelRatioF();
+    const float magMax = magnitudeAxisMax();
+
+    if(staticSceneValid && staticScene.devicePixelRatio() == ratio
+            && staticSceneLength == signalLength && staticSceneMagnitude == magMax)
+    {
+        return;
     }
+
+    // in physical pixels, so that the scene is sharp on high density screens
+    staticScene = QPixmap(size() * ratio);
+    staticScene.setDevicePixelRatio(ratio);
+
+    // draw white colour to the background
+    staticScene.fill(Qt::white);
+
+    QPainter painter(&staticScene);
+    drawBackground(painter);
+    drawAxes(painter);
+    drawTexts(painter);
+
+    staticSceneValid = true;
+    staticSceneLength = signalLength;
+    staticSceneMagnitude = magMax;
 }
 
 
@@ -322,7 +440,7 @@ void FourierSpiralWidget::drawBackground(QPainter& painter)
     // Ugly thing: because setting the projection and viewport correctly is somehow difficult
     // To reflect the length of the signal, use the interpolation within the set interval
 
-    const float mag_max = (fabs(maxMagnitude) < 2.0f ||  !modify)? 2.0f : ceil(fabs(maxMagnitude));
+    const float mag_max = magnitudeAxisMax();
     const float mag_min = -mag_max;
 
     const float x_step = (max_x - min_x) / (signalLength + 1);
@@ -540,13 +658,46 @@ void FourierSpiralWidget::drawTexts(QPainter& painter)
 {
     painter.save();
     painter.setPen(QColor("black"));
-    painter.drawText(1, 13, "Imag");
-    painter.drawText(52, 250, "T");
-    painter.drawText(435, 268, "Real");
+    painter.drawText(1, 13, imagText);
+    painter.drawText(52, 250, timeText);
+    painter.drawText(435, 268, realText);
     painter.restore();
 }
 
 
+void FourierSpiralWidget::setDefaultTexts()
+{
+    imagText = QStringLiteral("Imag");
+    timeText = QStringLiteral("T");
+    realText = QStringLiteral("Real");
+
+    staticSceneValid = false;
+    update();
+}
+
+
+void FourierSpiralWidget::setLocalizedTexts(const Translation* language)
+{
+    if(!language)
+    {
+        setDefaultTexts();
+        return;
+    }
+
+    imagText = language->getChildElementText(QStringLiteral("imagLabel"));
+    if(imagText.isEmpty()) imagText = QStringLiteral("Imag");
+
+    timeText = language->getChildElementText(QStringLiteral("timeLabel"));
+    if(timeText.isEmpty()) timeText = QStringLiteral("T");
+
+    realText = language->getChildElementText(QStringLiteral("realLabel"));
+    if(realText.isEmpty()) realText = QStringLiteral("Real");
+
+    staticSceneValid = false;
+    update();
+}
+
+
 void FourierSpiralWidget::displayFrequency(double frequency, double magnitudeVal, double phaseVal, double maxMagnitudeVal, int signal_length)
 {
     this->frequency = frequency;
@@ -590,3 +741,11 @@ void FourierSpiralWidget::setMagnitudeAndPhase(double mag, double pha)
 
     if(modify) repaint();
 }
+
+
+void FourierSpiralWidget::setOverlayVisible(bool visible)
+{
+    overlayVisible = visible;
+    overlay = PlotOverlay();
+    update();
+}
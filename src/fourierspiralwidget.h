@@ -8,7 +8,13 @@
 
 #include <QWidget>
 #include <QMatrix4x4>
+#include <QPixmap>
+#include <QVector>
 
+#include "localization.h"
+#include "plotoverlay.h"
+
+class QCPPainter;
 
 namespace FT1D
 {
@@ -59,14 +65,71 @@ public:
      */
     void newSignal(int length);
 
+    /**
+     * @brief setDefaultTexts sets defaults values to the names of the axes.
+     */
+    void setDefaultTexts();
+
+    /**
+     * @brief setLocalizedTexts sets the names of the axes according to given Translation object
+     * @param language Translation object used to set texts
+     */
+    void setLocalizedTexts(const Translation* language);
+
+    /**
+     * @brief setOverlayVisible shows or hides the overlay with the frame time and the times of computing the basis function,
+     * projecting it and drawing it. Nothing is measured while it is hidden.
+     * @param visible
+     */
+    void setOverlayVisible(bool visible);
+
 protected:
 
     /**
-     * The main painting callback
+     * The main painting callback. The static scene is drawn from the cached pixmap, only the basis function is drawn again.
      */
     void paintEvent(QPaintEvent *event) Q_DECL_OVERRIDE;
 
+    /**
+     * @brief resizeEvent invalidates the cached static scene
+     * @param event
+     */
+    void resizeEvent(QResizeEvent *event) Q_DECL_OVERRIDE;
+
 private:
+    /**
+     * @brief magnitudeAxisMax
+     * @return the largest magnitude on the axes
+     */
+    float magnitudeAxisMax() const;
+
+    /**
+     * @brief updateStaticScene redraws background, axes and texts to the cached pixmap,
+     * if it was invalidated or the scale of the axes or the device pixel ratio changed
+     */
+    void updateStaticScene();
+
+    /**
+     * @brief paintBasisFunction draws the basis function and its projections over the static scene
+     * @param painter painter to use for drawing
+     */
+    void paintBasisFunction(QCPPainter& painter);
+
+    /**
+     * @brief updateBasisTables computes sin and cos of the basis function without phase, in the points of the continuous
+     * curve and in the samples, if the frequency or the signal length changed. Phase and magnitude are applied when painting.
+     */
+    void updateBasisTables();
+
+    /**
+     * @brief project transforms points of the space to widget coordinates, all at once
+     * @param x x coordinates
+     * @param y y coordinates
+     * @param z z coordinates
+     * @param points output, the points in the widget
+     */
+    void project(const QVector<float>& x, const QVector<float>& y, const QVector<float>& z, QVector<QPointF>& points) const;
+
     /**
      * @brief drawAxes draws x, y, z axes
      * @param painter painter to use for drawing
@@ -102,6 +165,29 @@ private:
     bool displayingEnabled;
     bool modify;
 
+    // names of the axes
+    QString imagText;
+    QString timeText;
+    QString realText;
+
+    // background, axes and texts; drawn again only when they change, not on every hover over the magnitude plot
+    QPixmap staticScene;
+    bool staticSceneValid;
+    size_t staticSceneLength;
+    float staticSceneMagnitude;
+
+    // sin and cos of the basis function for tableFrequency and tableLength: in the points of the curve and in the samples
+    int tableFrequency;
+    size_t tableLength;
+    QVector<float> curveSin;
+    QVector<float> curveCos;
+    QVector<float> sampleSin;
+    QVector<float> sampleCos;
+
+    // timings of the frames, recorded only while the overlay is visible; the projection is timed too, which is const
+    mutable PlotOverlay overlay;
+    bool overlayVisible;
+
 
     // ugly, should be rewritten
     // boundaries I originally accounted with when designing the projection.
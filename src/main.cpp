@@ -4,15 +4,95 @@
  **/
 
 #include "mainwindow.h"
+#include "signaltextparser.h"
+#include "displaysignalwidget.h"
+#include "plotexporter.h"
 #include <QApplication>
+#include <QThread>
+
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
 
 /**
  * Application entry point. Creates the MainWindow and runs it.
+ * With --benchmark-parser FILE [REPETITIONS], measures throughput of the text signal parser instead.
+ * With --benchmark-plot [FRAMES], measures drawing of a plot with and without its buffered layers.
+ * With --benchmark-markers [COUNT], measures painting of scatter markers with and without the sprite cache.
+ * With --export-plots INPUT_DIR OUTPUT_DIR [--pdf] [--threads N] [FILTER...], saves the plots of all signals in INPUT_DIR
+ * for each filter setting (see PlotExporter::parseFilter, unfiltered if none is given) without showing a window.
  */
 
 int main(int argc, char *argv[])
 {
+    if(argc >= 3 && std::strcmp(argv[1], "--benchmark-parser") == 0)
+    {
+        const int repetitions = argc >= 4 ? std::max(1, std::atoi(argv[3])) : 10;
+        return FT1D::SignalTextParser::benchmark(argv[2], repetitions) < 0 ? 1 : 0;
+    }
+
+    const bool exportPlots = argc >= 4 && std::strcmp(argv[1], "--export-plots") == 0;
+    if(exportPlots && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        // the plots are drawn offscreen, no display is needed
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
     QApplication a(argc, argv);
+
+    if(exportPlots)
+    {
+        bool pdf = false;
+        int threads = QThread::idealThreadCount();
+        QVector<FT1D::PlotExportFilter> filters;
+
+        for(int i = 4; i < argc; i++)
+        {
+            FT1D::PlotExportFilter filter;
+            if(std::strcmp(argv[i], "--pdf") == 0)
+            {
+                pdf = true;
+            }
+            else if(std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            {
+                threads = std::max(1, std::atoi(argv[++i]));
+            }
+            else if(FT1D::PlotExporter::parseFilter(QString::fromLocal8Bit(argv[i]), filter))
+            {
+                filters.append(filter);
+            }
+            else
+            {
+                std::cout << argv[i] << ": unknown filter" << std::endl;
+                return 1;
+            }
+        }
+
+        if(filters.isEmpty())
+        {
+            FT1D::PlotExportFilter filter;
+            FT1D::PlotExporter::parseFilter(QStringLiteral("none"), filter);
+            filters.append(filter);
+        }
+
+        const double throughput = FT1D::PlotExporter::exportDirectory(QString::fromLocal8Bit(argv[2]), QString::fromLocal8Bit(argv[3]),
+                                                                      filters, pdf, threads);
+        return throughput < 0 ? 1 : 0;
+    }
+
+    if(argc >= 2 && std::strcmp(argv[1], "--benchmark-plot") == 0)
+    {
+        FT1D::DisplaySignalWidget::benchmark(argc >= 3 ? std::max(1, std::atoi(argv[2])) : 100);
+        return 0;
+    }
+
+    if(argc >= 2 && std::strcmp(argv[1], "--benchmark-markers") == 0)
+    {
+        FT1D::DisplaySignalWidget::benchmarkMarkers(argc >= 3 ? std::max(1, std::atoi(argv[2])) : 100000);
+        return 0;
+    }
+
     FT1D::MainWindow w;
     w.show();
 
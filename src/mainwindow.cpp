@@ -4,14 +4,23 @@
 #include "helpdialog.h"
 #include "predefinedsignalsdialog.h"
 #include "filterdialog.h"
+#include "binarysignalfile.h"
+#include "audioimportdialog.h"
 
+#include <QFileInfo>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+
+// the longest delay of the spectrogram and the interpolated spectrum behind the filtered signal, in milliseconds
+#define DERIVED_VIEWS_INTERVAL 100
 
 using namespace FT1D;
 
 MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
 {
+    pagedSignal = nullptr;
+
     // SETTINGS
 
     settings = new QSettings(QApplication::applicationDirPath() + QStringLiteral("/config.ini"),QSettings::IniFormat);
@@ -62,6 +71,10 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
 
     magPhaseTabWidget->addTab(phaseGraph, QString());
 
+    spectrogramGraph = new SpectrogramWidget(centralWidget);
+
+    magPhaseTabWidget->addTab(spectrogramGraph, QString());
+
     centeringCheckBox = new QCheckBox(centralWidget);
     centeringCheckBox->setGeometry(QRect(385, 0, 100, 22));
     centeringCheckBox->setMinimumSize(QSize(100, 22));
@@ -72,7 +85,7 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
 
     connect(magPhaseTabWidget, &QTabWidget::currentChanged, this, [=](int current)
     {
-        if(current != 0) enableFilters(false);
+        if(current != 0 || follower->isFollowing()) enableFilters(false);
         else if(!magnitude.empty()) enableFilters(true);
     });
 
@@ -80,7 +93,7 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
     phaseGraph->enableCentering(true);
 
     frequencySpectrumLabel = new QLabel(centralWidget);
-    frequencySpectrumLabel->setGeometry(QRect(200, 0, 185, 22));
+    frequencySpectrumLabel->setGeometry(QRect(260, 0, 125, 22));
 
     fourierSpiral = new FourierSpiralWidget(centralWidget);
     fourierSpiral->setGeometry(510,30,470,270);
@@ -101,6 +114,10 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
     originalSignalLabel = new QLabel(centralWidget);
     originalSignalLabel->setGeometry(QRect(200, 310, 185, 22));
 
+    channelComboBox = new QComboBox(centralWidget);
+    channelComboBox->setGeometry(QRect(10, 310, 180, 22));
+    channelComboBox->setVisible(false);
+
     originalSignalGraph = new DisplaySignalWidget(ORIGINAL, true, centralWidget);
     originalSignalGraph->setGeometry(QRect(10, 340, 480, 300));
 
@@ -122,6 +139,25 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
     statusBarMessage->setAlignment(Qt::AlignRight);
     statusBar->addWidget(statusBarMessage, 1);
 
+    exportProgressBar = new QProgressBar(statusBar);
+    exportProgressBar->setRange(0, 100);
+    exportProgressBar->setMaximumWidth(150);
+    exportProgressBar->setVisible(false);
+    statusBar->addPermanentWidget(exportProgressBar);
+
+    exportCancelButton = new QPushButton(statusBar);
+    exportCancelButton->setVisible(false);
+    statusBar->addPermanentWidget(exportCancelButton);
+
+    exporter = new SignalExporter(this);
+
+    follower = new SignalFollower(this);
+
+    derivedViewsTimer = new QTimer(this);
+    derivedViewsTimer->setSingleShot(true);
+    derivedViewsTimer->setInterval(DERIVED_VIEWS_INTERVAL);
+    spectrogramStale = false;
+
     mainToolBar = new QToolBar(this);
     mainToolBar->setMovable(false);
     addToolBar(Qt::TopToolBarArea, mainToolBar);
@@ -168,14 +204,135 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
     connect(actionOpen, &QAction::triggered, this, [=](bool)
     {
         QString chosenFile = QFileDialog::getOpenFileName(this, QStringLiteral("Open signal..."));
-        loadSignal(chosenFile.toStdString());
+        if(SessionFile::isSessionFile(chosenFile))
+        {
+            loadSession(chosenFile);
+        }
+        else
+        {
+            loadSignal(chosenFile.toStdString());
+        }
+    });
+
+    connect(actionOpenSession, &QAction::triggered, this, [=](bool)
+    {
+        QString chosenFile = QFileDialog::getOpenFileName(this, QStringLiteral("Open session..."), QString(), QStringLiteral("Session files (*.ft1s)"));
+        if(!chosenFile.isEmpty())
+        {
+            loadSession(chosenFile);
+        }
     });
 
+    connect(actionSaveSession, &QAction::triggered, this, &MainWindow::saveSession);
+
     connect(actionOpenPredefined, &QAction::triggered, this, &MainWindow::openPredefinedSignalsDialog);
 
-    connect(actionSave, &QAction::triggered, this, [=](bool){
-        QString chosenFile = QFileDialog::getSaveFileName(this, QStringLiteral("Save Filtered Signal..."));
-        filtered.save_file(chosenFile.toStdString());
+    connect(actionImportAudio, &QAction::triggered, this, &MainWindow::importAudio);
+
+    connect(actionImportCsv, &QAction::triggered, this, &MainWindow::importCsv);
+
+    connect(actionFollow, &QAction::triggered, this, [=](bool checked)
+    {
+        if(checked)
+        {
+            followFile();
+        }
+        else
+        {
+            stopFollowing();
+        }
+    });
+
+    connect(follower, &SignalFollower::samplesAppended, this, &MainWindow::followedSamplesAppended);
+
+    connect(follower, &SignalFollower::failed, this, [=](const QString& message)
+    {
+        stopFollowing();
+        statusBarMessage->setText(message);
+    });
+
+    connect(channelComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &MainWindow::selectBatchChannel);
+
+    connect(actionOpenLarge, &QAction::triggered, this, [=](bool)
+    {
+        QString chosenFile = QFileDialog::getOpenFileName(this, QStringLiteral("Open large signal..."), QString(), QStringLiteral("Binary signal files (*.ft1b)"));
+        if(!chosenFile.isEmpty())
+        {
+            loadPagedSignal(chosenFile);
+        }
+    });
+
+    connect(actionSave, &QAction::triggered, this, &MainWindow::saveFilteredSignal);
+
+    connect(actionExportSpectrum, &QAction::triggered, this, &MainWindow::exportSpectrum);
+
+    connect(exporter, &SignalExporter::progress, exportProgressBar, &QProgressBar::setValue);
+
+    connect(exporter, &SignalExporter::finished, this, [=](bool success, const QString& path, const QString& error)
+    {
+        exportProgressBar->setVisible(false);
+        exportCancelButton->setVisible(false);
+        if(!success)
+        {
+            statusBarMessage->setText(path + QStringLiteral(": ") + error);
+        }
+    });
+
+    connect(exportCancelButton, &QPushButton::clicked, this, [=]()
+    {
+        // removes the incomplete file, finished is not emitted
+        exporter->cancel();
+        exportProgressBar->setVisible(false);
+        exportCancelButton->setVisible(false);
+    });
+
+    connect(actionConvert, &QAction::triggered, this, [=](bool)
+    {
+        QString input = QFileDialog::getOpenFileName(this, QStringLiteral("Convert signal file..."));
+        if(input.isEmpty())
+        {
+            return;
+        }
+
+        // binary and compressed files are converted to text, text to binary (or compressed, if so named)
+        const bool binary = BinarySignalFile::isBinarySignalFile(input) || CompressedSignalFile::isCompressedSignalFile(input);
+        QString suggested = QFileInfo(input).path() + QStringLiteral("/") + QFileInfo(input).completeBaseName()
+                + (binary ? QStringLiteral(".ft1d") : QStringLiteral(".ft1b"));
+
+        QString output = QFileDialog::getSaveFileName(this, QStringLiteral("Save converted signal..."), suggested);
+        if(output.isEmpty())
+        {
+            return;
+        }
+
+        if(!Signal::convert_file(input.toStdString(), output.toStdString()))
+        {
+            statusBarMessage->setText(QStringLiteral("Conversion of ") + input + QStringLiteral(" failed."));
+        }
+    });
+
+    connect(actionVerify, &QAction::triggered, this, [=](bool)
+    {
+        QString path = QFileDialog::getOpenFileName(this, QStringLiteral("Verify signal file..."));
+        if(path.isEmpty())
+        {
+            return;
+        }
+
+        // opening checks only the header, the checksum of the samples is compared on request
+        BinarySignalFile file;
+        if(!file.open(path))
+        {
+            statusBarMessage->setText(path + QStringLiteral(": not a valid binary signal file"));
+        }
+        else if(!file.verify())
+        {
+            statusBarMessage->setText(path + QStringLiteral(": checksum does not match, the file is damaged"));
+        }
+        else
+        {
+            statusBarMessage->setText(path + QStringLiteral(": checksum is correct"));
+        }
     });
 
     connect(centeringCheckBox,&QCheckBox::toggled,magnitudeGraph,&DisplaySignalWidget::enableCentering);
@@ -189,17 +346,27 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
     connect(magnitudeGraph,&DisplaySignalWidget::needFrequencyUpdate,this,[=](int x, int y)
     {
         double f = (x <= magnitude.original_length() - x ? x : -(magnitude.original_length() - x));
-        fourierSpiral->displayFrequency(f,y, phase.original[x],  magnitude.max_y(), phase.original_length());
+        fourierSpiral->displayFrequency(f,y, phase.original.value(x),  magnitude.max_y(), phase.original_length());
     });
 
     connect(phaseGraph,&DisplaySignalWidget::needFrequencyUpdate,this,[=](int x, int y)
     {
         double f = (x <= phase.original_length() - x ? x : -(phase.original_length() - x));
-        fourierSpiral->displayFrequency(f,magnitude.original[x],y, magnitude.max_y(), magnitude.original_length());
+        fourierSpiral->displayFrequency(f,magnitude.original.value(x),y, magnitude.max_y(), magnitude.original_length());
     });
 
     connect(magnitudeGraph,&DisplaySignalWidget::needUpdateFiltered, this, &MainWindow::updateFilteredSignalPlot);
     connect(phaseGraph,&DisplaySignalWidget::needUpdateFiltered, this, &MainWindow::updateFilteredSignalPlot);
+    connect(magnitudeGraph,&DisplaySignalWidget::interpolationFactorChanged, this, &MainWindow::updateInterpolatedSpectrum);
+    connect(derivedViewsTimer, &QTimer::timeout, this, &MainWindow::updateDerivedViews);
+    connect(magPhaseTabWidget, &QTabWidget::currentChanged, this, [=]()
+    {
+        if(spectrogramStale && magPhaseTabWidget->currentWidget() == spectrogramGraph)
+        {
+            spectrogramStale = false;
+            spectrogramGraph->setSignal(filtered);
+        }
+    });
     connect(editModeGraph,&DisplaySignalWidget::editModeNeedUpdate, this, &MainWindow::needUpdateMagPhaseFiltered);
 
     connect(magnitudeGraph, &DisplaySignalWidget::callForSaveState, this, &MainWindow::recordCurrentState);
@@ -208,12 +375,12 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
 
     connect(editModeGraph, &DisplaySignalWidget::displayValueStatusBar, this, [=](int x, int index)
     {
-        statusBarMessage->setText(QStringLiteral("(") + QString::number(x,'f',6) + QStringLiteral("; ")  + QString::number(*(editSignal.original.begin() + index),'f',6) + QStringLiteral(")"));
+        statusBarMessage->setText(QStringLiteral("(") + QString::number(x,'f',6) + QStringLiteral("; ")  + QString::number(*(editSignal.original.constBegin() + index),'f',6) + QStringLiteral(")"));
     });
 
     connect(originalSignalGraph, &DisplaySignalWidget::displayValueStatusBar, this, [=](int x, int index)
     {
-        statusBarMessage->setText(QStringLiteral("(") + QString::number(x,'f',6) + QStringLiteral("; ")  + QString::number(*(original.original.begin() + index),'f',6) + QStringLiteral(")"));
+        statusBarMessage->setText(QStringLiteral("(") + QString::number(x,'f',6) + QStringLiteral("; ")  + QString::number(*(original.original.constBegin() + index),'f',6) + QStringLiteral(")"));
 
     });
 
@@ -224,7 +391,7 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
     connect(filteredGraph, &DisplaySignalWidget::displayValueStatusBar, this, [=](int x, int index)
     {
         statusBarMessage->setText(QStringLiteral("(") + QString::number(x) + QStringLiteral("; ")
-                                  + QString::number(*(filtered.original.begin() + index),'f',6) + QStringLiteral(")"));
+                                  + QString::number(*(filtered.original.constBegin() + index),'f',6) + QStringLiteral(")"));
 
     });
 
@@ -272,14 +439,38 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
         filteredGraph->setAutoScaling(checked);
     });
 
+    connect(actionRasterizeAll, &QAction::triggered, this, [=](bool checked)
+    {
+        magnitudeGraph->setRasterized(checked);
+        phaseGraph->setRasterized(checked);
+        originalSignalGraph->setRasterized(checked);
+        filteredGraph->setRasterized(checked);
+        editModeGraph->setRasterized(checked);
+    });
+
+    connect(actionOverlayAll, &QAction::triggered, this, [=](bool checked)
+    {
+        PlotOverlay::setEnabled(checked);
+        magnitudeGraph->setOverlayVisible(checked);
+        phaseGraph->setOverlayVisible(checked);
+        originalSignalGraph->setOverlayVisible(checked);
+        filteredGraph->setOverlayVisible(checked);
+        editModeGraph->setOverlayVisible(checked);
+        fourierSpiral->setOverlayVisible(checked);
+    });
+
     connectFilterAction(actionFilterIdealLowPass, ILPF);
     connectFilterAction(actionFilterIdealHighPass, IHPF);
     connectFilterAction(actionFilterBandPass, BANDPASS);
+    connectFilterAction(actionFilterNotch, NOTCH);
     connectFilterAction(actionFilterGaussianLowPass, LPGAUSS);
     connectFilterAction(actionFilterGaussianHighPass, HPGAUSS);
     connectFilterAction(actionFilterButterworthLowPass, LPBUTTERWORTH);
     connectFilterAction(actionFilterButterworthHighPass, HPBUTTERWORTH);
 
+    connect(actionConvolve, &QAction::triggered, this, [=](bool) { applyKernel(false); });
+    connect(actionCorrelate, &QAction::triggered, this, [=](bool) { applyKernel(true); });
+
     connect(actionUndo, &QAction::triggered,this,&MainWindow::undo);
     connect(actionRevertToOriginal, &QAction::triggered,this, &MainWindow::revertToOriginal);
 
@@ -299,6 +490,8 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
     filteredGraph->setInteractionsEnabled(false);
     originalSignalGraph->setInteractionsEnabled(false);
     actionSave->setEnabled(false);
+    actionExportSpectrum->setEnabled(false);
+    actionSaveSession->setEnabled(false);
     actionUndo->setEnabled(false);
     actionRevertToOriginal->setEnabled(false);
     actionDefaultScale->setEnabled(false);
@@ -328,13 +521,33 @@ void MainWindow::createMenu()
     actionNew = new QAction(menuFile);
     actionOpen = new QAction(menuFile);
     actionOpenPredefined = new QAction(menuFile);
+    actionOpenLarge = new QAction(menuFile);
+    actionImportAudio = new QAction(menuFile);
+    actionImportCsv = new QAction(menuFile);
+    actionFollow = new QAction(menuFile);
+    actionFollow->setCheckable(true);
     actionSave = new QAction(menuFile);
+    actionExportSpectrum = new QAction(menuFile);
     actionExit = new QAction(menuFile);
+    actionConvert = new QAction(menuFile);
+    actionVerify = new QAction(menuFile);
+    actionOpenSession = new QAction(menuFile);
+    actionSaveSession = new QAction(menuFile);
 
     menuFile->addAction(actionNew);
     menuFile->addAction(actionOpen);
     menuFile->addAction(actionOpenPredefined);
+    menuFile->addAction(actionOpenLarge);
+    menuFile->addAction(actionImportAudio);
+    menuFile->addAction(actionImportCsv);
+    menuFile->addAction(actionFollow);
     menuFile->addAction(actionSave);
+    menuFile->addAction(actionExportSpectrum);
+    menuFile->addAction(actionConvert);
+    menuFile->addAction(actionVerify);
+    menuFile->addSeparator();
+    menuFile->addAction(actionOpenSession);
+    menuFile->addAction(actionSaveSession);
     menuFile->addSeparator();
     menuFile->addAction(actionExit);
 
@@ -347,18 +560,25 @@ void MainWindow::createMenu()
     actionFilterIdealLowPass = new QAction(menuFilters);
     actionFilterIdealHighPass = new QAction(menuFilters);
     actionFilterBandPass = new QAction(menuFilters);
+    actionFilterNotch = new QAction(menuFilters);
     actionFilterGaussianLowPass = new QAction(menuFilters);
     actionFilterGaussianHighPass = new QAction(menuFilters);
     actionFilterButterworthLowPass = new QAction(menuFilters);
     actionFilterButterworthHighPass = new QAction(menuFilters);
+    actionConvolve = new QAction(menuFilters);
+    actionCorrelate = new QAction(menuFilters);
 
     menuFilters->addAction(actionFilterIdealLowPass);
     menuFilters->addAction(actionFilterIdealHighPass);
     menuFilters->addAction(actionFilterBandPass);
+    menuFilters->addAction(actionFilterNotch);
     menuFilters->addAction(actionFilterGaussianLowPass);
     menuFilters->addAction(actionFilterGaussianHighPass);
     menuFilters->addAction(actionFilterButterworthLowPass);
     menuFilters->addAction(actionFilterButterworthHighPass);
+    menuFilters->addSeparator();
+    menuFilters->addAction(actionConvolve);
+    menuFilters->addAction(actionCorrelate);
 
     actionDefaultScale = new QAction(menuView);
     actionDisplayLinesAll = new QAction(menuView);
@@ -367,10 +587,19 @@ void MainWindow::createMenu()
     actionAutoScalingAll = new QAction(menuView);
     actionAutoScalingAll->setCheckable(true);
     actionAutoScalingAll->setChecked(true);
+    actionRasterizeAll = new QAction(menuView);
+    actionRasterizeAll->setCheckable(true);
+    actionRasterizeAll->setChecked(false);
+    actionOverlayAll = new QAction(menuView);
+    actionOverlayAll->setCheckable(true);
+    actionOverlayAll->setChecked(false);
 
     menuView->addAction(actionDefaultScale);
     menuView->addAction(actionDisplayLinesAll);
     menuView->addAction(actionAutoScalingAll);
+    menuView->addSeparator();
+    menuView->addAction(actionRasterizeAll);
+    menuView->addAction(actionOverlayAll);
 
     actionViewHelp = new QAction(menuHelp);
     actionAbout = new QAction(menuHelp);
@@ -386,14 +615,23 @@ MainWindow::~MainWindow()
 {
     settings->sync();
 
+    // stops writing before the status bar widgets are deleted
+    delete exporter;
+    delete follower;
+    delete derivedViewsTimer;
+
     delete magnitudeGraph;
     delete phaseGraph;
 
     delete fourierSpiral;
+    delete spectrogramGraph;
 
     delete originalSignalGraph;
     delete filteredGraph;
 
+    // after the widgets, which display it
+    delete pagedSignal;
+
     delete line;
 
     delete magPhaseTabWidget;
@@ -404,6 +642,8 @@ MainWindow::~MainWindow()
     delete normalizedCheckBox;
 
     delete statusBarMessage;
+    delete exportProgressBar;
+    delete exportCancelButton;
     delete statusBar;
     delete mainToolBar;
 
@@ -412,8 +652,17 @@ MainWindow::~MainWindow()
     delete actionNew;
     delete actionOpen;
     delete actionOpenPredefined;
+    delete actionOpenLarge;
+    delete actionImportAudio;
+    delete actionImportCsv;
+    delete actionFollow;
     delete actionSave;
+    delete actionExportSpectrum;
     delete actionExit;
+    delete actionConvert;
+    delete actionVerify;
+    delete actionOpenSession;
+    delete actionSaveSession;
 
     delete actionUndo;
     delete actionRevertToOriginal;
@@ -421,14 +670,19 @@ MainWindow::~MainWindow()
     delete actionFilterIdealLowPass;
     delete actionFilterIdealHighPass;
     delete actionFilterBandPass;
+    delete actionFilterNotch;
     delete actionFilterGaussianLowPass;
     delete actionFilterGaussianHighPass;
     delete actionFilterButterworthLowPass;
     delete actionFilterButterworthHighPass;
+    delete actionConvolve;
+    delete actionCorrelate;
 
     delete actionDefaultScale;
     delete actionDisplayLinesAll;
     delete actionAutoScalingAll;
+    delete actionRasterizeAll;
+    delete actionOverlayAll;
 
     delete actionViewHelp;
     delete actionAbout;
@@ -470,32 +724,438 @@ void MainWindow::showHelpDialog()
 
 void MainWindow::loadSignal(std::string path)
 {
-    if(this->original.load_file(path))
+    std::string error;
+    if(!this->original.load_file(path, &error))
     {
-        original.fourierTransform(original,magnitude,phase);
+        statusBarMessage->setText(QString::fromStdString(path) + QStringLiteral(": ") + QString::fromStdString(error));
+    }
+    else
+    {
+        closeBatch();
+        closePagedSignal();
+        stopFollowing();
+        displayLoadedSignal();
+    }
+}
 
-        magnitudeGraph->displaySignal(&magnitude);
-        phaseGraph->displaySignal(&phase);
-        originalSignalGraph->displaySignal(&original);
 
-        filtered = original;
-        filteredGraph->displaySignal(&filtered);
+void MainWindow::importAudio()
+{
+    QString chosenFile = QFileDialog::getOpenFileName(this, QStringLiteral("Import audio..."), QString(),
+                                                      QStringLiteral("Audio files (*.wav *.raw *.pcm);;All files (*)"));
+    if(chosenFile.isEmpty())
+    {
+        return;
+    }
 
-        history.clear();
-        actionUndo->setEnabled(false);
+    Translation* tr = localization.getCurrentLanguage();
+    if(tr)
+    {
+        tr = tr->getTranslationForWindow(QStringLiteral("AudioImportDialog"));
+    }
 
-        enableFilters(true);
+    AudioImportDialog dialog(this, chosenFile, tr);
+    if(dialog.exec() == QDialog::Accepted)
+    {
+        if(original.load_audio(dialog.audio(), dialog.channel()))
+        {
+            closeBatch();
+            closePagedSignal();
+            stopFollowing();
+            displayLoadedSignal();
+        }
+        else
+        {
+            statusBarMessage->setText(chosenFile + QStringLiteral(": unsupported audio file"));
+        }
+    }
+    delete tr;
+}
+
+
+ExportFormat MainWindow::exportFormatOf(const QString& path)
+{
+    if(path.endsWith(QStringLiteral(".ft1b"), Qt::CaseInsensitive))
+    {
+        return EXPORT_BINARY;
+    }
+    if(path.endsWith(QStringLiteral(".ft1z"), Qt::CaseInsensitive))
+    {
+        return EXPORT_COMPRESSED;
+    }
+    return EXPORT_TEXT;
+}
+
+
+void MainWindow::saveFilteredSignal()
+{
+    QString chosenFile = QFileDialog::getSaveFileName(this, QStringLiteral("Save Filtered Signal..."));
+    if(chosenFile.isEmpty())
+    {
+        return;
+    }
+
+    const ExportFormat format = exportFormatOf(chosenFile);
+    exportStarted(exporter->exportSignal(chosenFile, format, filtered));
+}
+
+
+void MainWindow::exportSpectrum()
+{
+    const QString magnitudeFilter = QStringLiteral("Magnitudes (*.ft1d *.ft1b *.ft1z)");
+    const QString phaseFilter = QStringLiteral("Phases (*.ft1d *.ft1b *.ft1z)");
+    const QString complexFilter = QStringLiteral("Complex coefficients (*.ft1d *.ft1b)");
+
+    QString selectedFilter = magnitudeFilter;
+    QString chosenFile = QFileDialog::getSaveFileName(this, QStringLiteral("Export spectrum..."), QString(),
+                                                      magnitudeFilter + QStringLiteral(";;") + phaseFilter + QStringLiteral(";;") + complexFilter,
+                                                      &selectedFilter);
+    if(chosenFile.isEmpty())
+    {
+        return;
+    }
+
+    ExportContent content = EXPORT_MAGNITUDE;
+    if(selectedFilter == phaseFilter)
+    {
+        content = EXPORT_PHASE;
+    }
+    else if(selectedFilter == complexFilter)
+    {
+        content = EXPORT_COMPLEX;
+    }
+
+    const ExportFormat format = exportFormatOf(chosenFile);
+    exportStarted(exporter->exportSpectrum(chosenFile, format, content, magnitude, phase));
+}
+
+
+void MainWindow::exportStarted(bool started)
+{
+    if(!started)
+    {
+        statusBarMessage->setText(QStringLiteral("Another file is being written, try again when it is finished."));
+        return;
+    }
+
+    exportProgressBar->setValue(0);
+    exportProgressBar->setVisible(true);
+    exportCancelButton->setVisible(true);
+}
+
+
+void MainWindow::importCsv()
+{
+    QString chosenFile = QFileDialog::getOpenFileName(this, QStringLiteral("Import CSV..."), QString(),
+                                                      QStringLiteral("CSV files (*.csv *.tsv *.txt);;All files (*)"));
+    if(chosenFile.isEmpty())
+    {
+        return;
+    }
+
+    std::string error;
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const bool loaded = batch.load_csv(chosenFile.toStdString(), &error);
+    QApplication::restoreOverrideCursor();
+
+    if(!loaded)
+    {
+        statusBarMessage->setText(chosenFile + QStringLiteral(": ") + QString::fromStdString(error));
+        return;
+    }
+
+    closePagedSignal();
+    stopFollowing();
+
+    // filling the selector does not switch the channels, the first one is displayed below
+    channelComboBox->blockSignals(true);
+    channelComboBox->clear();
+    for(int c = 0; c < batch.channelCount(); c++)
+    {
+        channelComboBox->addItem(batch.channelName(c));
+    }
+    channelComboBox->setCurrentIndex(0);
+    channelComboBox->blockSignals(false);
+    channelComboBox->setVisible(batch.channelCount() > 1);
+
+    selectBatchChannel(0);
+}
+
+
+void MainWindow::selectBatchChannel(int channel)
+{
+    if(channel < 0 || channel >= batch.channelCount())
+    {
+        return;
+    }
+
+    original = batch.signal(channel);
+    batch.spectrum(channel, magnitude, phase);
+    displayLoadedSignal(false);
+}
+
+
+void MainWindow::closeBatch()
+{
+    batch.clear();
+    channelComboBox->blockSignals(true);
+    channelComboBox->clear();
+    channelComboBox->blockSignals(false);
+    channelComboBox->setVisible(false);
+}
+
+
+void MainWindow::closePagedSignal()
+{
+    if(pagedSignal == nullptr)
+    {
+        return;
+    }
+
+    // the widgets stop using the paged signal before it is deleted, the loaded signal is displayed by the caller
+    originalSignalGraph->displaySignal(nullptr);
+    spectrogramGraph->setSignal(Signal());
+
+    delete pagedSignal;
+    pagedSignal = nullptr;
+}
+
+
+void MainWindow::followFile()
+{
+    QString chosenFile = QFileDialog::getOpenFileName(this, QStringLiteral("Follow growing file..."), QString(),
+                                                      QStringLiteral("Signal files (*.ft1d *.txt);;All files (*)"));
+    if(chosenFile.isEmpty())
+    {
+        actionFollow->setChecked(false);
+        return;
+    }
+
+    QVector<double> x, y;
+    SignalParseError error;
+    if(!follower->start(chosenFile, x, y, error))
+    {
+        actionFollow->setChecked(false);
+        statusBarMessage->setText(chosenFile + QStringLiteral(": ") + QString::fromStdString(error.toString()));
+        return;
+    }
+
+    // the samples are appended at the end, so they have to be ordered
+    if(!std::is_sorted(x.constBegin(), x.constEnd()) || std::adjacent_find(x.constBegin(), x.constEnd()) != x.constEnd())
+    {
+        follower->stop();
+        actionFollow->setChecked(false);
+        statusBarMessage->setText(chosenFile + QStringLiteral(": the x coordinates are not increasing"));
+        return;
+    }
+
+    closeBatch();
+    closePagedSignal();
+    original.set_samples(x.constData(), y.constData(), x.size());
+    originalSignalGraph->displaySignal(&original);
+
+    emptyHistoryStacks();
+    enableSignalActions();
+
+    // filters and edits of the spectrum would be overwritten by the next update
+    enableFilters(false);
+    magnitudeGraph->setInteractionsEnabled(false);
+    phaseGraph->setInteractionsEnabled(false);
+
+    displayFollowedWindow();
+    statusBarMessage->setText(QStringLiteral("Following ") + chosenFile);
+}
+
+
+void MainWindow::stopFollowing()
+{
+    // the follower stops by itself on errors, the action is unchecked by the user before this is called
+    if(!follower->isFollowing() && !actionFollow->isChecked())
+    {
+        return;
+    }
+
+    if(follower->isFollowing())
+    {
+        follower->stop();
+        statusBarMessage->clear();
+    }
+    actionFollow->setChecked(false);
+
+    if(!magnitude.empty())
+    {
         magnitudeGraph->setInteractionsEnabled(true);
         phaseGraph->setInteractionsEnabled(true);
-        filteredGraph->setInteractionsEnabled(true);
-        originalSignalGraph->setInteractionsEnabled(true);
-        actionSave->setEnabled(true);
-        actionRevertToOriginal->setEnabled(true);
-        actionDefaultScale->setEnabled(true);
-        actionDisplayLinesAll->setEnabled(true);
-        actionAutoScalingAll->setEnabled(true);
+    }
+
+    if(magPhaseTabWidget->currentIndex() == 0 && !magnitude.empty())
+    {
+        enableFilters(true);
+    }
+}
+
+
+void MainWindow::followedSamplesAppended(const QVector<double>& x, const QVector<double>& y)
+{
+    if(!original.append_samples(x.constData(), y.constData(), x.size()))
+    {
+        const QString path = follower->path();
+        stopFollowing();
+        statusBarMessage->setText(path + QStringLiteral(": the appended x coordinates do not follow the signal"));
+        return;
+    }
+
+    originalSignalGraph->appendSamples(y);
+    displayFollowedWindow();
+}
+
+
+void MainWindow::displayFollowedWindow()
+{
+    // the cost does not depend on the length of the file
+    filtered = original.trailing(FOLLOW_SPECTRUM_WINDOW);
+    {
+        StageTimer transform(PlotOverlay::transformTarget());
+        Signal::fourierTransform(filtered, magnitude, phase);
+    }
+
+    magnitudeGraph->displaySignal(&magnitude);
+    phaseGraph->displaySignal(&phase);
+    filteredGraph->displaySignal(&filtered);
+    filteredSignalChanged();
+
+    fourierSpiral->newSignal(filtered.original_length());
+}
+
+
+void MainWindow::displayLoadedSignal(bool computeTransform)
+{
+    if(computeTransform)
+    {
+        StageTimer transform(PlotOverlay::transformTarget());
+        original.fourierTransform(original,magnitude,phase);
+    }
+
+    magnitudeGraph->displaySignal(&magnitude);
+    phaseGraph->displaySignal(&phase);
+    originalSignalGraph->displaySignal(&original);
+
+    filtered = original;
+    filteredGraph->displaySignal(&filtered);
+    filteredSignalChanged();
+
+    history.clear();
+    actionUndo->setEnabled(false);
+
+    enableSignalActions();
+
+    fourierSpiral->newSignal(original.original_length());
+}
+
+
+void MainWindow::enableSignalActions()
+{
+    enableFilters(true);
+    magnitudeGraph->setInteractionsEnabled(true);
+    phaseGraph->setInteractionsEnabled(true);
+    filteredGraph->setInteractionsEnabled(true);
+    originalSignalGraph->setInteractionsEnabled(true);
+    actionSave->setEnabled(true);
+    actionExportSpectrum->setEnabled(true);
+    actionSaveSession->setEnabled(true);
+    actionRevertToOriginal->setEnabled(true);
+    actionDefaultScale->setEnabled(true);
+    actionDisplayLinesAll->setEnabled(true);
+    actionAutoScalingAll->setEnabled(true);
+}
+
+
+void MainWindow::saveSession()
+{
+    QString chosenFile = QFileDialog::getSaveFileName(this, QStringLiteral("Save session..."), QString(), QStringLiteral("Session files (*.ft1s)"));
+    if(chosenFile.isEmpty())
+    {
+        return;
+    }
+
+    SessionState state;
+    state.original = original;
+    state.magnitude = magnitude;
+    state.phase = phase;
+    state.filtered = filtered;
+
+    // the bottom of the stack is the oldest step
+    for(const QPair<Signal*, Signal*>& step : history)
+    {
+        state.history.push_back(QPair<Signal, Signal>(*step.first, *step.second));
+    }
+
+    for(DisplaySignalWidget* graph : {magnitudeGraph, phaseGraph, originalSignalGraph, filteredGraph})
+    {
+        QCPRange x, y;
+        graph->viewRange(x, y);
+        state.viewRanges << x.lower << x.upper << y.lower << y.upper;
+    }
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const bool saved = SessionFile::write(chosenFile, state);
+    QApplication::restoreOverrideCursor();
+
+    if(!saved)
+    {
+        statusBarMessage->setText(chosenFile + QStringLiteral(": the session could not be saved"));
+    }
+}
+
+
+void MainWindow::loadSession(const QString& path)
+{
+    SessionState state;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const bool loaded = SessionFile::read(path, state);
+    QApplication::restoreOverrideCursor();
+
+    if(!loaded)
+    {
+        statusBarMessage->setText(path + QStringLiteral(": not a valid session file"));
+        return;
+    }
+
+    closeBatch();
+    closePagedSignal();
+    stopFollowing();
+
+    original = state.original;
+    magnitude = state.magnitude;
+    phase = state.phase;
+    filtered = state.filtered;
+
+    emptyHistoryStacks();
+    for(const QPair<Signal, Signal>& step : state.history)
+    {
+        history.push(QPair<Signal*, Signal*>(new Signal(step.first), new Signal(step.second)));
+    }
+    actionUndo->setEnabled(!history.empty());
 
-        fourierSpiral->newSignal(original.original_length());
+    magnitudeGraph->displaySignal(&magnitude);
+    phaseGraph->displaySignal(&phase);
+    originalSignalGraph->displaySignal(&original);
+    filteredGraph->displaySignal(&filtered);
+    filteredSignalChanged();
+
+    enableSignalActions();
+    fourierSpiral->newSignal(original.original_length());
+
+    // after displaySignal, which scales the graphs to the default
+    const QVector<DisplaySignalWidget*> graphs = {magnitudeGraph, phaseGraph, originalSignalGraph, filteredGraph};
+    if(state.viewRanges.size() == 4 * graphs.size())
+    {
+        for(int i = 0; i < graphs.size(); i++)
+        {
+            const double* range = state.viewRanges.constData() + 4 * i;
+            graphs[i]->setViewRange(QCPRange(range[0], range[1]), QCPRange(range[2], range[3]));
+        }
     }
 }
 
@@ -513,6 +1173,14 @@ void MainWindow::openPredefinedSignalsDialog()
     {
         loadSignal(filename.toStdString());
     });
+    connect(&dialog,&PredefinedSignalsDialog::signalGenerated,[=](GeneratorParameters parameters)
+    {
+        SignalGenerator::generate(parameters, original);
+        closeBatch();
+        closePagedSignal();
+        stopFollowing();
+        displayLoadedSignal();
+    });
     dialog.exec();
     delete tr;
 }
@@ -542,8 +1210,17 @@ void MainWindow::setDefaultTexts()
     actionNew->setText(QStringLiteral("New"));
     actionOpen->setText(QStringLiteral("Open"));
     actionOpenPredefined->setText(QStringLiteral("Open predefined signal"));
+    actionOpenLarge->setText(QStringLiteral("Open large signal..."));
+    actionImportAudio->setText(QStringLiteral("Import audio..."));
+    actionImportCsv->setText(QStringLiteral("Import CSV..."));
+    actionFollow->setText(QStringLiteral("Follow growing file..."));
     actionSave->setText(QStringLiteral("Save"));
+    actionExportSpectrum->setText(QStringLiteral("Export spectrum..."));
     actionExit->setText(QStringLiteral("Exit"));
+    actionConvert->setText(QStringLiteral("Convert signal file..."));
+    actionVerify->setText(QStringLiteral("Verify signal file..."));
+    actionOpenSession->setText(QStringLiteral("Open session..."));
+    actionSaveSession->setText(QStringLiteral("Save session..."));
 
     menuEdit->setTitle(QStringLiteral("Edit"));
 
@@ -555,16 +1232,21 @@ void MainWindow::setDefaultTexts()
     actionFilterIdealLowPass->setText(QStringLiteral("Ideal low-pass"));
     actionFilterIdealHighPass->setText(QStringLiteral("Ideal high-pass"));
     actionFilterBandPass->setText(QStringLiteral("Band-pass"));
+    actionFilterNotch->setText(QStringLiteral("Notch filter bank"));
     actionFilterGaussianLowPass->setText(QStringLiteral("Gaussian low-pass"));
     actionFilterGaussianHighPass->setText(QStringLiteral("Gaussian high-pass"));
     actionFilterButterworthLowPass->setText(QStringLiteral("Butterworth low-pass"));
     actionFilterButterworthHighPass->setText(QStringLiteral("Butterworth high-pass"));
+    actionConvolve->setText(QStringLiteral("Convolve with signal..."));
+    actionCorrelate->setText(QStringLiteral("Correlate with signal..."));
 
     menuView->setTitle(QStringLiteral("View"));
 
     actionDefaultScale->setText(QStringLiteral("Default scale"));
     actionDisplayLinesAll->setText(QStringLiteral("Display with lines"));
     actionAutoScalingAll->setText(QStringLiteral("Allow autoscaling"));
+    actionRasterizeAll->setText(QStringLiteral("Draw plots in background"));
+    actionOverlayAll->setText(QStringLiteral("Show frame timings"));
 
     menuLanguage->setTitle(QStringLiteral("Language"));
 
@@ -575,6 +1257,7 @@ void MainWindow::setDefaultTexts()
 
     magPhaseTabWidget->setTabText(0, QStringLiteral("Magnitude"));
     magPhaseTabWidget->setTabText(1, QStringLiteral("Phase"));
+    magPhaseTabWidget->setTabText(2, QStringLiteral("Spectrogram"));
 
     frequencySpectrumLabel->setText(QStringLiteral("Frequency spectrum"));
     centeringCheckBox->setText(QStringLiteral("Centering"));
@@ -583,12 +1266,15 @@ void MainWindow::setDefaultTexts()
     normalizedCheckBox->setText(QStringLiteral("Normalized"));
 
     originalSignalLabel->setText(QStringLiteral("Original signal"));
+    exportCancelButton->setText(QStringLiteral("Cancel export"));
     filteredSignalLabel->setText(QStringLiteral("Filtered signal"));
 
     magnitudeGraph->setDefaultTexts();
     phaseGraph->setDefaultTexts();
+    spectrogramGraph->setDefaultTexts();
     originalSignalGraph->setDefaultTexts();
     filteredGraph->setDefaultTexts();
+    fourierSpiral->setDefaultTexts();
 
     editModeFinishButton->setText(QStringLiteral("Finish editing"));
     editModeCancelButton->setText(QStringLiteral("Cancel"));
@@ -646,10 +1332,30 @@ void MainWindow::setLocalizedTexts(const Translation* language)
     if(actionOpen->text().isEmpty()) actionOpen->setText(QStringLiteral("Open"));
     actionOpenPredefined->setText(menuFileLanguage->getChildElementText(QStringLiteral("actionOpenPredefined")));
     if(actionOpenPredefined->text().isEmpty()) actionOpenPredefined->setText(QStringLiteral("Open predefined signal"));
+    actionOpenLarge->setText(menuFileLanguage->getChildElementText(QStringLiteral("actionOpenLarge")));
+    if(actionOpenLarge->text().isEmpty()) actionOpenLarge->setText(QStringLiteral("Open large signal..."));
+    actionImportAudio->setText(menuFileLanguage->getChildElementText(QStringLiteral("actionImportAudio")));
+    if(actionImportAudio->text().isEmpty()) actionImportAudio->setText(QStringLiteral("Import audio..."));
+
+    actionImportCsv->setText(menuFileLanguage->getChildElementText(QStringLiteral("actionImportCsv")));
+    if(actionImportCsv->text().isEmpty()) actionImportCsv->setText(QStringLiteral("Import CSV..."));
+    actionFollow->setText(menuFileLanguage->getChildElementText(QStringLiteral("actionFollow")));
+    if(actionFollow->text().isEmpty()) actionFollow->setText(QStringLiteral("Follow growing file..."));
     actionSave->setText(menuFileLanguage->getChildElementText(QStringLiteral("actionSave")));
     if(actionSave->text().isEmpty()) actionSave->setText(QStringLiteral("Save"));
+
+    actionExportSpectrum->setText(menuFileLanguage->getChildElementText(QStringLiteral("actionExportSpectrum")));
+    if(actionExportSpectrum->text().isEmpty()) actionExportSpectrum->setText(QStringLiteral("Export spectrum..."));
     actionExit->setText(menuFileLanguage->getChildElementText(QStringLiteral("actionExit")));
     if(actionExit->text().isEmpty()) actionExit->setText(QStringLiteral("Exit"));
+    actionConvert->setText(menuFileLanguage->getChildElementText(QStringLiteral("actionConvert")));
+    if(actionConvert->text().isEmpty()) actionConvert->setText(QStringLiteral("Convert signal file..."));
+    actionVerify->setText(menuFileLanguage->getChildElementText(QStringLiteral("actionVerify")));
+    if(actionVerify->text().isEmpty()) actionVerify->setText(QStringLiteral("Verify signal file..."));
+    actionOpenSession->setText(menuFileLanguage->getChildElementText(QStringLiteral("actionOpenSession")));
+    if(actionOpenSession->text().isEmpty()) actionOpenSession->setText(QStringLiteral("Open session..."));
+    actionSaveSession->setText(menuFileLanguage->getChildElementText(QStringLiteral("actionSaveSession")));
+    if(actionSaveSession->text().isEmpty()) actionSaveSession->setText(QStringLiteral("Save session..."));
 
     menuEdit->setTitle(menuEditLanguage->getTitle());
     if(menuEdit->title().isEmpty()) menuEdit->setTitle(QStringLiteral("Edit"));
@@ -671,6 +1377,8 @@ void MainWindow::setLocalizedTexts(const Translation* language)
 
     actionFilterBandPass->setText(menuFiltersLanguage->getChildElementText(QStringLiteral("actionFilterBandPass")));
     if(actionFilterBandPass->text().isEmpty()) actionFilterBandPass->setText(QStringLiteral("Band-pass"));
+    actionFilterNotch->setText(menuFiltersLanguage->getChildElementText(QStringLiteral("actionFilterNotch")));
+    if(actionFilterNotch->text().isEmpty()) actionFilterNotch->setText(QStringLiteral("Notch filter bank"));
 
     actionFilterGaussianLowPass->setText(menuFiltersLanguage->getChildElementText(QStringLiteral("actionFilterGaussianLowPass")));
     if(actionFilterGaussianLowPass->text().isEmpty()) actionFilterGaussianLowPass->setText(QStringLiteral("Gaussian low-pass"));
@@ -684,6 +1392,12 @@ void MainWindow::setLocalizedTexts(const Translation* language)
     actionFilterButterworthHighPass->setText(menuFiltersLanguage->getChildElementText(QStringLiteral("actionFilterButterworthHighPass")));
     if(actionFilterButterworthHighPass->text().isEmpty()) actionFilterButterworthHighPass->setText(QStringLiteral("Butterworth high-pass"));
 
+    actionConvolve->setText(menuFiltersLanguage->getChildElementText(QStringLiteral("actionConvolve")));
+    if(actionConvolve->text().isEmpty()) actionConvolve->setText(QStringLiteral("Convolve with signal..."));
+
+    actionCorrelate->setText(menuFiltersLanguage->getChildElementText(QStringLiteral("actionCorrelate")));
+    if(actionCorrelate->text().isEmpty()) actionCorrelate->setText(QStringLiteral("Correlate with signal..."));
+
 
     menuView->setTitle(menuViewLanguage->getTitle());
     if(menuView->title().isEmpty()) menuView->setTitle(QStringLiteral("View"));
@@ -697,6 +1411,11 @@ void MainWindow::setLocalizedTexts(const Translation* language)
     actionAutoScalingAll->setText(menuViewLanguage->getChildElementText(QStringLiteral("actionAutoScalingAll")));
     if(actionAutoScalingAll->text().isEmpty()) actionAutoScalingAll->setText(QStringLiteral("Allow autoscaling"));
 
+    actionRasterizeAll->setText(menuViewLanguage->getChildElementText(QStringLiteral("actionRasterizeAll")));
+    if(actionRasterizeAll->text().isEmpty()) actionRasterizeAll->setText(QStringLiteral("Draw plots in background"));
+    actionOverlayAll->setText(menuViewLanguage->getChildElementText(QStringLiteral("actionOverlayAll")));
+    if(actionOverlayAll->text().isEmpty()) actionOverlayAll->setText(QStringLiteral("Show frame timings"));
+
 
     menuLanguage->setTitle(menuLanguageLanguage->getTitle());
     if(menuLanguage->title().isEmpty()) menuLanguage->setTitle(QStringLiteral("Language"));
@@ -722,6 +1441,9 @@ void MainWindow::setLocalizedTexts(const Translation* language)
     magPhaseTabWidget->setTabText(1, magPhaseTabWidgetLanguage->getChildElementText(1));
     if(magPhaseTabWidget->tabText(1).isEmpty()) magPhaseTabWidget->setTabText(1, QStringLiteral("Phase"));
 
+    magPhaseTabWidget->setTabText(2, magPhaseTabWidgetLanguage->getChildElementText(2));
+    if(magPhaseTabWidget->tabText(2).isEmpty()) magPhaseTabWidget->setTabText(2, QStringLiteral("Spectrogram"));
+
     frequencySpectrumLabel->setText(language->getChildElementText(QStringLiteral("frequencySpectrumLabel")));
     if(frequencySpectrumLabel->text().isEmpty()) frequencySpectrumLabel->setText(QStringLiteral("Frequency spectrum"));
     centeringCheckBox->setText(language->getChildElementText(QStringLiteral("centeringCheckBox")));
@@ -741,6 +1463,9 @@ void MainWindow::setLocalizedTexts(const Translation* language)
     originalSignalLabel->setText(language->getChildElementText(QStringLiteral("originalSignalLabel")));
     if(originalSignalLabel->text().isEmpty()) originalSignalLabel->setText(QStringLiteral("Original signal"));
 
+    exportCancelButton->setText(language->getChildElementText(QStringLiteral("exportCancelButton")));
+    if(exportCancelButton->text().isEmpty()) exportCancelButton->setText(QStringLiteral("Cancel export"));
+
     filteredSignalLabel->setText(language->getChildElementText(QStringLiteral("filteredSignalLabel")));
     if(filteredSignalLabel->text().isEmpty()) filteredSignalLabel->setText(QStringLiteral("Filtered signal"));
 
@@ -755,10 +1480,14 @@ void MainWindow::setLocalizedTexts(const Translation* language)
     Translation* phaseGraphLanguage = language->getTranslationForElement(QStringLiteral("phaseGraph"));
     Translation* filteredGraphLanguage = language->getTranslationForElement(QStringLiteral("filteredGraph"));
     Translation* originalGraphLanguage = language->getTranslationForElement(QStringLiteral("originalGraph"));
+    Translation* spectrogramGraphLanguage = language->getTranslationForElement(QStringLiteral("spectrogramGraph"));
+    Translation* fourierSpiralLanguage = language->getTranslationForElement(QStringLiteral("fourierSpiral"));
     if(!magnitudeGraphLanguage) magnitudeGraphLanguage= new Translation();
     if(!phaseGraphLanguage) phaseGraphLanguage= new Translation();
     if(!filteredGraphLanguage) filteredGraphLanguage = new Translation();
     if(!originalGraphLanguage) originalGraphLanguage = new Translation();
+    if(!spectrogramGraphLanguage) spectrogramGraphLanguage = new Translation();
+    if(!fourierSpiralLanguage) fourierSpiralLanguage = new Translation();
 
 
 
@@ -767,6 +1496,8 @@ void MainWindow::setLocalizedTexts(const Translation* language)
     phaseGraph->setLocalizedTexts(phaseGraphLanguage);
     originalSignalGraph->setLocalizedTexts(originalGraphLanguage);
     filteredGraph->setLocalizedTexts(filteredGraphLanguage);
+    spectrogramGraph->setLocalizedTexts(spectrogramGraphLanguage);
+    fourierSpiral->setLocalizedTexts(fourierSpiralLanguage);
 
     delete menuBarLanguage;
 
@@ -784,22 +1515,31 @@ void MainWindow::setLocalizedTexts(const Translation* language)
     delete phaseGraphLanguage;
     delete originalGraphLanguage;
     delete filteredGraphLanguage;
+    delete spectrogramGraphLanguage;
+    delete fourierSpiralLanguage;
 }
 
 
 void MainWindow::updateFilteredSignalPlot()
 {
-    Signal::inverseFourierTransform(magnitude,phase,filtered,original.original.keys().toVector());
+    {
+        StageTimer transform(PlotOverlay::transformTarget());
+        Signal::inverseFourierTransform(magnitude,phase,filtered,original.original.keys().toVector());
+    }
 
     magnitudeGraph->plotReplot();
     phaseGraph->plotReplot();
     filteredGraph->displaySignal(&filtered);
+    filteredSignalChanged();
 }
 
 
 void MainWindow::resetAllGraphs(bool shadowPrevious)
 {
-    Signal::inverseFourierTransform(magnitude,phase,filtered,original.original.keys().toVector());
+    {
+        StageTimer transform(PlotOverlay::transformTarget());
+        Signal::inverseFourierTransform(magnitude,phase,filtered,original.original.keys().toVector());
+    }
     //Signal::fourierTransform(filtered,magnitude,phase);
 
     //magnitude.reset();
@@ -809,6 +1549,7 @@ void MainWindow::resetAllGraphs(bool shadowPrevious)
     magnitudeGraph->displaySignal(&magnitude, shadowPrevious);
     phaseGraph->displaySignal(&phase, shadowPrevious);
     filteredGraph->displaySignal(&filtered, shadowPrevious);
+    filteredSignalChanged();
 }
 
 
@@ -891,6 +1632,123 @@ void MainWindow::connectFilterAction(QAction* action, FilterType type)
 }
 
 
+void MainWindow::loadPagedSignal(const QString& path)
+{
+    PagedSignal* signal = new PagedSignal();
+
+    // builds the overview, reads the whole file once
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const bool opened = signal->open(path);
+    QApplication::restoreOverrideCursor();
+
+    if(!opened)
+    {
+        delete signal;
+        statusBarMessage->setText(path + QStringLiteral(": not a valid binary signal file"));
+        return;
+    }
+
+    closeBatch();
+    stopFollowing();
+
+    // a pending update would replace the paged spectrogram with the empty filtered signal
+    derivedViewsTimer->stop();
+    spectrogramStale = false;
+
+    // the widgets stop using the previous paged signal before it is deleted
+    originalSignalGraph->displayPagedSignal(signal);
+    spectrogramGraph->setPagedSignal(signal);
+    filteredGraph->displaySignal(nullptr);
+    magnitudeGraph->displaySignal(nullptr);
+    phaseGraph->displaySignal(nullptr);
+
+    delete pagedSignal;
+    pagedSignal = signal;
+
+    // nothing is kept in memory, the filters check for an empty spectrum
+    original = Signal();
+    filtered = Signal();
+    magnitude = Signal();
+    phase = Signal();
+
+    history.clear();
+    actionUndo->setEnabled(false);
+
+    enableFilters(false);
+    actionSave->setEnabled(false);
+    actionExportSpectrum->setEnabled(false);
+    actionSaveSession->setEnabled(false);
+    actionRevertToOriginal->setEnabled(false);
+    originalSignalGraph->setInteractionsEnabled(true);
+
+    magPhaseTabWidget->setCurrentWidget(spectrogramGraph);
+}
+
+
+void MainWindow::applyKernel(bool correlation)
+{
+    QString chosenFile = QFileDialog::getOpenFileName(this, QStringLiteral("Open kernel signal..."));
+    if(chosenFile.isEmpty())
+    {
+        return;
+    }
+
+    Signal kernel;
+    std::string error;
+    if(!kernel.load_file(chosenFile.toStdString(), &error))
+    {
+        statusBarMessage->setText(chosenFile + QStringLiteral(": ") + QString::fromStdString(error));
+        return;
+    }
+    if(kernel.empty())
+    {
+        return;
+    }
+
+    recordCurrentState();
+
+    filtered = correlation ? filtered.correlate(kernel) : filtered.convolve(kernel);
+    Signal::fourierTransform(filtered, magnitude, phase);
+
+    resetAllGraphs(true);
+}
+
+
+void MainWindow::filteredSignalChanged()
+{
+    // a drag changes the filtered signal on every step, the timer is not restarted so that the views follow it
+    if(!derivedViewsTimer->isActive())
+    {
+        derivedViewsTimer->start();
+    }
+}
+
+
+void MainWindow::updateDerivedViews()
+{
+    if(magPhaseTabWidget->currentWidget() == spectrogramGraph)
+    {
+        spectrogramStale = false;
+        spectrogramGraph->setSignal(filtered);
+    }
+    else
+    {
+        spectrogramStale = true;
+    }
+    updateInterpolatedSpectrum();
+}
+
+
+void MainWindow::updateInterpolatedSpectrum()
+{
+    const int factor = magnitudeGraph->interpolationFactor();
+    if(factor > 1)
+    {
+        magnitudeGraph->setInterpolatedSpectrum(Signal::interpolatedSpectrum(filtered, factor));
+    }
+}
+
+
 void MainWindow::needUpdateMagPhaseFiltered()
 {
     Signal::fourierTransform(editSignal,magnitude,phase);
@@ -903,6 +1761,7 @@ void MainWindow::needUpdateMagPhaseFiltered()
     magnitudeGraph->displaySignal(&magnitude);
     phaseGraph->displaySignal(&phase);
     filteredGraph->displaySignal(&filtered);
+    filteredSignalChanged();
 }
 
 
@@ -915,18 +1774,24 @@ void MainWindow::recordCurrentEditModeState()
 void MainWindow::enableFilters(bool val)
 {
     actionFilterBandPass->setEnabled(val);
+    actionFilterNotch->setEnabled(val);
     actionFilterButterworthHighPass->setEnabled(val);
     actionFilterButterworthLowPass->setEnabled(val);
     actionFilterGaussianHighPass->setEnabled(val);
     actionFilterGaussianLowPass->setEnabled(val);
     actionFilterIdealHighPass->setEnabled(val);
     actionFilterIdealLowPass->setEnabled(val);
+    actionConvolve->setEnabled(val);
+    actionCorrelate->setEnabled(val);
 }
 
 void MainWindow::newSignalCreated()
 {
     editSignal.findYMinMax();
     original = editSignal;
+    closeBatch();
+    closePagedSignal();
+    stopFollowing();
     originalSignalGraph->displaySignal(&original);
 
     editModeContainer->setVisible(false);
@@ -964,6 +1829,8 @@ void MainWindow::newSignalCreated()
     phaseGraph->displaySignal(&phase);
     // TODO - end of todo
 
+    filteredSignalChanged();
+
 
     actionNew->setEnabled(true);
     actionOpen->setEnabled(true);
@@ -982,6 +1849,7 @@ void MainWindow::newSignalCreated()
     {
         actionRevertToOriginal->setEnabled(true);
         actionSave->setEnabled(true);
+        actionExportSpectrum->setEnabled(true);
         actionDefaultScale->setEnabled(true);
         actionDisplayLinesAll->setEnabled(true);
         actionAutoScalingAll->setEnabled(true);
@@ -1041,6 +1909,7 @@ void MainWindow::newSignalDiscarded()
     {
         actionRevertToOriginal->setEnabled(true);
         actionSave->setEnabled(true);
+        actionExportSpectrum->setEnabled(true);
         actionDefaultScale->setEnabled(true);
         actionDisplayLinesAll->setEnabled(true);
         actionAutoScalingAll->setEnabled(true);
@@ -1056,6 +1925,7 @@ void MainWindow::newSignalDiscarded()
 
 void MainWindow::openEditMode(Signal& toEdit)
 {
+    stopFollowing();
     recordCurrentState();
 
     fourierSpiral->clearFrequency();
@@ -1068,6 +1938,8 @@ void MainWindow::openEditMode(Signal& toEdit)
     actionOpen->setEnabled(false);
     actionOpenPredefined->setEnabled(false);
     actionSave->setEnabled(false);
+    actionExportSpectrum->setEnabled(false);
+    actionSaveSession->setEnabled(false);
     actionRevertToOriginal->setEnabled(false);
     actionDefaultScale->setEnabled(false);
     actionDisplayLinesAll->setEnabled(false);
@@ -1091,14 +1963,23 @@ void MainWindow::openEditMode(Signal& toEdit)
 
 void MainWindow::showFrequencyInStatusBar(int x, int index)
 {
-    double mag = *(magnitude.original.begin() + index);
-    double pha = *(phase.original.begin() + index);
-    double cospha = cosf(*(phase.original.begin() + index));
-    double sinpha = sinf(*(phase.original.begin() + index));
+    // read through const iterators, so that the signals shared with the shadows in the plots are not detached
+    double mag = *(magnitude.original.constBegin() + index);
+    double pha = *(phase.original.constBegin() + index);
+    double cospha = cosf(pha);
+    double sinpha = sinf(pha);
     double real = cospha == 0 ? 0 : mag * cospha;
     double imag = sinpha == 0 ? 0 : mag * sinpha;
     std::stringstream ss;
     ss << "(ω, F(ω)) = (" << std::fixed << std::setprecision(3) << x << ", "  << real << std::showpos << imag << "i)";
+
+    // only x coordinates of imported audio are in seconds, other signals keep the bare index
+    const int length = magnitude.original_length();
+    if(length > 0 && original.sample_rate > 0)
+    {
+        const int bin = std::min(index, length - index);
+        ss << std::noshowpos << std::setprecision(2) << ", " << bin * original.sample_rate / length << " Hz";
+    }
     statusBarMessage->setText(QString::fromStdString(ss.str()));
 
     fourierSpiral->setMagnitudeAndPhase(mag,pha);
@@ -1113,6 +1994,7 @@ void MainWindow::revertToOriginal()
     magnitudeGraph->displaySignal(&magnitude);
     phaseGraph->displaySignal(&phase);
     filteredGraph->displaySignal(&original);
+    filteredSignalChanged();
 }
 
 void MainWindow::emptyHistoryStacks()
@@ -12,6 +12,13 @@
 #include "localization.h"
 #include "filterdialog.h"
 #include "fourierspiralwidget.h"
+#include "spectrogramwidget.h"
+#include "signalbatch.h"
+#include "signalexporter.h"
+#include "sessionfile.h"
+#include "signalfollower.h"
+
+#include <QTimer>
 
 namespace FT1D
 {
@@ -62,7 +69,16 @@ private:
     QAction* actionNew;
     QAction* actionOpen;
     QAction* actionOpenPredefined;
+    QAction* actionOpenLarge;
+    QAction* actionImportAudio;
+    QAction* actionImportCsv;
+    QAction* actionFollow;
     QAction* actionSave;
+    QAction* actionExportSpectrum;
+    QAction* actionConvert;
+    QAction* actionVerify;
+    QAction* actionOpenSession;
+    QAction* actionSaveSession;
     QAction* actionExit;
 
     QAction* actionUndo;
@@ -71,14 +87,19 @@ private:
     QAction* actionFilterIdealLowPass;
     QAction* actionFilterIdealHighPass;
     QAction* actionFilterBandPass;
+    QAction* actionFilterNotch;
     QAction* actionFilterGaussianLowPass;
     QAction* actionFilterGaussianHighPass;
     QAction* actionFilterButterworthLowPass;
     QAction* actionFilterButterworthHighPass;
+    QAction* actionConvolve;
+    QAction* actionCorrelate;
 
     QAction* actionDefaultScale;
     QAction* actionDisplayLinesAll;
     QAction* actionAutoScalingAll;
+    QAction* actionRasterizeAll;
+    QAction* actionOverlayAll;
 
     QAction* actionViewHelp;
     QAction* actionAbout;
@@ -93,6 +114,7 @@ private:
 
     DisplaySignalWidget* magnitudeGraph;
     DisplaySignalWidget* phaseGraph;
+    SpectrogramWidget* spectrogramGraph;
 
     FourierSpiralWidget* fourierSpiral;
 
@@ -117,6 +139,7 @@ private:
 
 
     QLabel* originalSignalLabel;
+    QComboBox* channelComboBox;
     QLabel* filteredSignalLabel;
 
     QStatusBar* statusBar;
@@ -124,6 +147,10 @@ private:
 
     QLabel* statusBarMessage;
 
+    // shown in the status bar while a file is being written
+    QProgressBar* exportProgressBar;
+    QPushButton* exportCancelButton;
+
     // signals
     Signal original;
     Signal magnitude;
@@ -133,6 +160,24 @@ private:
 
     Signal prevOriginal;
 
+    // out-of-core signal, displayed instead of the original signal after actionOpenLarge, otherwise null
+    PagedSignal* pagedSignal;
+
+    // channels of the imported CSV file, one of them is the original signal while channelComboBox is visible
+    SignalBatch batch;
+
+    // writes saved and exported files on a worker thread
+    SignalExporter* exporter;
+
+    // watches the file opened by actionFollow
+    SignalFollower* follower;
+
+    // delays the update of the views derived from the filtered signal, so that a drag updates them at most once per interval
+    QTimer* derivedViewsTimer;
+
+    // true, if the spectrogram was not updated for the current filtered signal, because its tab was hidden
+    bool spectrogramStale;
+
     QSettings* settings;
 
     Localizations localization;
@@ -174,6 +219,108 @@ private:
      */
     void loadSignal(std::string path);
 
+    /**
+     * @brief loadPagedSignal opens the binary signal file at @a path without loading it in memory. Only an overview,
+     * the samples of the zoomed-in range and the spectrogram are displayed; filters are disabled.
+     * @param path path to the binary signal file
+     */
+    void loadPagedSignal(const QString& path);
+
+    /**
+     * @brief importAudio lets the user choose a WAV or raw PCM file and its channel, and loads it as the original signal
+     */
+    void importAudio();
+
+    /**
+     * @brief importCsv lets the user choose a multi-column CSV file; its channels can be switched in channelComboBox
+     */
+    void importCsv();
+
+    /**
+     * @brief selectBatchChannel makes the channel @a channel of the imported CSV file the original signal
+     * @param channel index of the channel in the batch
+     */
+    void selectBatchChannel(int channel);
+
+    /**
+     * @brief closeBatch forgets the imported CSV file and hides the channel selector
+     */
+    void closeBatch();
+
+    /**
+     * @brief closePagedSignal releases the signal opened by actionOpenLarge, if any
+     */
+    void closePagedSignal();
+
+    /**
+     * @brief followFile lets the user choose a text signal file, which is displayed and followed while it grows
+     */
+    void followFile();
+
+    /**
+     * @brief stopFollowing stops following the file, the signal read so far stays loaded
+     */
+    void stopFollowing();
+
+    /**
+     * @brief followedSamplesAppended appends the samples to the original signal and updates the spectrum of the trailing window
+     * @param x x coordinates of the new samples
+     * @param y values of the new samples
+     */
+    void followedSamplesAppended(const QVector<double>& x, const QVector<double>& y);
+
+    /**
+     * @brief displayFollowedWindow computes and displays the spectrum of the last FOLLOW_SPECTRUM_WINDOW samples,
+     * which are displayed as the filtered signal
+     */
+    void displayFollowedWindow();
+
+    /**
+     * @brief saveSession asks for a file name and writes the signals, the spectrum, the undo history and the visible ranges to it
+     */
+    void saveSession();
+
+    /**
+     * @brief loadSession restores the state saved by saveSession; no transform is recomputed
+     * @param path path to the session file
+     */
+    void loadSession(const QString& path);
+
+    /**
+     * @brief enableSignalActions enables the actions and interactions available once a signal is displayed
+     */
+    void enableSignalActions();
+
+    /**
+     * @brief displayLoadedSignal computes the transform of the just loaded original signal and displays everything
+     * @param computeTransform false, if magnitude and phase already contain the transform of the original signal
+     */
+    void displayLoadedSignal(bool computeTransform = true);
+
+    /**
+     * @brief exportFormatOf chooses the format of a saved file by its extension
+     * @param path path to the file
+     * @return EXPORT_BINARY for .ft1b, EXPORT_COMPRESSED for .ft1z, EXPORT_TEXT otherwise
+     */
+    static ExportFormat exportFormatOf(const QString& path);
+
+    /**
+     * @brief saveFilteredSignal asks for a file name and starts writing the filtered signal to it in the background
+     */
+    void saveFilteredSignal();
+
+    /**
+     * @brief exportSpectrum asks for a file name and starts writing the magnitudes, the phases or the complex
+     * fourier coefficients to it in the background, depending on the chosen file type
+     */
+    void exportSpectrum();
+
+    /**
+     * @brief exportStarted shows the progress of the export in the status bar
+     * @param started false, if the export could not be started because another one is running
+     */
+    void exportStarted(bool started);
+
     /**
      * @brief updateFilteredSignalPlot updates the filtered graph
      */
@@ -192,6 +339,28 @@ private:
      */
     void connectFilterAction(QAction* action, FilterType type);
 
+    /**
+     * @brief applyKernel asks for a kernel signal file, convolves or correlates the filtered signal with it and updates the spectrum
+     * @param correlation true to compute the correlation, false for the convolution
+     */
+    void applyKernel(bool correlation);
+
+    /**
+     * @brief filteredSignalChanged schedules the update of the views derived from the filtered signal
+     */
+    void filteredSignalChanged();
+
+    /**
+     * @brief updateDerivedViews updates the views derived from the filtered signal, the interpolated spectrum
+     * and the spectrogram, if its tab is displayed
+     */
+    void updateDerivedViews();
+
+    /**
+     * @brief updateInterpolatedSpectrum recomputes the zero-padded spectrum of the filtered signal displayed in the magnitude graph
+     */
+    void updateInterpolatedSpectrum();
+
     /**
      * @brief needUpdateMagPhaseFiltered refreshes magnitude, phase and filtered graphs
      */
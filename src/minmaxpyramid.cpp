@@ -0,0 +1,155 @@
+/**
+ * @file minmaxpyramid.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "minmaxpyramid.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace FT1D;
+
+MinMaxPyramid::MinMaxPyramid()
+{
+    clear();
+}
+
+
+void MinMaxPyramid::clear()
+{
+    minima.clear();
+    maxima.clear();
+    samples = 0;
+    partialCount = 0;
+    partialMin = std::numeric_limits<double>::max();
+    partialMax = -std::numeric_limits<double>::max();
+    partialStored = false;
+}
+
+
+void MinMaxPyramid::append(const double* values, qint64 count)
+{
+    if(minima.isEmpty())
+    {
+        minima.resize(1);
+        maxima.resize(1);
+    }
+
+    QVector<float>& lows = minima[0];
+    QVector<float>& highs = maxima[0];
+
+    if(partialStored && count > 0)
+    {
+        lows.pop_back();
+        highs.pop_back();
+        partialStored = false;
+    }
+
+    for(qint64 i = 0; i < count; i++)
+    {
+        partialMin = std::min(partialMin, values[i]);
+        partialMax = std::max(partialMax, values[i]);
+
+        if(++partialCount == MINMAX_BASE_BLOCK)
+        {
+            lows.push_back(static_cast<float>(partialMin));
+            highs.push_back(static_cast<float>(partialMax));
+            partialCount = 0;
+            partialMin = std::numeric_limits<double>::max();
+            partialMax = -std::numeric_limits<double>::max();
+        }
+    }
+    samples += count;
+}
+
+
+void MinMaxPyramid::finish()
+{
+    if(samples == 0)
+    {
+        clear();
+        return;
+    }
+
+    // the incomplete block stays open, so that appending continues it
+    if(partialCount > 0 && !partialStored)
+    {
+        minima[0].push_back(static_cast<float>(partialMin));
+        maxima[0].push_back(static_cast<float>(partialMax));
+        partialStored = true;
+    }
+
+    // remove levels of a previous finish(), appending may have changed them
+    minima.resize(1);
+    maxima.resize(1);
+
+    while(minima.last().size() > 1)
+    {
+        const QVector<float>& lows = minima.last();
+        const QVector<float>& highs = maxima.last();
+        const int size = (lows.size() + 1) / 2;
+
+        QVector<float> coarseLows(size);
+        QVector<float> coarseHighs(size);
+        for(int i = 0; i < size; i++)
+        {
+            const int second = std::min(2 * i + 1, lows.size() - 1);
+            coarseLows[i] = std::min(lows[2 * i], lows[second]);
+            coarseHighs[i] = std::max(highs[2 * i], highs[second]);
+        }
+
+        minima.push_back(coarseLows);
+        maxima.push_back(coarseHighs);
+    }
+}
+
+
+double MinMaxPyramid::minimum() const
+{
+    return minima.isEmpty() || minima.last().isEmpty() ? 0 : minima.last().first();
+}
+
+
+double MinMaxPyramid::maximum() const
+{
+    return maxima.isEmpty() || maxima.last().isEmpty() ? 0 : maxima.last().first();
+}
+
+
+qint64 MinMaxPyramid::envelope(qint64 first, qint64 last, int maxPoints, QVector<double>& starts, QVector<double>& lows, QVector<double>& highs) const
+{
+    starts.clear();
+    lows.clear();
+    highs.clear();
+
+    if(minima.isEmpty() || samples == 0 || last < first)
+    {
+        return 0;
+    }
+
+    first = std::max<qint64>(first, 0);
+    last = std::min(last, samples - 1);
+
+    int level = 0;
+    while(level + 1 < levelCount() && (last / blockSize(level) - first / blockSize(level) + 1) > maxPoints)
+    {
+        level++;
+    }
+
+    const qint64 block = blockSize(level);
+    const int firstBlock = static_cast<int>(first / block);
+    const int lastBlock = static_cast<int>(std::min<qint64>(last / block, minima[level].size() - 1));
+
+    starts.reserve(lastBlock - firstBlock + 1);
+    lows.reserve(lastBlock - firstBlock + 1);
+    highs.reserve(lastBlock - firstBlock + 1);
+
+    for(int i = firstBlock; i <= lastBlock; i++)
+    {
+        starts.push_back(static_cast<double>(i * block));
+        lows.push_back(minima[level][i]);
+        highs.push_back(maxima[level][i]);
+    }
+    return block;
+}
@@ -0,0 +1,119 @@
+#ifndef MINMAXPYRAMID_H
+#define MINMAXPYRAMID_H
+
+/**
+ * @file minmaxpyramid.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of a multi-resolution min/max summary of a long signal.
+ */
+
+#include <QVector>
+
+namespace FT1D
+{
+
+// number of samples summarized by one block of the finest level
+#define MINMAX_BASE_BLOCK 1024
+
+/**
+ * @brief The MinMaxPyramid class keeps the minimum and the maximum of blocks of consecutive samples. Level 0 summarizes
+ * blocks of MINMAX_BASE_BLOCK samples, every next level merges pairs of blocks of the previous one, up to a single block.
+ * Samples are appended in a stream, so the pyramid of a signal larger than memory is built in one pass.
+ */
+class MinMaxPyramid
+{
+public:
+
+    /**
+     * @brief MinMaxPyramid constructor, creates an empty pyramid
+     */
+    MinMaxPyramid();
+
+    /**
+     * @brief clear removes all samples
+     */
+    void clear();
+
+    /**
+     * @brief append summarizes the next @a count samples. finish() must be called after the last samples,
+     * appending may continue after it.
+     * @param values samples
+     * @param count number of samples
+     */
+    void append(const double* values, qint64 count);
+
+    /**
+     * @brief finish summarizes the last incomplete block and builds the coarser levels
+     */
+    void finish();
+
+    /**
+     * @brief sampleCount
+     * @return number of samples appended
+     */
+    inline qint64 sampleCount() const
+    {
+        return samples;
+    }
+
+    /**
+     * @brief levelCount
+     * @return number of levels, 0 if the pyramid is empty
+     */
+    inline int levelCount() const
+    {
+        return minima.size();
+    }
+
+    /**
+     * @brief blockSize
+     * @param level
+     * @return number of samples summarized by one block of level @a level
+     */
+    inline qint64 blockSize(int level) const
+    {
+        return static_cast<qint64>(MINMAX_BASE_BLOCK) << level;
+    }
+
+    /**
+     * @brief minimum
+     * @return minimum of all samples, 0 if the pyramid is empty
+     */
+    double minimum() const;
+
+    /**
+     * @brief maximum
+     * @return maximum of all samples, 0 if the pyramid is empty
+     */
+    double maximum() const;
+
+    /**
+     * @brief envelope summarizes samples @a first .. @a last at the finest level, which gives at most @a maxPoints blocks
+     * @param first index of the first sample
+     * @param last index of the last sample
+     * @param maxPoints maximal number of blocks to return
+     * @param starts output, index of the first sample of each block
+     * @param lows output, minimum of each block
+     * @param highs output, maximum of each block
+     * @return block size of the level used
+     */
+    qint64 envelope(qint64 first, qint64 last, int maxPoints, QVector<double>& starts, QVector<double>& lows, QVector<double>& highs) const;
+
+private:
+
+    QVector<QVector<float> > minima;
+    QVector<QVector<float> > maxima;
+
+    qint64 samples;
+
+    // the block of level 0 being filled
+    int partialCount;
+    double partialMin;
+    double partialMax;
+
+    // the block being filled was stored to level 0 by finish(), it is replaced once more samples arrive
+    bool partialStored;
+};
+}
+#endif // MINMAXPYRAMID_H
@@ -0,0 +1,163 @@
+/**
+ * @file notchfilterbank.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "notchfilterbank.h"
+
+#include <cmath>
+#include <limits>
+
+#ifndef M_LN2
+#define M_LN2 0.69314718055994530942
+#endif
+
+using namespace FT1D;
+
+int NotchFilterBank::addNotch(double position, double width, NotchProfile profile)
+{
+    positions.push_back(position);
+    widths.push_back(width);
+    profiles.push_back(profile);
+    return positions.size() - 1;
+}
+
+
+void NotchFilterBank::addHarmonics(int index, int harmonics, double maxFrequency)
+{
+    const double fundamental = positions[index];
+    const double width = widths[index];
+    const NotchProfile shape = profile(index);
+
+    if(fundamental <= 0)
+    {
+        return;
+    }
+
+    for(int h = 2; h <= harmonics + 1 && h * fundamental <= maxFrequency; h++)
+    {
+        addNotch(h * fundamental, width, shape);
+    }
+}
+
+
+void NotchFilterBank::removeNotch(int index)
+{
+    positions.remove(index);
+    widths.remove(index);
+    profiles.remove(index);
+}
+
+
+void NotchFilterBank::clear()
+{
+    positions.clear();
+    widths.clear();
+    profiles.clear();
+}
+
+
+int NotchFilterBank::nearestNotch(double frequency) const
+{
+    int nearest = -1;
+    double distance = std::numeric_limits<double>::max();
+
+    for(int i = 0; i < positions.size(); i++)
+    {
+        if(std::abs(positions[i] - frequency) < distance)
+        {
+            distance = std::abs(positions[i] - frequency);
+            nearest = i;
+        }
+    }
+    return nearest;
+}
+
+
+void NotchFilterBank::evaluate(const double* frequencies, double* gains, int count) const
+{
+    // notches are regrouped by profile, so that the inner loops are free of branches.
+    // each group keeps the centres and one precomputed coefficient derived from the half width c:
+    //   ideal:        c^2,         gain = d^2 >= c^2 ? 1 : 0
+    //   gaussian:     ln 2 / c^2,  gain = 1 - exp(-ln 2 d^2 / c^2)
+    //   butterworth:  c^4,         gain = d^4 / (d^4 + c^4)
+    // all three profiles have gain 1/2 at distance d = c from the centre.
+    QVector<double> idealCentres, idealCoefficients;
+    QVector<double> gaussianCentres, gaussianCoefficients;
+    QVector<double> butterworthCentres, butterworthCoefficients;
+
+    for(int j = 0; j < positions.size(); j++)
+    {
+        const double halfWidth = widths[j] / 2.0;
+        if(halfWidth <= 0)
+        {
+            continue;
+        }
+
+        const double squared = halfWidth * halfWidth;
+
+        switch(profiles[j])
+        {
+        case IDEAL_NOTCH:
+            idealCentres.push_back(positions[j]);
+            idealCoefficients.push_back(squared);
+            break;
+        case GAUSSIAN_NOTCH:
+            gaussianCentres.push_back(positions[j]);
+            gaussianCoefficients.push_back(M_LN2 / squared);
+            break;
+        case BUTTERWORTH_NOTCH:
+            butterworthCentres.push_back(positions[j]);
+            butterworthCoefficients.push_back(squared * squared);
+            break;
+        default:
+            break;
+        }
+    }
+
+    const int ideals = idealCentres.size();
+    const int gaussians = gaussianCentres.size();
+    const int butterworths = butterworthCentres.size();
+
+    const double* ip = idealCentres.constData();
+    const double* ic = idealCoefficients.constData();
+    const double* gp = gaussianCentres.constData();
+    const double* gc = gaussianCoefficients.constData();
+    const double* bp = butterworthCentres.constData();
+    const double* bc = butterworthCoefficients.constData();
+
+    for(int i = 0; i < count; i++)
+    {
+        const double f = frequencies[i];
+        double gain = 1.0;
+
+        for(int j = 0; j < ideals; j++)
+        {
+            const double d = f - ip[j];
+            gain *= d * d >= ic[j] ? 1.0 : 0.0;
+        }
+
+        for(int j = 0; j < gaussians; j++)
+        {
+            const double d = f - gp[j];
+            gain *= 1.0 - std::exp(-gc[j] * d * d);
+        }
+
+        for(int j = 0; j < butterworths; j++)
+        {
+            const double d = f - bp[j];
+            const double d4 = d * d * d * d;
+            gain *= d4 / (d4 + bc[j]);
+        }
+
+        gains[i] = gain;
+    }
+}
+
+
+QVector<double> NotchFilterBank::evaluate(const QVector<double>& frequencies) const
+{
+    QVector<double> gains(frequencies.size());
+    evaluate(frequencies.constData(), gains.data(), frequencies.size());
+    return gains;
+}
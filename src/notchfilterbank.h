@@ -0,0 +1,110 @@
+#ifndef NOTCHFILTERBANK_H
+#define NOTCHFILTERBANK_H
+
+/**
+ * @file notchfilterbank.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of a bank of band-stop (notch) filters.
+ */
+
+#include <QVector>
+
+namespace FT1D
+{
+
+/**
+ * @brief The NotchProfile enum denotes the shape of one notch
+ */
+enum NotchProfile
+{
+    IDEAL_NOTCH,        // frequencies inside the notch are removed completely
+    GAUSSIAN_NOTCH,     // inverted gaussian
+    BUTTERWORTH_NOTCH   // inverted second order butterworth
+};
+
+
+/**
+ * @brief The NotchFilterBank class holds any number of notches, each with a position, a width and a profile.
+ * The width is the full width at half gain, so notches of all profiles with the same width remove the same band.
+ * Notches are stored as a structure of arrays and the gain of the whole bank is computed in a single pass over the spectrum.
+ */
+class NotchFilterBank
+{
+public:
+
+    /**
+     * @brief count
+     * @return number of notches
+     */
+    inline int count() const
+    {
+        return positions.size();
+    }
+
+    /**
+     * @brief addNotch adds a notch to the bank
+     * @param position centre frequency of the notch
+     * @param width full width of the notch at half gain
+     * @param profile shape of the notch
+     * @return index of the new notch
+     */
+    int addNotch(double position, double width, NotchProfile profile);
+
+    /**
+     * @brief addHarmonics adds notches at integer multiples of the position of notch @a index, with the same width and profile
+     * @param index index of the notch at the fundamental frequency
+     * @param harmonics number of notches to add, harmonics 2 .. harmonics + 1
+     * @param maxFrequency harmonics above this frequency are not added
+     */
+    void addHarmonics(int index, int harmonics, double maxFrequency);
+
+    /**
+     * @brief removeNotch removes notch at index @a index
+     * @param index
+     */
+    void removeNotch(int index);
+
+    /**
+     * @brief clear removes all notches
+     */
+    void clear();
+
+    inline double position(int index) const { return positions[index]; }
+    inline double width(int index) const { return widths[index]; }
+    inline NotchProfile profile(int index) const { return static_cast<NotchProfile>(profiles[index]); }
+
+    inline void setPosition(int index, double value) { positions[index] = value; }
+    inline void setWidth(int index, double value) { widths[index] = value; }
+    inline void setProfile(int index, NotchProfile value) { profiles[index] = value; }
+
+    /**
+     * @brief nearestNotch finds the notch closest to frequency @a frequency
+     * @param frequency
+     * @return index of the closest notch, -1 if the bank is empty
+     */
+    int nearestNotch(double frequency) const;
+
+    /**
+     * @brief evaluate computes the gain of the whole bank, the product of gains of all notches
+     * @param frequencies frequencies, at which the gain is evaluated
+     * @param gains output, @a count gains
+     * @param count number of frequencies
+     */
+    void evaluate(const double* frequencies, double* gains, int count) const;
+
+    /**
+     * @brief evaluate convenience overload of evaluate()
+     * @param frequencies frequencies, at which the gain is evaluated
+     * @return gains
+     */
+    QVector<double> evaluate(const QVector<double>& frequencies) const;
+
+private:
+
+    QVector<double> positions;
+    QVector<double> widths;
+    QVector<int> profiles;
+};
+}
+#endif // NOTCHFILTERBANK_H
@@ -0,0 +1,174 @@
+/**
+ * @file pagedsignal.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "pagedsignal.h"
+
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace FT1D;
+
+PagedSignal::PagedSignal()
+{
+    std::memset(&header, 0, sizeof(header));
+    sampleSize = 0;
+    useCounter = 0;
+}
+
+
+PagedSignal::~PagedSignal()
+{
+    close();
+}
+
+
+bool PagedSignal::open(const QString& path)
+{
+    close();
+
+#if Q_BYTE_ORDER != Q_LITTLE_ENDIAN
+    // samples are read directly from the mapping, they would have to be swapped
+    return false;
+#endif
+
+    file.setFileName(path);
+    if(!file.open(QIODevice::ReadOnly)
+            || file.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header)
+            || !BinarySignalFile::isValidHeader(header, file.size())
+            || header.dtype == FT1B_COMPLEX128
+            || header.count == 0)
+    {
+        close();
+        return false;
+    }
+
+    sampleSize = BinarySignalFile::sampleSize(header.dtype);
+
+    // one sequential pass, only one page is needed at a time
+    QVector<double> buffer(PAGED_SIGNAL_PAGE_SAMPLES);
+    for(qint64 first = 0; first < count(); first += PAGED_SIGNAL_PAGE_SAMPLES)
+    {
+        const qint64 size = read(first, PAGED_SIGNAL_PAGE_SAMPLES, buffer.data());
+        if(size <= 0)
+        {
+            close();
+            return false;
+        }
+        overview.append(buffer.constData(), size);
+    }
+    overview.finish();
+
+    return true;
+}
+
+
+void PagedSignal::close()
+{
+    QMutexLocker locker(&mutex);
+
+    for(const Page& p : pages)
+    {
+        file.unmap(p.data);
+    }
+    pages.clear();
+    file.close();
+
+    std::memset(&header, 0, sizeof(header));
+    overview.clear();
+}
+
+
+qint64 PagedSignal::indexAt(double x) const
+{
+    if(count() == 0 || header.spacing <= 0)
+    {
+        return 0;
+    }
+
+    const double position = std::round((x - header.x0) / header.spacing);
+    return static_cast<qint64>(std::max(0.0, std::min(position, static_cast<double>(count() - 1))));
+}
+
+
+qint64 PagedSignal::read(qint64 first, qint64 count, double* values) const
+{
+    QMutexLocker locker(&mutex);
+
+    first = std::max<qint64>(first, 0);
+    count = std::min(count, this->count() - first);
+
+    qint64 copied = 0;
+    while(copied < count)
+    {
+        const qint64 index = first + copied;
+        const qint64 pageIndex = index / PAGED_SIGNAL_PAGE_SAMPLES;
+        const qint64 offset = index % PAGED_SIGNAL_PAGE_SAMPLES;
+        const qint64 size = std::min(count - copied, PAGED_SIGNAL_PAGE_SAMPLES - offset);
+
+        const uchar* data = page(pageIndex);
+        if(!data)
+        {
+            break;
+        }
+
+        if(header.dtype == FT1B_FLOAT32)
+        {
+            const float* samples = reinterpret_cast<const float*>(data) + offset;
+            std::copy(samples, samples + size, values + copied);
+        }
+        else
+        {
+            const double* samples = reinterpret_cast<const double*>(data) + offset;
+            std::copy(samples, samples + size, values + copied);
+        }
+        copied += size;
+    }
+    return copied;
+}
+
+
+const uchar* PagedSignal::page(qint64 index) const
+{
+    useCounter++;
+
+    for(Page& p : pages)
+    {
+        if(p.index == index)
+        {
+            p.lastUse = useCounter;
+            return p.data;
+        }
+    }
+
+    if(pages.size() == PAGED_SIGNAL_MAX_PAGES)
+    {
+        auto oldest = std::min_element(pages.begin(), pages.end(), [](const Page& a, const Page& b)
+        {
+            return a.lastUse < b.lastUse;
+        });
+        file.unmap(oldest->data);
+        pages.erase(oldest);
+    }
+
+    const qint64 first = index * PAGED_SIGNAL_PAGE_SAMPLES;
+    const qint64 samples = std::min<qint64>(PAGED_SIGNAL_PAGE_SAMPLES, count() - first);
+
+    uchar* data = file.map(FT1B_HEADER_SIZE + first * sampleSize, samples * sampleSize);
+    if(!data)
+    {
+        return nullptr;
+    }
+
+    Page p;
+    p.index = index;
+    p.data = data;
+    p.lastUse = useCounter;
+    pages.push_back(p);
+
+    return data;
+}
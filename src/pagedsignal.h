@@ -0,0 +1,127 @@
+#ifndef PAGEDSIGNAL_H
+#define PAGEDSIGNAL_H
+
+/**
+ * @file pagedsignal.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of an out-of-core signal, read from a binary signal file page by page.
+ */
+
+#include "binarysignalfile.h"
+#include "minmaxpyramid.h"
+
+#include <QFile>
+#include <QMutex>
+#include <QVector>
+
+namespace FT1D
+{
+
+// number of samples in one page of the file
+#define PAGED_SIGNAL_PAGE_SAMPLES (1 << 20)
+
+// number of pages mapped at the same time, the least recently used page is unmapped first
+#define PAGED_SIGNAL_MAX_PAGES 8
+
+/**
+ * @brief The PagedSignal class gives access to a uniformly sampled signal stored in a binary signal file (.ft1b),
+ * which does not need to fit in memory. Only a bounded number of pages of the file is mapped at any time.
+ * A MinMaxPyramid of the whole signal is built when the file is opened, so an overview of any range is available
+ * without reading the samples again. All reading methods are thread safe.
+ */
+class PagedSignal
+{
+public:
+
+    /**
+     * @brief PagedSignal constructor, creates a closed signal
+     */
+    PagedSignal();
+
+    /**
+     * @brief ~PagedSignal destructor, unmaps all pages
+     */
+    ~PagedSignal();
+
+    /**
+     * @brief open opens the binary signal file @a path and streams through it once to build the overview.
+     * The checksum is not verified, it would require reading the file one more time.
+     * @param path path to the file
+     * @return true, if the file is a valid binary signal file
+     */
+    bool open(const QString& path);
+
+    /**
+     * @brief close unmaps all pages and closes the file
+     */
+    void close();
+
+    inline bool isOpen() const { return file.isOpen(); }
+
+    inline qint64 count() const { return static_cast<qint64>(header.count); }
+    inline double spacing() const { return header.spacing; }
+
+    inline double min_x() const { return header.x0; }
+    inline double max_x() const { return header.x0 + (count() - 1) * header.spacing; }
+    inline double x(qint64 index) const { return header.x0 + index * header.spacing; }
+
+    inline double min_y() const { return overview.minimum(); }
+    inline double max_y() const { return overview.maximum(); }
+
+    /**
+     * @brief indexAt
+     * @param x x coordinate
+     * @return index of the sample closest to @a x, clamped to the valid range
+     */
+    qint64 indexAt(double x) const;
+
+    /**
+     * @brief read copies samples @a first .. @a first + @a count - 1 to @a values, mapping the pages needed
+     * @param first index of the first sample
+     * @param count number of samples
+     * @param values output, at least @a count values
+     * @return number of samples copied, less than @a count at the end of the signal
+     */
+    qint64 read(qint64 first, qint64 count, double* values) const;
+
+    /**
+     * @brief pyramid
+     * @return min/max overview of the whole signal
+     */
+    inline const MinMaxPyramid& pyramid() const
+    {
+        return overview;
+    }
+
+private:
+
+    /**
+     * @brief The Page struct is one mapped part of the file
+     */
+    struct Page
+    {
+        qint64 index;
+        uchar* data;
+        quint64 lastUse;
+    };
+
+    /**
+     * @brief page maps page @a index if it is not mapped yet, the mutex must be locked
+     * @param index index of the page
+     * @return pointer to the first sample of the page, nullptr if it cannot be mapped
+     */
+    const uchar* page(qint64 index) const;
+
+    mutable QFile file;
+    BinarySignalHeader header;
+    int sampleSize;
+
+    mutable QMutex mutex;
+    mutable QVector<Page> pages;
+    mutable quint64 useCounter;
+
+    MinMaxPyramid overview;
+};
+}
+#endif // PAGEDSIGNAL_H
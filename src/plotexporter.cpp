@@ -0,0 +1,299 @@
+/**
+ * @file plotexporter.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "plotexporter.h"
+#include "displaysignalwidget.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+// size of the exported plots, in pixels
+#define EXPORT_PLOT_WIDTH 940
+#define EXPORT_PLOT_HEIGHT 540
+
+// number of signals each worker may prepare ahead of the plots being drawn
+#define EXPORT_JOBS_PER_THREAD 2
+
+using namespace FT1D;
+
+namespace
+{
+/**
+ * @brief The PreparedSignal struct is one signal with its transform and each filter applied, ready to be plotted
+ */
+struct PreparedSignal
+{
+    bool loaded;
+    std::string error;
+
+    Signal original;
+    Signal phase;
+    // one per filter setting
+    QVector<Signal> magnitudes;
+    QVector<Signal> filtered;
+};
+
+/**
+ * @brief prepare loads the signal and computes the plotted signals the same way as the main window. The signal is loaded
+ * and transformed once, each filter is applied to a copy of the magnitude. Runs on a worker thread.
+ * @param path path to the signal
+ * @param filters filter settings
+ * @return the signals
+ */
+PreparedSignal prepare(const QString& path, const QVector<PlotExportFilter>& filters)
+{
+    PreparedSignal prepared;
+    prepared.loaded = prepared.original.load_file(path.toStdString(), &prepared.error);
+    if(!prepared.loaded)
+    {
+        return prepared;
+    }
+
+    Signal magnitude;
+    Signal::fourierTransform(prepared.original, magnitude, prepared.phase);
+    const QVector<double> keys = prepared.original.original.keys().toVector();
+
+    prepared.magnitudes.reserve(filters.size());
+    prepared.filtered.reserve(filters.size());
+    for(const PlotExportFilter& filter : filters)
+    {
+        Signal filteredMagnitude = magnitude;
+        if(!filter.none)
+        {
+            FilterDialog::applyFilter(filter.type, filteredMagnitude, filter.omega0, filter.second);
+        }
+
+        Signal filtered;
+        Signal::inverseFourierTransform(filteredMagnitude, prepared.phase, filtered, keys);
+        prepared.magnitudes.append(filteredMagnitude);
+        prepared.filtered.append(filtered);
+    }
+    return prepared;
+}
+
+
+/**
+ * @brief exportPlot saves the plot of @a widget in the size of the exported plots
+ * @param widget widget with the signal displayed
+ * @param path path to the file
+ * @param pdf true for PDF, false for PNG
+ * @return true on success
+ */
+bool exportPlot(DisplaySignalWidget& widget, const QString& path, bool pdf)
+{
+    // displaySignal lays the plot out for the new tick labels; the visible range is taken again for the final axis rect
+    widget.forceXAxisUpdate();
+
+    if(!widget.savePlot(path, pdf, EXPORT_PLOT_WIDTH, EXPORT_PLOT_HEIGHT))
+    {
+        std::cout << path.toStdString() << ": cannot be written" << std::endl;
+        return false;
+    }
+    return true;
+}
+}
+
+
+bool PlotExporter::parseFilter(const QString& text, PlotExportFilter& filter)
+{
+    const QStringList parts = text.toLower().split(QLatin1Char(':'));
+    const QString& kind = parts.first();
+
+    filter.name = parts.join(QLatin1Char('-'));
+    filter.none = kind == QStringLiteral("none");
+    filter.type = ILPF;
+    filter.omega0 = 0;
+    filter.second = 0;
+
+    if(filter.none)
+    {
+        return parts.size() == 1;
+    }
+
+    int parameters = 1;
+    if(kind == QStringLiteral("ilpf"))
+    {
+        filter.type = ILPF;
+    }
+    else if(kind == QStringLiteral("ihpf"))
+    {
+        filter.type = IHPF;
+    }
+    else if(kind == QStringLiteral("glpf"))
+    {
+        filter.type = LPGAUSS;
+    }
+    else if(kind == QStringLiteral("ghpf"))
+    {
+        filter.type = HPGAUSS;
+    }
+    else if(kind == QStringLiteral("blpf"))
+    {
+        filter.type = LPBUTTERWORTH;
+        parameters = 2;
+    }
+    else if(kind == QStringLiteral("bhpf"))
+    {
+        filter.type = HPBUTTERWORTH;
+        parameters = 2;
+    }
+    else if(kind == QStringLiteral("bandpass"))
+    {
+        filter.type = BANDPASS;
+        parameters = 2;
+    }
+    else
+    {
+        return false;
+    }
+
+    if(parts.size() != parameters + 1)
+    {
+        return false;
+    }
+
+    bool ok = true;
+    filter.omega0 = parts[1].toDouble(&ok);
+    if(ok && parameters == 2)
+    {
+        filter.second = parts[2].toDouble(&ok);
+    }
+    return ok && filter.omega0 >= 0 && filter.second >= 0;
+}
+
+
+double PlotExporter::exportDirectory(const QString& input, const QString& output, const QVector<PlotExportFilter>& filters, bool pdf, int threads)
+{
+    const QDir inputDir(input);
+    const QStringList files = inputDir.entryList(QDir::Files | QDir::Readable, QDir::Name);
+    if(!inputDir.exists() || files.isEmpty() || filters.isEmpty())
+    {
+        std::cout << input.toStdString() << ": no signals to export" << std::endl;
+        return -1;
+    }
+
+    const QDir outputDir(output);
+    if(!outputDir.mkpath(QStringLiteral(".")))
+    {
+        std::cout << output.toStdString() << ": cannot create the directory" << std::endl;
+        return -1;
+    }
+
+    threads = std::max(threads, 1);
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+
+    // widgets must be created and drawn on the GUI thread; the same four are reused for all signals
+    DisplaySignalWidget original(ORIGINAL, false);
+    DisplaySignalWidget magnitude(MAGNITUDE, false);
+    DisplaySignalWidget phase(PHASE, false);
+    DisplaySignalWidget filtered(FILTERED, false);
+
+    DisplaySignalWidget* widgets[] = { &original, &magnitude, &phase, &filtered };
+    const char* plotNames[] = { "original", "magnitude", "phase", "filtered" };
+    for(DisplaySignalWidget* widget : widgets)
+    {
+        widget->setAutoScaling(true);
+        // the widgets are never shown, the level of detail has to be chosen for the size of the exported plots
+        widget->setPlotSize(QSize(EXPORT_PLOT_WIDTH, EXPORT_PLOT_HEIGHT));
+    }
+
+    const QString suffix = pdf ? QStringLiteral(".pdf") : QStringLiteral(".png");
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QVector<QFuture<PreparedSignal> > futures(files.size());
+    const int ahead = threads * EXPORT_JOBS_PER_THREAD;
+    int submitted = 0;
+    int plots = 0;
+    int failed = 0;
+
+    for(int i = 0; i < files.size(); i++)
+    {
+        // keep the workers busy, but do not hold more prepared signals than they can produce while one is drawn
+        for(; submitted < files.size() && submitted <= i + ahead; submitted++)
+        {
+            const QString path = inputDir.filePath(files[submitted]);
+            futures[submitted] = QtConcurrent::run(&pool, [=]()
+            {
+                return prepare(path, filters);
+            });
+        }
+
+        PreparedSignal prepared = futures[i].result();
+        futures[i] = QFuture<PreparedSignal>();
+
+        const QFileInfo file(inputDir.filePath(files[i]));
+        if(!prepared.loaded)
+        {
+            std::cout << file.fileName().toStdString() << ": skipped, " << prepared.error << std::endl;
+            continue;
+        }
+
+        original.displaySignal(&prepared.original);
+        phase.displaySignal(&prepared.phase);
+
+        // the original signal and the phase do not depend on the filter, they are saved once per signal
+        const QString signalBase = file.completeBaseName() + QLatin1Char('_');
+        for(int j : {0, 2})
+        {
+            if(exportPlot(*widgets[j], outputDir.filePath(signalBase + QLatin1String(plotNames[j]) + suffix), pdf))
+            {
+                plots++;
+            }
+            else
+            {
+                failed++;
+            }
+        }
+
+        for(int f = 0; f < filters.size(); f++)
+        {
+            magnitude.displaySignal(&prepared.magnitudes[f]);
+            filtered.displaySignal(&prepared.filtered[f]);
+
+            const QString base = signalBase + filters[f].name + QLatin1Char('_');
+            for(int j : {1, 3})
+            {
+                if(exportPlot(*widgets[j], outputDir.filePath(base + QLatin1String(plotNames[j]) + suffix), pdf))
+                {
+                    plots++;
+                }
+                else
+                {
+                    failed++;
+                }
+            }
+        }
+
+        // the widgets point to the signals, which are released with this iteration
+        for(DisplaySignalWidget* widget : widgets)
+        {
+            widget->displaySignal(nullptr);
+        }
+    }
+
+    if(plots == 0)
+    {
+        std::cout << "no plots exported" << std::endl;
+        return -1;
+    }
+
+    const double seconds = std::max<qint64>(timer.nsecsElapsed(), 1) * 1e-9;
+    const double throughput = plots / seconds;
+
+    std::cout << plots << " plots exported, " << failed << " failed, " << threads << " worker threads, "
+              << std::fixed << std::setprecision(1) << seconds << " s, " << throughput << " plots/s" << std::endl;
+
+    return throughput;
+}
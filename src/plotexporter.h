@@ -0,0 +1,67 @@
+#ifndef PLOTEXPORTER_H
+#define PLOTEXPORTER_H
+
+/**
+ * @file plotexporter.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of the batch export, which saves the plots of many signals to image or PDF files without a window.
+ */
+
+#include "filterdialog.h"
+
+#include <QString>
+#include <QVector>
+
+namespace FT1D
+{
+
+/**
+ * @brief The PlotExportFilter struct is one filter setting of the batch export
+ */
+struct PlotExportFilter
+{
+    // the setting as it was given, used in the names of the files
+    QString name;
+    // true, if the signals are exported unfiltered
+    bool none;
+    FilterType type;
+    // parameters of FilterDialog::applyFilter
+    double omega0;
+    double second;
+};
+
+
+/**
+ * @brief The PlotExporter class saves the original signal and phase plots of every signal in a directory,
+ * and its magnitude and filtered signal plots once for each filter setting. Loading the signals, the fourier transforms and the filters run on a pool
+ * of worker threads; the plots are widgets, so they are drawn on the GUI thread while the workers prepare the next signals.
+ * Requires a QApplication, the offscreen platform is enough.
+ */
+class PlotExporter
+{
+public:
+    /**
+     * @brief parseFilter reads a filter setting: "none", or the name of the filter followed by its parameters separated by colons,
+     * i.e. ilpf:OMEGA0, ihpf:OMEGA0, glpf:OMEGA0, ghpf:OMEGA0, blpf:OMEGA0:ORDER, bhpf:OMEGA0:ORDER or bandpass:FROM:TO
+     * @param text the setting
+     * @param filter output, the filter
+     * @return true in case of success
+     */
+    static bool parseFilter(const QString& text, PlotExportFilter& filter);
+
+    /**
+     * @brief exportDirectory saves the original and phase plots of each file in @a input and its magnitude and filtered
+     * plots for each filter in @a filters to @a output, named after the file, the filter (except for the first two) and the plot. Files, which are not signals, are reported and skipped.
+     * The progress and the throughput are printed to standard output.
+     * @param input directory with the signals
+     * @param output directory for the plots, created if it does not exist
+     * @param filters filter settings
+     * @param pdf true to save PDF files, false to save PNG images
+     * @param threads number of worker threads
+     * @return throughput in plots per second, negative if nothing could be exported
+     */
+    static double exportDirectory(const QString& input, const QString& output, const QVector<PlotExportFilter>& filters, bool pdf, int threads);
+};
+}
+#endif // PLOTEXPORTER_H
@@ -0,0 +1,139 @@
+/**
+ * @file plotoverlay.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "plotoverlay.h"
+
+#include <QPainter>
+#include <QFontDatabase>
+
+#include <algorithm>
+
+// margin of the overlay box and padding of its text, in pixels
+#define OVERLAY_MARGIN 4
+#define OVERLAY_PADDING 3
+
+using namespace FT1D;
+
+bool PlotOverlay::enabled = false;
+double PlotOverlay::transformTime = 0;
+int PlotOverlay::transforms = 0;
+
+
+PlotOverlay::PlotOverlay()
+{
+    std::fill(frameTimes, frameTimes + OVERLAY_FRAME_WINDOW, 0.0);
+    std::fill(pending, pending + STAGE_COUNT, 0.0);
+    std::fill(shown, shown + STAGE_COUNT, 0.0);
+    recorded = 0;
+    frames = 0;
+    transformsShown = 0;
+}
+
+
+void PlotOverlay::setEnabled(bool value)
+{
+    enabled = value;
+}
+
+
+double* PlotOverlay::transformTarget()
+{
+    if(!enabled)
+    {
+        return nullptr;
+    }
+    // a new transform replaces the previous one
+    transformTime = 0;
+    transforms++;
+    return &transformTime;
+}
+
+
+double* PlotOverlay::stageTarget(PipelineStage stage)
+{
+    return enabled ? pending + stage : nullptr;
+}
+
+
+void PlotOverlay::addFrame(double frameTime, double paintTime, int count)
+{
+    // the update of this frame includes the transform computed by the application for all plots since the previous one
+    if(transformsShown != transforms)
+    {
+        pending[STAGE_TRANSFORM] += transformTime;
+        frameTime += transformTime;
+        transformsShown = transforms;
+    }
+
+    frameTimes[recorded % OVERLAY_FRAME_WINDOW] = frameTime;
+    recorded++;
+    frames = count >= 0 ? count : frames + 1;
+
+    pending[STAGE_PAINT] = paintTime;
+    std::copy(pending, pending + STAGE_COUNT, shown);
+    std::fill(pending, pending + STAGE_COUNT, 0.0);
+}
+
+
+QString PlotOverlay::text() const
+{
+    const int window = std::min(std::max(recorded, 1), OVERLAY_FRAME_WINDOW);
+    double sum = 0;
+    double worst = 0;
+    for(int i = 0; i < window; i++)
+    {
+        sum += frameTimes[i];
+        worst = std::max(worst, frameTimes[i]);
+    }
+
+    return QStringLiteral("frame     %1 ms (max %2 ms)\nreplots   %3\ntransform %4 ms\nupload    %5 ms\npaint     %6 ms")
+            .arg(sum / window, 0, 'f', 2).arg(worst, 0, 'f', 2).arg(frames)
+            .arg(shown[STAGE_TRANSFORM], 0, 'f', 2).arg(shown[STAGE_UPLOAD], 0, 'f', 2).arg(shown[STAGE_PAINT], 0, 'f', 2);
+}
+
+
+void PlotOverlay::draw(QPainter& painter, const QRect& area) const
+{
+    painter.save();
+    painter.setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+    const QString lines = text();
+    QRect box = painter.boundingRect(area, Qt::AlignTop | Qt::AlignRight, lines);
+    box.adjust(-2 * OVERLAY_PADDING, 0, 0, 2 * OVERLAY_PADDING);
+    box.moveTopRight(area.topRight() + QPoint(-OVERLAY_MARGIN, OVERLAY_MARGIN));
+
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(0, 0, 0, 160));
+    painter.drawRect(box);
+    painter.setPen(Qt::white);
+    painter.drawText(box.adjusted(OVERLAY_PADDING, OVERLAY_PADDING, -OVERLAY_PADDING, -OVERLAY_PADDING), Qt::AlignLeft | Qt::AlignTop, lines);
+
+    painter.restore();
+}
+
+
+StageTimer::StageTimer(double* target) : target(target)
+{
+    if(target)
+    {
+        timer.start();
+    }
+}
+
+
+StageTimer::~StageTimer()
+{
+    stop();
+}
+
+
+void StageTimer::stop()
+{
+    if(target)
+    {
+        *target += timer.nsecsElapsed() * 1e-6;
+        target = nullptr;
+    }
+}
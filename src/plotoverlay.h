@@ -0,0 +1,155 @@
+#ifndef PLOTOVERLAY_H
+#define PLOTOVERLAY_H
+
+/**
+ * @file plotoverlay.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of the overlay with frame times and timings of the stages of updating a plot.
+ */
+
+#include <QString>
+#include <QRect>
+#include <QElapsedTimer>
+
+class QPainter;
+
+namespace FT1D
+{
+
+// number of frames the rolling frame time is computed from
+#define OVERLAY_FRAME_WINDOW 30
+
+/**
+ * @brief The PipelineStage enum lists the timed stages of an update of a plot
+ */
+enum PipelineStage
+{
+    STAGE_TRANSFORM,    // fourier transform or filter computing the displayed values
+    STAGE_UPLOAD,       // passing the values to the plot (setData, level of detail, projection)
+    STAGE_PAINT,        // drawing the frame
+    STAGE_COUNT
+};
+
+
+/**
+ * @brief The PlotOverlay class collects the timings of one plot and formats them for the overlay: rolling frame time,
+ * number of frames and the time of each stage of the update which produced the last frame.
+ * Stage times accumulate until the next frame is recorded, then they are shown and start again from zero.
+ * Nothing is measured while the overlays are disabled.
+ */
+class PlotOverlay
+{
+public:
+    /**
+     * @brief PlotOverlay constructor
+     */
+    PlotOverlay();
+
+    /**
+     * @brief setEnabled enables or disables measuring for all overlays
+     * @param value
+     */
+    static void setEnabled(bool value);
+
+    /**
+     * @brief isEnabled
+     * @return true, if the overlays are displayed
+     */
+    static inline bool isEnabled()
+    {
+        return enabled;
+    }
+
+    /**
+     * @brief transformTarget where StageTimer records the time of a transform computed by the application for all plots.
+     * The time is shown with the next frame of each plot.
+     * @return null while the overlays are disabled
+     */
+    static double* transformTarget();
+
+    /**
+     * @brief stageTarget where StageTimer records the time of @a stage of the current update
+     * @param stage
+     * @return null while the overlays are disabled
+     */
+    double* stageTarget(PipelineStage stage);
+
+    /**
+     * @brief stageTime
+     * @param stage
+     * @return time recorded for @a stage of the current update so far, in milliseconds
+     */
+    inline double stageTime(PipelineStage stage) const
+    {
+        return pending[stage];
+    }
+
+    /**
+     * @brief addFrame records a frame. The stages of the current update are shown with it.
+     * @param frameTime time of the whole update in milliseconds, the transform of transformTarget is added to it
+     * @param paintTime time of drawing in the frame, without the other stages timed during it
+     * @param count number of frames of the plot, replaces the own count if not negative
+     */
+    void addFrame(double frameTime, double paintTime, int count = -1);
+
+    /**
+     * @brief text
+     * @return the overlay, line by line
+     */
+    QString text() const;
+
+    /**
+     * @brief draw draws the overlay into the top right corner of @a area
+     * @param painter painter to use for drawing
+     * @param area area of the plot
+     */
+    void draw(QPainter& painter, const QRect& area) const;
+
+private:
+    static bool enabled;
+    // the last transform and the number of transforms so far
+    static double transformTime;
+    static int transforms;
+
+    // the last OVERLAY_FRAME_WINDOW frame times, in a ring indexed by the number of recorded frames
+    double frameTimes[OVERLAY_FRAME_WINDOW];
+    int recorded;
+    int frames;
+    // number of transforms already shown with a frame of this plot
+    int transformsShown;
+
+    // stages of the update in progress and of the last frame
+    double pending[STAGE_COUNT];
+    double shown[STAGE_COUNT];
+};
+
+
+/**
+ * @brief The StageTimer class adds the time from its construction to its destruction to @a target, if it is not null
+ */
+class StageTimer
+{
+public:
+    /**
+     * @brief StageTimer starts measuring
+     * @param target milliseconds are added here, nothing is measured if null
+     */
+    explicit StageTimer(double* target);
+
+    /**
+     * @brief ~StageTimer adds the elapsed time to the target
+     */
+    ~StageTimer();
+
+    /**
+     * @brief stop adds the elapsed time to the target now, the destructor then adds nothing
+     */
+    void stop();
+
+private:
+    double* target;
+    QElapsedTimer timer;
+};
+}
+#endif // PLOTOVERLAY_H
@@ -0,0 +1,321 @@
+/**
+ * @file plotrasterizer.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "plotrasterizer.h"
+
+#include <QtConcurrent>
+
+using namespace FT1D;
+
+namespace
+{
+/**
+ * @brief antialiasing decides whether an element is antialiased, the same way as QCPLayerable does when the plot draws it
+ * @param plot the plot, whose settings override the setting of the element
+ * @param local setting of the element
+ * @param element kind of the element
+ * @return true, if the element is antialiased
+ */
+bool antialiasing(const QCustomPlot* plot, bool local, QCP::AntialiasedElement element)
+{
+    if(plot->notAntialiasedElements().testFlag(element))
+    {
+        return false;
+    }
+    if(plot->antialiasedElements().testFlag(element))
+    {
+        return true;
+    }
+    return local;
+}
+}
+
+
+PlotSnapshot::PlotSnapshot(QCustomPlot* plot, QCPLayer* layer)
+{
+    size = plot->axisRect()->size();
+    keyRange = plot->xAxis->range();
+    valueRange = plot->yAxis->range();
+
+    // graphs the plottables were taken from, to find the graphs filled to
+    QList<const QCPGraph*> graphs;
+
+    for(QCPLayerable* child : layer->children())
+    {
+        QCPAbstractPlottable* plottable = qobject_cast<QCPAbstractPlottable*>(child);
+        if(plottable == nullptr || !plottable->visible())
+        {
+            continue;
+        }
+
+        Plottable p;
+        p.pen = plottable->pen();
+        p.brush = plottable->brush();
+        p.channelFill = -1;
+        p.antialiased = antialiasing(plot, plottable->antialiased(), QCP::aePlottables);
+        p.antialiasedFill = antialiasing(plot, plottable->antialiasedFill(), QCP::aeFills);
+        p.antialiasedScatters = antialiasing(plot, plottable->antialiasedScatters(), QCP::aeScatters);
+
+        if(QCPGraph* graph = qobject_cast<QCPGraph*>(plottable))
+        {
+            p.isCurve = false;
+            p.graphData = graph->data()->vector();
+            p.line = graph->lineStyle() != QCPGraph::lsNone;
+            p.scatterStyle = graph->scatterStyle();
+            graphs.append(graph);
+        }
+        else if(QCPCurve* curve = qobject_cast<QCPCurve*>(plottable))
+        {
+            p.isCurve = true;
+            p.curveData = *curve->data();
+            p.line = curve->lineStyle() != QCPCurve::lsNone;
+            p.scatterStyle = curve->scatterStyle();
+            graphs.append(nullptr);
+        }
+        else
+        {
+            continue;
+        }
+        plottables.append(p);
+    }
+
+    for(int i = 0; i < plottables.size(); i++)
+    {
+        if(graphs[i] && graphs[i]->channelFillGraph())
+        {
+            plottables[i].channelFill = graphs.indexOf(graphs[i]->channelFillGraph());
+        }
+    }
+}
+
+
+bool PlotSnapshot::sameAs(const PlotSnapshot& other) const
+{
+    if(size != other.size || keyRange != other.keyRange || valueRange != other.valueRange
+            || plottables.size() != other.plottables.size())
+    {
+        return false;
+    }
+
+    for(int i = 0; i < plottables.size(); i++)
+    {
+        const Plottable& a = plottables[i];
+        const Plottable& b = other.plottables[i];
+
+        const QCPScatterStyle& sa = a.scatterStyle;
+        const QCPScatterStyle& sb = b.scatterStyle;
+
+        if(a.isCurve != b.isCurve || !a.graphData.isSharedWith(b.graphData) || !a.curveData.isSharedWith(b.curveData)
+                || a.pen != b.pen || a.brush != b.brush || a.line != b.line || a.channelFill != b.channelFill
+                || sa.shape() != sb.shape() || sa.size() != sb.size() || sa.pen() != sb.pen() || sa.brush() != sb.brush()
+                || a.antialiased != b.antialiased || a.antialiasedFill != b.antialiasedFill || a.antialiasedScatters != b.antialiasedScatters)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+QVector<QPointF> PlotSnapshot::pixels(const Plottable& plottable) const
+{
+    // the same transformation as QCPAxis::coordToPixel, relative to the top left corner of the axis rect
+    const double xScale = size.width() / keyRange.size();
+    const double yScale = size.height() / valueRange.size();
+    const double bottom = size.height() - 1;
+
+    QVector<QPointF> points;
+
+    if(plottable.isCurve)
+    {
+        points.reserve(plottable.curveData.size());
+        for(QCPCurveDataMap::const_iterator it = plottable.curveData.constBegin(); it != plottable.curveData.constEnd(); ++it)
+        {
+            if(!qIsNaN(it.value().value))
+            {
+                points.append(QPointF((it.value().key - keyRange.lower) * xScale, bottom - (it.value().value - valueRange.lower) * yScale));
+            }
+        }
+    }
+    else
+    {
+        const QCPData* data = plottable.graphData.constData();
+        const int count = plottable.graphData.size();
+        points.reserve(count);
+        for(int i = 0; i < count; i++)
+        {
+            if(!qIsNaN(data[i].value))
+            {
+                points.append(QPointF((data[i].key - keyRange.lower) * xScale, bottom - (data[i].value - valueRange.lower) * yScale));
+            }
+        }
+    }
+    return points;
+}
+
+
+QImage PlotSnapshot::rasterize() const
+{
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    if(image.isNull())
+    {
+        return image;
+    }
+    image.fill(Qt::transparent);
+
+    QVector<QVector<QPointF> > points(plottables.size());
+    for(int i = 0; i < plottables.size(); i++)
+    {
+        points[i] = pixels(plottables[i]);
+    }
+
+    QCPPainter painter(&image);
+    // pixmaps, e.g. the cached scatter sprites, must not be used outside the GUI thread
+    painter.setMode(QCPPainter::pmNoCaching);
+
+    // in the order of QCPGraph::draw: fill, line, scatters
+    for(int i = 0; i < plottables.size(); i++)
+    {
+        const Plottable& p = plottables[i];
+        const QVector<QPointF>& line = points[i];
+
+        if(p.channelFill >= 0 && p.brush.style() != Qt::NoBrush)
+        {
+            const QVector<QPointF>& other = points[p.channelFill];
+            QPolygonF polygon(line);
+            polygon.reserve(line.size() + other.size());
+            for(int j = other.size() - 1; j >= 0; j--)
+            {
+                polygon.append(other[j]);
+            }
+
+            painter.setAntialiasing(p.antialiasedFill);
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(p.brush);
+            painter.drawPolygon(polygon);
+        }
+
+        if(p.line && p.pen.style() != Qt::NoPen)
+        {
+            painter.setAntialiasing(p.antialiased);
+            painter.setPen(p.pen);
+            painter.setBrush(Qt::NoBrush);
+            painter.drawPolyline(line.constData(), line.size());
+        }
+
+        if(!p.scatterStyle.isNone())
+        {
+            painter.setAntialiasing(p.antialiasedScatters);
+            p.scatterStyle.applyTo(&painter, p.pen);
+            p.scatterStyle.drawShapes(&painter, line);
+        }
+    }
+
+    painter.end();
+    return image;
+}
+
+
+PlotRasterizer::PlotRasterizer(QObject* parent) : QObject(parent)
+{
+    // emitted on the worker thread, delivered on the thread of this object
+    connect(this, &PlotRasterizer::frameComputed, this, [=]()
+    {
+        finishedFrame = renderedFrame;
+        finishedSnapshot = rendering;
+        renderedFrame = QImage();
+        rendering.clear();
+
+        if(pending)
+        {
+            start();
+        }
+        emit frameReady();
+    });
+}
+
+
+PlotRasterizer::~PlotRasterizer()
+{
+    pending.clear();
+    future.waitForFinished();
+}
+
+
+void PlotRasterizer::render(const QSharedPointer<const PlotSnapshot>& snapshot)
+{
+    if(requested && requested->sameAs(*snapshot))
+    {
+        return;
+    }
+    requested = snapshot;
+
+    // a snapshot still waiting is outdated, it is replaced
+    pending = snapshot;
+    if(!rendering)
+    {
+        start();
+    }
+}
+
+
+void PlotRasterizer::start()
+{
+    rendering = pending;
+    pending.clear();
+
+    const QSharedPointer<const PlotSnapshot> snapshot = rendering;
+    future = QtConcurrent::run([=]()
+    {
+        // read on the GUI thread only after frameComputed is delivered, and no other worker runs until then
+        renderedFrame = snapshot->rasterize();
+        emit frameComputed();
+    });
+}
+
+
+RasterFrame::RasterFrame(QCustomPlot* plot, const QString& layer) : QCPLayerable(plot, layer)
+{
+}
+
+
+void RasterFrame::setFrame(const QImage& image, const PlotSnapshot& snapshot)
+{
+    pixmap = QPixmap::fromImage(image);
+    keyRange = snapshot.xRange();
+    valueRange = snapshot.yRange();
+}
+
+
+void RasterFrame::applyDefaultAntialiasingHint(QCPPainter* painter) const
+{
+    // the frame is copied pixel by pixel
+    painter->setAntialiasing(false);
+}
+
+
+void RasterFrame::draw(QCPPainter* painter)
+{
+    if(pixmap.isNull())
+    {
+        return;
+    }
+
+    // the rows of the frame are the pixels from bottom - height + 1 to bottom of the axis rect, see PlotSnapshot::pixels;
+    // with the current ranges of the axes they are stretched between the pixels of the ranges of the frame
+    const double left = mParentPlot->xAxis->coordToPixel(keyRange.lower);
+    const double right = mParentPlot->xAxis->coordToPixel(keyRange.upper);
+    const double bottom = mParentPlot->yAxis->coordToPixel(valueRange.lower);
+    const double top = mParentPlot->yAxis->coordToPixel(valueRange.upper);
+    const double rowHeight = (bottom - top) / pixmap.height();
+
+    painter->drawPixmap(QRectF(left, top + rowHeight, right - left, bottom - top), pixmap, QRectF(pixmap.rect()));
+}
+
+
+QRect RasterFrame::clipRect() const
+{
+    return mParentPlot->axisRect()->rect();
+}
@@ -0,0 +1,213 @@
+#ifndef PLOTRASTERIZER_H
+#define PLOTRASTERIZER_H
+
+/**
+ * @file plotrasterizer.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of the rasterizer, which draws the graphs of a plot into an image on a worker thread.
+ */
+
+#include "qcustomplot/qcustomplot.h"
+
+#include <QObject>
+#include <QImage>
+#include <QFuture>
+#include <QSharedPointer>
+
+namespace FT1D
+{
+
+/**
+ * @brief The PlotSnapshot class is an immutable copy of the graphs and curves on one layer of a plot, of the ranges of the axes
+ * and of the size of the axis rect. The data are implicitly shared with the plottables, so taking a snapshot does not copy them;
+ * a plottable copies its data only when it changes them while the snapshot exists.
+ * Lines, scatters and fills down to a channel graph are drawn, which is what DisplaySignalWidget uses.
+ */
+class PlotSnapshot
+{
+public:
+    /**
+     * @brief PlotSnapshot takes a snapshot of the visible graphs and curves on @a layer. Must be called on the GUI thread.
+     * @param plot the plot
+     * @param layer layer of the plottables
+     */
+    PlotSnapshot(QCustomPlot* plot, QCPLayer* layer);
+
+    /**
+     * @brief sameAs compares two snapshots. The data are compared by identity, not point by point.
+     * @param other
+     * @return true, if both snapshots would be drawn the same
+     */
+    bool sameAs(const PlotSnapshot& other) const;
+
+    /**
+     * @brief rasterize draws the plottables into an image of the size of the axis rect. Can be called on any thread.
+     * @return the image, transparent where nothing is drawn
+     */
+    QImage rasterize() const;
+
+    /**
+     * @brief xRange
+     * @return range of the x axis the snapshot was taken with
+     */
+    inline QCPRange xRange() const
+    {
+        return keyRange;
+    }
+
+    /**
+     * @brief yRange
+     * @return range of the y axis the snapshot was taken with
+     */
+    inline QCPRange yRange() const
+    {
+        return valueRange;
+    }
+
+private:
+    // a graph or a curve, with what is needed to draw it
+    struct Plottable
+    {
+        bool isCurve;
+        QVector<QCPData> graphData;
+        QCPCurveDataMap curveData;
+
+        QPen pen;
+        QBrush brush;
+        bool line;
+        QCPScatterStyle scatterStyle;
+        // index of the plottable the area to which is filled with brush, -1 if none
+        int channelFill;
+
+        bool antialiased;
+        bool antialiasedFill;
+        bool antialiasedScatters;
+    };
+
+    /**
+     * @brief pixels transforms the points of @a plottable to pixels of the image. Points with a NaN value are left out.
+     * @param plottable
+     * @return positions in the image
+     */
+    QVector<QPointF> pixels(const Plottable& plottable) const;
+
+    QSize size;
+    QCPRange keyRange;
+    QCPRange valueRange;
+    QVector<Plottable> plottables;
+};
+
+
+/**
+ * @brief The PlotRasterizer class rasterizes snapshots of a plot on a worker thread, one at a time.
+ * A snapshot requested while another one is drawn waits; when a newer one is requested meanwhile, the waiting one is dropped,
+ * so the worker always continues with the latest state and never falls behind by more than one frame.
+ */
+class PlotRasterizer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief PlotRasterizer constructor
+     * @param parent parent object
+     */
+    explicit PlotRasterizer(QObject* parent = nullptr);
+
+    /**
+     * @brief ~PlotRasterizer destructor, waits for the worker thread
+     */
+    virtual ~PlotRasterizer();
+
+    /**
+     * @brief render requests rasterizing @a snapshot. Ignored, if it would be drawn the same as the previous one.
+     * @param snapshot snapshot of the plot
+     */
+    void render(const QSharedPointer<const PlotSnapshot>& snapshot);
+
+    /**
+     * @brief frame
+     * @return the last finished frame
+     */
+    inline const QImage& frame() const
+    {
+        return finishedFrame;
+    }
+
+    /**
+     * @brief frameSnapshot
+     * @return the snapshot the last finished frame was drawn from, null if there is no frame yet
+     */
+    inline QSharedPointer<const PlotSnapshot> frameSnapshot() const
+    {
+        return finishedSnapshot;
+    }
+
+signals:
+    /**
+     * @brief frameReady notifies that a new frame is finished
+     */
+    void frameReady();
+
+    /**
+     * @brief frameComputed internal notification from the worker thread, the frame is taken over before frameReady is emitted
+     */
+    void frameComputed();
+
+private:
+    /**
+     * @brief start starts rasterizing the waiting snapshot on the worker thread
+     */
+    void start();
+
+    // the last requested snapshot, to ignore requests which would not change the frame
+    QSharedPointer<const PlotSnapshot> requested;
+    // the snapshot waiting for the worker, null if none
+    QSharedPointer<const PlotSnapshot> pending;
+    // the snapshot being rasterized, null if the worker is idle
+    QSharedPointer<const PlotSnapshot> rendering;
+    // result of the worker, taken over on the GUI thread
+    QImage renderedFrame;
+
+    QSharedPointer<const PlotSnapshot> finishedSnapshot;
+    QImage finishedFrame;
+
+    QFuture<void> future;
+};
+
+
+/**
+ * @brief The RasterFrame class draws the last frame of a PlotRasterizer into the axis rect of the plot.
+ * The frame is placed according to the ranges of the axes it was drawn with, so while the axes are dragged or zoomed,
+ * the previous frame is moved and stretched to the right place until the next one is finished.
+ */
+class RasterFrame : public QCPLayerable
+{
+public:
+    /**
+     * @brief RasterFrame constructor
+     * @param plot the plot
+     * @param layer name of the layer to draw the frame on
+     */
+    RasterFrame(QCustomPlot* plot, const QString& layer);
+
+    /**
+     * @brief setFrame sets the frame to draw
+     * @param image the frame
+     * @param snapshot the snapshot the frame was drawn from
+     */
+    void setFrame(const QImage& image, const PlotSnapshot& snapshot);
+
+protected:
+    void applyDefaultAntialiasingHint(QCPPainter* painter) const Q_DECL_OVERRIDE;
+    void draw(QCPPainter* painter) Q_DECL_OVERRIDE;
+    QRect clipRect() const Q_DECL_OVERRIDE;
+
+private:
+    QPixmap pixmap;
+    QCPRange keyRange;
+    QCPRange valueRange;
+};
+}
+#endif // PLOTRASTERIZER_H
@@ -28,57 +28,84 @@ PredefinedSignalsDialog::PredefinedSignalsDialog(QWidget *parent, QString signal
     cancelButton = new QPushButton(QStringLiteral("Cancel"),this);
     cancelButton->setGeometry(740,400,100,30);
 
+    lengthCheckBox = new QCheckBox(this);
+    lengthCheckBox->setGeometry(10,405,150,20);
+
+    lengthSpinBox = new QSpinBox(this);
+    lengthSpinBox->setGeometry(160,403,120,24);
+    lengthSpinBox->setRange(1, 1 << 24);
+    lengthSpinBox->setValue(1 << 10);
+    lengthSpinBox->setEnabled(false);
+
+    connect(lengthCheckBox, &QCheckBox::toggled, lengthSpinBox, &QSpinBox::setEnabled);
+
     connect(sinusPushButton, &QPushButton::clicked, [=](bool) {
-        if(sinusRadioButton16->isChecked())
+        if(lengthCheckBox->isChecked())
+            generateSignal(SHAPE_SINE);
+        else if(sinusRadioButton16->isChecked())
             emit signalChosen(signalsFolder + QStringLiteral("/sinus_16.ft1d"));
         else emit signalChosen(signalsFolder + QStringLiteral("/sinus_32.ft1d"));
         accept();
     } );
 
     connect(cosinusPushButton, &QPushButton::clicked, [=](bool) {
-        if(cosinusRadioButton16->isChecked())
+        if(lengthCheckBox->isChecked())
+            generateSignal(SHAPE_COSINE);
+        else if(cosinusRadioButton16->isChecked())
             emit signalChosen(signalsFolder + QStringLiteral("/cosinus_16.ft1d"));
         else emit signalChosen(signalsFolder + QStringLiteral("/cosinus_32.ft1d"));
         accept();
     } );
 
     connect(gaussianPushButton, &QPushButton::clicked, [=](bool) {
-        if(gaussianRadioButton16->isChecked())
+        if(lengthCheckBox->isChecked())
+            generateSignal(SHAPE_GAUSSIAN);
+        else if(gaussianRadioButton16->isChecked())
             emit signalChosen(signalsFolder + QStringLiteral("/gaussian_16.ft1d"));
         else emit signalChosen(signalsFolder + QStringLiteral("/gaussian_32.ft1d"));
         accept();
     } );
 
     connect(impulsePushButton, &QPushButton::clicked, [=](bool) {
-        if(impulseRadioButton16->isChecked())
+        if(lengthCheckBox->isChecked())
+            generateSignal(SHAPE_IMPULSE);
+        else if(impulseRadioButton16->isChecked())
             emit signalChosen(signalsFolder + QStringLiteral("/impulse_7_16.ft1d"));
         else emit signalChosen(signalsFolder + QStringLiteral("/impulse_15_32.ft1d"));
         accept();
     } );
 
     connect(stepPushButton, &QPushButton::clicked, [=](bool) {
-        if(stepRadioButton16->isChecked())
+        if(lengthCheckBox->isChecked())
+            generateSignal(SHAPE_STEP);
+        else if(stepRadioButton16->isChecked())
             emit signalChosen(signalsFolder + QStringLiteral("/step_16.ft1d"));
         else emit signalChosen(signalsFolder + QStringLiteral("/step_32.ft1d"));
         accept();
     } );
 
     connect(rampPushButton, &QPushButton::clicked, [=](bool) {
-        if(rampRadioButton16->isChecked())
+        if(lengthCheckBox->isChecked())
+            generateSignal(SHAPE_RAMP);
+        else if(rampRadioButton16->isChecked())
             emit signalChosen(signalsFolder + QStringLiteral("/ramp_16.ft1d"));
         else emit signalChosen(signalsFolder + QStringLiteral("/ramp_32.ft1d"));
         accept();
     } );
 
     connect(constantPushButton, &QPushButton::clicked, [=](bool) {
-        if(constantRadioButton16->isChecked())
+        if(lengthCheckBox->isChecked())
+            generateSignal(SHAPE_CONSTANT);
+        else if(constantRadioButton16->isChecked())
             emit signalChosen(signalsFolder + QStringLiteral("/constant_1_16.ft1d"));
         else emit signalChosen(signalsFolder + QStringLiteral("/constant_1_32.ft1d"));
         accept();
     } );
 
     connect(sincPushButton, &QPushButton::clicked, [=](bool) {
-        if(sincRadioButton16->isChecked())
+        if(lengthCheckBox->isChecked())
+            generateSignal(SHAPE_SINC);
+        else if(sincRadioButton16->isChecked())
             emit signalChosen(signalsFolder + QStringLiteral("/sinc_16.ft1d"));
         else emit signalChosen(signalsFolder + QStringLiteral("/sinc_32.ft1d"));
         accept();
@@ -108,6 +135,8 @@ PredefinedSignalsDialog::~PredefinedSignalsDialog()
     delete rampPushButton;
     delete sincPushButton;
     delete cancelButton;
+    delete lengthCheckBox;
+    delete lengthSpinBox;
 
     delete sinusRadioButton16;
     delete sinusRadioButton32;
@@ -188,10 +217,20 @@ void PredefinedSignalsDialog::setupRadioButtons(QGroupBox*& groupBox, QRadioButt
 }
 
 
+void PredefinedSignalsDialog::generateSignal(GeneratedShape shape)
+{
+    GeneratorParameters parameters;
+    parameters.shape = shape;
+    parameters.length = lengthSpinBox->value();
+    emit signalGenerated(parameters);
+}
+
+
 void PredefinedSignalsDialog::setDefaultTexts()
 {
     setWindowTitle(QStringLiteral("Choose one of the prepared functions..."));
     cancelButton->setText(QStringLiteral("Cancel"));
+    lengthCheckBox->setText(QStringLiteral("Other length:"));
 }
 
 
@@ -202,6 +241,9 @@ void PredefinedSignalsDialog::setLocalizedTexts(const Translation* language)
 
     cancelButton->setText(language->getChildElementText(QStringLiteral("cancelButton")));
     if(cancelButton->text().isEmpty()) cancelButton->setText(QStringLiteral("Cancel"));
+
+    lengthCheckBox->setText(language->getChildElementText(QStringLiteral("lengthCheckBox")));
+    if(lengthCheckBox->text().isEmpty()) lengthCheckBox->setText(QStringLiteral("Other length:"));
 }
 
 
@@ -7,16 +7,20 @@
  */
 
 #include "localization.h"
+#include "signalgenerator.h"
 
 #include <QDialog>
 #include <QPushButton>
 #include <QGroupBox>
 #include <QRadioButton>
+#include <QCheckBox>
+#include <QSpinBox>
 
 namespace FT1D
 {
 /**
- * @brief The PredefinedSignalsDialog class is a Dialog in which the user can choose to load one of 8 predefined signals
+ * @brief The PredefinedSignalsDialog class is a Dialog in which the user can choose to load one of 8 predefined signals.
+ * The 16 and 32 samples variants are loaded from files, signals of other lengths are generated.
  */
 class PredefinedSignalsDialog : public QDialog
 {
@@ -43,6 +47,12 @@ signals:
      */
     void signalChosen(QString resourcePath);
 
+    /**
+     * @brief signalGenerated a signal to notify that a signal of other length was selected
+     * @param parameters the signal to generate
+     */
+    void signalGenerated(FT1D::GeneratorParameters parameters);
+
 private:
 
     /**
@@ -65,6 +75,12 @@ private:
      */
     void setupRadioButtons(QGroupBox*& groupBox, QRadioButton*& radio16, QRadioButton*& radio32, QRect geometry, QPushButton* pushButton, const QString imageResouce16, const QString imageResouce32);
 
+    /**
+     * @brief generateSignal emits signalGenerated for @a shape of the length chosen in lengthSpinBox
+     * @param shape the chosen signal
+     */
+    void generateSignal(GeneratedShape shape);
+
     /**
      * @brief setDefaultTexts sets defaults values to each text or title or label in the window.
      */
@@ -89,6 +105,9 @@ private:
     QPushButton *sincPushButton;
     QPushButton *cancelButton;
 
+    QCheckBox* lengthCheckBox;
+    QSpinBox* lengthSpinBox;
+
     QGroupBox* sinusGroupBox;
     QGroupBox* cosinusGroupBox;
     QGroupBox* impulseGroupBox;
@@ -25,6 +25,12 @@
 
 #include "qcustomplot.h"
 
+#include <QElapsedTimer>
+#include <QCoreApplication>
+#include <QThread>
+
+#include <algorithm>
+
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -663,6 +669,110 @@ void QCPScatterStyle::drawShape(QCPPainter *painter, double x, double y) const
     }
 }
 
+/*!
+  Draws the scatter shape with \a painter at all \a positions. Like \ref drawShape, this function
+  uses the pen and the brush of the painter, so \ref applyTo is meant to be called before.
+  
+  On raster devices, the shape is rendered only once into a pixmap (see \ref sprite), which is then
+  copied to each position. This is considerably faster than drawing the shape for every point, when
+  there are many of them. The shapes are drawn one by one with \ref
+  drawShape, if the painter is in \ref QCPPainter::pmVectorized or \ref QCPPainter::pmNoCaching
+  mode, outside the GUI thread, or if no pixmap could be created for the current pen and brush.
+  
+  \see applyTo
+*/
+void QCPScatterStyle::drawShapes(QCPPainter *painter, const QVector<QPointF> &positions) const
+{
+    if (mShape == ssNone || positions.isEmpty())
+        return;
+    
+    const QPixmap shapePixmap = sprite(painter);
+    if (shapePixmap.isNull())
+    {
+        for (int i=0; i<positions.size(); ++i)
+            drawShape(painter, positions.at(i));
+        return;
+    }
+    
+    // the sprite is square, the shape is centered in it:
+    const double center = shapePixmap.width()/shapePixmap.devicePixelRatio()*0.5;
+    const QPointF *pos = positions.constData();
+    for (int i=0; i<positions.size(); ++i)
+        painter->drawPixmap(QPointF(pos[i].x()-center, pos[i].y()-center), shapePixmap);
+}
+
+/*! \internal
+  
+  Returns a pixmap with the scatter shape drawn in its center, with the pen, brush and antialiasing
+  of \a painter. The pixmaps are cached for every combination of shape, size, pen, brush,
+  antialiasing and device pixel ratio, so they are drawn again only when the style changes.
+  
+  Returns a null pixmap, if the shape should not be drawn from a pixmap with \a painter: Vectorized
+  output (e.g. PDF) is kept vectorized, painters in \ref QCPPainter::pmNoCaching mode and painters
+  outside the GUI thread don't use the cache (pixmaps may only be used in the GUI thread) and scaling
+  or rotating transforms would blur the pixmap. \ref ssDot, \ref ssPixmap and \ref
+  ssCustom shapes, as well as pens and brushes which are not plain solid ones, are not cached
+  either.
+  
+  The cache is emptied when the application is about to quit, because pixmaps must not outlive the
+  application object. No sprites are cached after that. If the event loop is never run, the cache is
+  not destroyed at all, rather than after the application object.
+*/
+QPixmap QCPScatterStyle::sprite(QCPPainter *painter) const
+{
+    static QCache<QString, QPixmap> *spriteCache = 0; // cache at most 64 sprites, created on first use
+    static bool quitting = false;
+    
+    if (painter->modes().testFlag(QCPPainter::pmVectorized) || painter->modes().testFlag(QCPPainter::pmNoCaching))
+        return QPixmap();
+    if (quitting || !QCoreApplication::instance() || QThread::currentThread() != QCoreApplication::instance()->thread())
+        return QPixmap();
+    if (painter->transform().type() > QTransform::TxTranslate)
+        return QPixmap();
+    if (mShape == ssNone || mShape == ssDot || mShape == ssPixmap || mShape == ssCustom)
+        return QPixmap();
+    
+    const QPen pen = painter->pen();
+    const QBrush brush = painter->brush();
+    if ((pen.style() != Qt::SolidLine && pen.style() != Qt::NoPen) || (brush.style() != Qt::SolidPattern && brush.style() != Qt::NoBrush))
+        return QPixmap();
+    
+    const qreal ratio = painter->device() ? painter->device()->devicePixelRatioF() : 1.0;
+    const QString key = QString(QLatin1String("%1 %2 %3 %4 %5 %6 %7 %8 %9"))
+            .arg(mShape).arg(mSize).arg(pen.style()).arg(pen.color().rgba()).arg(pen.widthF())
+            .arg(pen.capStyle()).arg(brush.style() == Qt::NoBrush ? 0u : brush.color().rgba())
+            .arg(painter->antialiasing()).arg(ratio);
+    if (!spriteCache)
+    {
+        spriteCache = new QCache<QString, QPixmap>(64);
+        QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, []()
+        {
+            quitting = true;
+            delete spriteCache;
+            spriteCache = 0;
+        });
+    }
+    if (const QPixmap *cachedSprite = spriteCache->object(key))
+        return *cachedSprite;
+    
+    // the shape with the pen around it and a pixel of margin on each side for antialiasing:
+    const double penWidth = pen.style() == Qt::NoPen ? 0 : qMax(1.0, pen.widthF());
+    const int side = qCeil(mSize + penWidth) + 2;
+    QPixmap *newSprite = new QPixmap(qCeil(side*ratio), qCeil(side*ratio));
+    newSprite->setDevicePixelRatio(ratio);
+    newSprite->fill(Qt::transparent);
+    QCPPainter spritePainter(newSprite);
+    spritePainter.setAntialiasing(painter->antialiasing());
+    spritePainter.setPen(pen);
+    spritePainter.setBrush(brush);
+    drawShape(&spritePainter, side*0.5, side*0.5);
+    spritePainter.end();
+    
+    const QPixmap result = *newSprite;
+    spriteCache->insert(key, newSprite);
+    return result;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////// QCPLayer
@@ -708,6 +818,10 @@ void QCPScatterStyle::drawShape(QCPPainter *painter, double x, double y) const
   
   When a layer is deleted, the objects on it are not deleted with it, but fall on the layer below
   the deleted layer, see QCustomPlot::removeLayer.
+  
+  A layer whose content changes often independently of the rest, e.g. a cursor, may be given a paint
+  buffer of its own with \ref setMode. Then \ref replot redraws only that layer and the buffers of
+  the other layers are reused.
 */
 
 /* start documentation of inline functions */
@@ -741,7 +855,9 @@ QCPLayer::QCPLayer(QCustomPlot *parentPlot, const QString &layerName) :
     mParentPlot(parentPlot),
     mName(layerName),
     mIndex(-1), // will be set to a proper value by the QCustomPlot layer creation function
-    mVisible(true)
+    mVisible(true),
+    mMode(lmLogical),
+    mPaintBufferIndex(-1) // will be set by QCustomPlot::setupPaintBuffers
 {
     // Note: no need to make sure layerName is unique, because layer
     // management is done with QCustomPlot functions.
@@ -774,6 +890,70 @@ void QCPLayer::setVisible(bool visible)
     mVisible = visible;
 }
 
+/*!
+  Sets whether this layer is drawn into a paint buffer of its own (\ref lmBuffered) or shares it
+  with the neighbouring layers (\ref lmLogical). The buffers are rearranged with the next \ref
+  QCustomPlot::replot.
+  
+  A buffered layer can be redrawn alone with \ref replot, which is much faster than replotting the
+  whole plot if only the content of this layer changed. Every buffer costs memory of the size of
+  the widget and a little time to be composed on the widget surface.
+*/
+void QCPLayer::setMode(LayerMode mode)
+{
+    if (mMode != mode)
+    {
+        mMode = mode;
+        mPaintBufferIndex = -1;
+    }
+}
+
+/*!
+  Redraws only the layerables of this layer into its paint buffer and updates the widget surface,
+  the other layers aren't drawn again. The layout isn't updated either, so this is meant for
+  changes which don't affect the axes, like moving an item or changing the data of a graph
+  without rescaling.
+  
+  If the layer isn't buffered (see \ref setMode) or its buffer isn't set up yet, the whole plot is
+  replotted.
+*/
+void QCPLayer::replot()
+{
+    if (mMode != lmBuffered || mPaintBufferIndex < 0 || mPaintBufferIndex >= mParentPlot->mPaintBuffers.size()
+            || mParentPlot->mPaintBuffers.at(mPaintBufferIndex).size() != mParentPlot->size())
+    {
+        mParentPlot->replot();
+        return;
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    if (mParentPlot->drawPaintBuffer(mPaintBufferIndex))
+        mParentPlot->update();
+    mParentPlot->mReplotTime = timer.nsecsElapsed()*1e-6;
+    ++mParentPlot->mReplotCount;
+    emit mParentPlot->afterLayerReplot(this);
+}
+
+/*! \internal
+  
+  Draws the visible layerables of this layer with \a painter, in the order of their creation.
+*/
+void QCPLayer::draw(QCPPainter *painter)
+{
+    foreach (QCPLayerable *child, mChildren)
+    {
+        if (child->realVisibility())
+        {
+            painter->save();
+            painter->setClipRect(child->clipRect().translated(0, -1));
+            child->applyDefaultAntialiasingHint(painter);
+            child->draw(painter);
+            painter->restore();
+        }
+    }
+}
+
 /*! \internal
   
   Adds the \a layerable to the list of this layer. If \a prepend is set to true, the layerable will
@@ -8935,6 +9115,14 @@ QCP::Interaction QCPAbstractItem::selectionCategory() const
   \see replot, beforeReplot
 */
 
+/*! \fn void QCustomPlot::afterLayerReplot(QCPLayer *layer)
+  
+  This signal is emitted after only the paint buffer of the buffered \a layer was redrawn by \ref
+  QCPLayer::replot. When the layer falls back to a full replot, \ref afterReplot is emitted instead.
+  
+  \see QCPLayer::replot, afterReplot
+*/
+
 /* end of documentation of signals */
 /* start of documentation of public members */
 
@@ -9034,9 +9222,10 @@ QCustomPlot::QCustomPlot(QWidget *parent) :
     mCurrentLayer(0),
     mPlottingHints(QCP::phCacheLabels|QCP::phForceRepaint),
     mMultiSelectModifier(Qt::ControlModifier),
-    mPaintBuffer(size()),
     mMouseEventElement(0),
-    mReplotting(false)
+    mReplotting(false),
+    mReplotTime(0),
+    mReplotCount(0)
 {
     setAttribute(Qt::WA_NoMousePropagation);
     setAttribute(Qt::WA_OpaquePaintEvent);
@@ -10362,6 +10551,11 @@ void QCustomPlot::deselectAll()
   afterReplot is emitted. It is safe to mutually connect the replot slot with any of those two
   signals on two QCustomPlots to make them replot synchronously, it won't cause an infinite
   recursion.
+  
+  All paint buffers are redrawn. If only the content of one buffered layer changed, \ref
+  QCPLayer::replot is faster.
+  
+  \see replotTime
 */
 void QCustomPlot::replot(QCustomPlot::RefreshPriority refreshPriority)
 {
@@ -10370,16 +10564,21 @@ void QCustomPlot::replot(QCustomPlot::RefreshPriority refreshPriority)
     mReplotting = true;
     emit beforeReplot();
 
-    mPaintBuffer.fill(mBackgroundBrush.style() == Qt::SolidPattern ? mBackgroundBrush.color() : Qt::transparent);
-    QCPPainter painter;
-    painter.begin(&mPaintBuffer);
-    if (painter.isActive())
+    QElapsedTimer timer;
+    timer.start();
+
+    // run through layout phases:
+    mPlotLayout->update(QCPLayoutElement::upPreparation);
+    mPlotLayout->update(QCPLayoutElement::upMargins);
+    mPlotLayout->update(QCPLayoutElement::upLayout);
+
+    setupPaintBuffers();
+    bool painted = true;
+    for (int i=0; i<mPaintBuffers.size() && painted; ++i)
+        painted = drawPaintBuffer(i);
+
+    if (painted)
     {
-        painter.setRenderHint(QPainter::HighQualityAntialiasing); // to make Antialiasing look good if using the OpenGL graphicssystem
-        if (mBackgroundBrush.style() != Qt::SolidPattern && mBackgroundBrush.style() != Qt::NoBrush)
-            painter.fillRect(mViewport, mBackgroundBrush);
-        draw(&painter);
-        painter.end();
         if ((refreshPriority == rpHint && mPlottingHints.testFlag(QCP::phForceRepaint)) || refreshPriority==rpImmediate)
             repaint();
         else
@@ -10387,10 +10586,25 @@ void QCustomPlot::replot(QCustomPlot::RefreshPriority refreshPriority)
     } else // might happen if QCustomPlot has width or height zero
         qDebug() << Q_FUNC_INFO << "Couldn't activate painter on buffer. This usually happens because QCustomPlot has width or height zero.";
 
+    mReplotTime = timer.nsecsElapsed()*1e-6;
+    ++mReplotCount;
     emit afterReplot();
     mReplotting = false;
 }
 
+/*! \fn double QCustomPlot::replotTime() const
+  
+  Returns the time in milliseconds the last \ref replot, or \ref QCPLayer::replot of a single
+  buffered layer, took to draw the paint buffers. Composing the buffers on the widget surface isn't
+  included, it happens later in the paint event.
+*/
+
+/*! \fn int QCustomPlot::replotCount() const
+  
+  Returns the number of times the paint buffers were drawn, by \ref replot or by \ref
+  QCPLayer::replot of a single buffered layer.
+*/
+
 /*!
   Rescales the axes such that all plottables (like graphs) in the plot are fully visible.
   
@@ -10658,7 +10872,8 @@ void QCustomPlot::paintEvent(QPaintEvent *event)
 {
     Q_UNUSED(event);
     QPainter painter(this);
-    painter.drawPixmap(0, 0, mPaintBuffer);
+    foreach (const QPixmap &buffer, mPaintBuffers)
+        painter.drawPixmap(0, 0, buffer);
 }
 
 /*! \internal
@@ -10669,8 +10884,8 @@ void QCustomPlot::paintEvent(QPaintEvent *event)
 */
 void QCustomPlot::resizeEvent(QResizeEvent *event)
 {
-    // resize and repaint the buffer:
-    mPaintBuffer = QPixmap(event->size());
+    // the buffers are resized by the replot:
+    Q_UNUSED(event);
     setViewport(rect());
     replot(rpQueued); // queued update is important here, to prevent painting issues in some contexts
 }
@@ -10883,19 +11098,7 @@ void QCustomPlot::draw(QCPPainter *painter)
 
     // draw all layered objects (grid, axes, plottables, items, legend,...):
     foreach (QCPLayer *layer, mLayers)
-    {
-        foreach (QCPLayerable *child, layer->children())
-        {
-            if (child->realVisibility())
-            {
-                painter->save();
-                painter->setClipRect(child->clipRect().translated(0, -1));
-                child->applyDefaultAntialiasingHint(painter);
-                child->draw(painter);
-                painter->restore();
-            }
-        }
-    }
+        layer->draw(painter);
 
     /* Debug code to draw all layout element rects
   foreach (QCPLayoutElement* el, findChildren<QCPLayoutElement*>())
@@ -10949,6 +11152,73 @@ void QCustomPlot::drawBackground(QCPPainter *painter)
 }
 
 
+/*! \internal
+  
+  Assigns a paint buffer to every layer: each buffered layer gets one of its own, consecutive
+  logical layers share one. The first buffer also holds the background. Buffers are (re)created
+  if their number or the size of the widget changed.
+  
+  \see QCPLayer::setMode
+*/
+void QCustomPlot::setupPaintBuffers()
+{
+    int index = -1;
+    bool previousBuffered = false;
+    foreach (QCPLayer *layer, mLayers)
+    {
+        const bool buffered = layer->mode() == QCPLayer::lmBuffered;
+        if (index < 0 || buffered || previousBuffered)
+            ++index;
+        layer->mPaintBufferIndex = index;
+        previousBuffered = buffered;
+    }
+
+    mPaintBuffers.resize(qMax(index+1, 1));
+    for (int i=0; i<mPaintBuffers.size(); ++i)
+    {
+        if (mPaintBuffers.at(i).size() != size())
+            mPaintBuffers[i] = QPixmap(size());
+    }
+}
+
+/*! \internal
+  
+  Clears the paint buffer with index \a index and draws the layers assigned to it. The first buffer
+  is filled with the background, the others are transparent.
+  
+  Returns false if the buffer couldn't be painted, e.g. because the widget has zero size.
+  
+  \see setupPaintBuffers
+*/
+bool QCustomPlot::drawPaintBuffer(int index)
+{
+    QPixmap &buffer = mPaintBuffers[index];
+    if (index == 0)
+        buffer.fill(mBackgroundBrush.style() == Qt::SolidPattern ? mBackgroundBrush.color() : Qt::transparent);
+    else
+        buffer.fill(Qt::transparent);
+
+    QCPPainter painter;
+    painter.begin(&buffer);
+    if (!painter.isActive())
+        return false;
+
+    painter.setRenderHint(QPainter::HighQualityAntialiasing); // to make Antialiasing look good if using the OpenGL graphicssystem
+    if (index == 0)
+    {
+        if (mBackgroundBrush.style() != Qt::SolidPattern && mBackgroundBrush.style() != Qt::NoBrush)
+            painter.fillRect(mViewport, mBackgroundBrush);
+        drawBackground(&painter);
+    }
+    foreach (QCPLayer *layer, mLayers)
+    {
+        if (layer->mPaintBufferIndex == index)
+            layer->draw(&painter);
+    }
+    painter.end();
+    return true;
+}
+
 /*! \internal
   
   This method is used by \ref QCPAxisRect::removeAxis to report removed axes to the QCustomPlot
@@ -10988,7 +11258,10 @@ void QCustomPlot::legendRemoved(QCPLegend *legend)
 void QCustomPlot::updateLayerIndices() const
 {
     for (int i=0; i<mLayers.size(); ++i)
+    {
         mLayers.at(i)->mIndex = i;
+        mLayers.at(i)->mPaintBufferIndex = -1; // reassigned by the next replot
+    }
 }
 
 /*! \internal
@@ -14416,6 +14689,214 @@ QCPData::QCPData(double key, double value) :
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPDataContainer
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPDataContainer
+  \brief Holds the data points of a QCPGraph, sorted by key.
+  
+  The points are stored in one QVector instead of a node per point, so lookups are binary
+  searches and whole data sets are replaced without allocating per point. Inserting a point in the
+  middle moves the following ones, appending in key order is cheap.
+  
+  Iterators are invalidated by every modification of the container.
+  
+  \see QCPData, QCPGraph::data
+*/
+
+/*! \fn const QVector<QCPData> &QCPDataContainer::vector() const
+  
+  Returns the data points, sorted by key. The vector is implicitly shared, so a copy of it is a
+  cheap snapshot of the data, which stays unchanged when the container is modified later.
+*/
+
+// orderings of data points by key, for the binary searches
+static inline bool qcpDataKeyLess(const QCPData &data, double key) { return data.key < key; }
+static inline bool qcpKeyDataLess(double key, const QCPData &data) { return key < data.key; }
+static inline bool qcpDataLess(const QCPData &a, const QCPData &b) { return a.key < b.key; }
+
+/*! \internal
+  Returns the index of the first data point with a key not smaller than \a key, or \ref size if
+  there is none.
+*/
+int QCPDataContainer::lowerIndex(double key) const
+{
+    const QCPData *first = mData.constData();
+    return int(std::lower_bound(first, first+mData.size(), key, qcpDataKeyLess) - first);
+}
+
+/*! \internal
+  Returns the index of the first data point with a key greater than \a key, or \ref size if there
+  is none.
+*/
+int QCPDataContainer::upperIndex(double key) const
+{
+    const QCPData *first = mData.constData();
+    return int(std::upper_bound(first, first+mData.size(), key, qcpKeyDataLess) - first);
+}
+
+/*!
+  Returns an iterator to the first data point with a key not smaller than \a key, or \ref end if
+  there is none.
+*/
+QCPDataContainer::iterator QCPDataContainer::lowerBound(double key)
+{
+    return begin() + lowerIndex(key);
+}
+
+/*! \overload */
+QCPDataContainer::const_iterator QCPDataContainer::lowerBound(double key) const
+{
+    return constBegin() + lowerIndex(key);
+}
+
+/*!
+  Returns an iterator to the first data point with a key greater than \a key, or \ref end if there
+  is none.
+*/
+QCPDataContainer::iterator QCPDataContainer::upperBound(double key)
+{
+    return begin() + upperIndex(key);
+}
+
+/*! \overload */
+QCPDataContainer::const_iterator QCPDataContainer::upperBound(double key) const
+{
+    return constBegin() + upperIndex(key);
+}
+
+/*!
+  Returns an iterator to the first data point with exactly the key \a key, or \ref end if there is
+  none.
+*/
+QCPDataContainer::iterator QCPDataContainer::find(double key)
+{
+    iterator it = lowerBound(key);
+    return (it != end() && it.key() == key) ? it : end();
+}
+
+/*! \overload */
+QCPDataContainer::const_iterator QCPDataContainer::find(double key) const
+{
+    const_iterator it = lowerBound(key);
+    return (it != constEnd() && it.key() == key) ? it : constEnd();
+}
+
+/*!
+  Inserts \a data at \a key. If there already are data points with the key, the first of them is
+  replaced, as QMap::insert does.
+*/
+QCPDataContainer::iterator QCPDataContainer::insert(double key, const QCPData &data)
+{
+    iterator it = find(key);
+    if (it != end())
+    {
+        *it = data;
+        it->key = key;
+        return it;
+    }
+    return insertMulti(key, data);
+}
+
+/*!
+  Inserts \a data at \a key, after all data points with an equal key. Appending points in the
+  order of their keys doesn't move any data.
+*/
+QCPDataContainer::iterator QCPDataContainer::insertMulti(double key, const QCPData &data)
+{
+    int index = mData.size();
+    if (!mData.isEmpty() && key < mData.last().key)
+        index = upperIndex(key);
+    mData.insert(index, data);
+    mData[index].key = key;
+    return begin() + index;
+}
+
+/*!
+  Adds all data points of \a other, keeping the points of this container in front of those with
+  an equal key of \a other.
+*/
+QCPDataContainer &QCPDataContainer::unite(const QCPDataContainer &other)
+{
+    if (other.isEmpty())
+        return *this;
+    if (isEmpty() || other.firstKey() >= lastKey())
+    {
+        mData += other.mData;
+        return *this;
+    }
+    QVector<QCPData> merged(mData.size()+other.mData.size());
+    std::merge(mData.constBegin(), mData.constEnd(), other.mData.constBegin(), other.mData.constEnd(), merged.begin(), qcpDataLess);
+    mData.swap(merged);
+    return *this;
+}
+
+/*!
+  Removes all data points with exactly the key \a key and returns their number.
+*/
+int QCPDataContainer::remove(double key)
+{
+    iterator first = lowerBound(key);
+    iterator last = upperBound(key);
+    const int count = int(last.mItem-first.mItem);
+    erase(first, last);
+    return count;
+}
+
+/*!
+  Removes the data point at \a it and returns an iterator to the next one.
+*/
+QCPDataContainer::iterator QCPDataContainer::erase(iterator it)
+{
+    return erase(it, it+1);
+}
+
+/*! \overload
+  Removes the data points from \a first up to, but not including, \a last and returns an iterator
+  to the point that followed them. The following points are moved only once.
+*/
+QCPDataContainer::iterator QCPDataContainer::erase(iterator first, iterator last)
+{
+    const int index = int(first.mItem-mData.constData());
+    mData.remove(index, int(last.mItem-first.mItem));
+    return begin() + index;
+}
+
+/*!
+  Replaces the content with \a count data points with keys \a keys and values \a values, all errors
+  are set to zero. The memory of the previous points is reused if it suffices.
+  
+  The keys are expected in ascending order, as usual for a graph. If they are not, the points are
+  sorted by key.
+*/
+void QCPDataContainer::set(const double *keys, const double *values, int count)
+{
+    mData.resize(qMax(count, 0));
+    QCPData *item = mData.data();
+    bool sorted = true;
+    for (int i=0; i<count; ++i)
+    {
+        item[i] = QCPData(keys[i], values[i]);
+        sorted = sorted && (i == 0 || keys[i-1] <= keys[i]);
+    }
+    if (!sorted)
+        std::stable_sort(mData.begin(), mData.end(), qcpDataLess);
+}
+
+/*!
+  Sets the values of \a count data points starting at the \a index-th one to \a values, keeping
+  their keys and errors. Nothing is allocated, so this is the cheapest way to update a graph whose
+  keys didn't change.
+*/
+void QCPDataContainer::setValues(int index, const double *values, int count)
+{
+    QCPData *item = mData.data() + index;
+    for (int i=0; i<count; ++i)
+        item[i].value = values[i];
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////// QCPGraph
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -14539,16 +15020,7 @@ void QCPGraph::setData(QCPDataMap *data, bool copy)
 */
 void QCPGraph::setData(const QVector<double> &key, const QVector<double> &value)
 {
-    mData->clear();
-    int n = key.size();
-    n = qMin(n, value.size());
-    QCPData newData;
-    for (int i=0; i<n; ++i)
-    {
-        newData.key = key[i];
-        newData.value = value[i];
-        mData->insertMulti(newData.key, newData);
-    }
+    mData->set(key.constData(), value.constData(), qMin(key.size(), value.size()));
 }
 
 /*!
@@ -14919,9 +15391,7 @@ void QCPGraph::addData(const QVector<double> &keys, const QVector<double> &value
 */
 void QCPGraph::removeDataBefore(double key)
 {
-    QCPDataMap::iterator it = mData->begin();
-    while (it != mData->end() && it.key() < key)
-        it = mData->erase(it);
+    mData->erase(mData->begin(), mData->lowerBound(key));
 }
 
 /*!
@@ -14931,9 +15401,7 @@ void QCPGraph::removeDataBefore(double key)
 void QCPGraph::removeDataAfter(double key)
 {
     if (mData->isEmpty()) return;
-    QCPDataMap::iterator it = mData->upperBound(key);
-    while (it != mData->end())
-        it = mData->erase(it);
+    mData->erase(mData->upperBound(key), mData->end());
 }
 
 /*!
@@ -14946,10 +15414,7 @@ void QCPGraph::removeDataAfter(double key)
 void QCPGraph::removeData(double fromKey, double toKey)
 {
     if (fromKey >= toKey || mData->isEmpty()) return;
-    QCPDataMap::iterator it = mData->upperBound(fromKey);
-    QCPDataMap::iterator itEnd = mData->upperBound(toKey);
-    while (it != itEnd)
-        it = mData->erase(it);
+    mData->erase(mData->upperBound(fromKey), mData->upperBound(toKey));
 }
 
 /*! \overload
@@ -15535,17 +16000,20 @@ void QCPGraph::drawScatterPlot(QCPPainter *painter, QVector<QCPData> *scatterDat
     // draw scatter point symbols:
     applyScattersAntialiasingHint(painter);
     mScatterStyle.applyTo(painter, mPen);
+    QVector<QPointF> positions;
+    positions.reserve(scatterData->size());
     if (keyAxis->orientation() == Qt::Vertical)
     {
         for (int i=0; i<scatterData->size(); ++i)
             if (!qIsNaN(scatterData->at(i).value))
-                mScatterStyle.drawShape(painter, valueAxis->coordToPixel(scatterData->at(i).value), keyAxis->coordToPixel(scatterData->at(i).key));
+                positions.append(QPointF(valueAxis->coordToPixel(scatterData->at(i).value), keyAxis->coordToPixel(scatterData->at(i).key)));
     } else
     {
         for (int i=0; i<scatterData->size(); ++i)
             if (!qIsNaN(scatterData->at(i).value))
-                mScatterStyle.drawShape(painter, keyAxis->coordToPixel(scatterData->at(i).key), valueAxis->coordToPixel(scatterData->at(i).value));
+                positions.append(QPointF(keyAxis->coordToPixel(scatterData->at(i).key), valueAxis->coordToPixel(scatterData->at(i).value)));
     }
+    mScatterStyle.drawShapes(painter, positions);
 }
 
 /*!  \internal
@@ -17200,9 +17668,12 @@ void QCPCurve::drawScatterPlot(QCPPainter *painter, const QVector<QPointF> *poin
     // draw scatter point symbols:
     applyScattersAntialiasingHint(painter);
     mScatterStyle.applyTo(painter, mPen);
+    QVector<QPointF> positions;
+    positions.reserve(pointData->size());
     for (int i=0; i<pointData->size(); ++i)
         if (!qIsNaN(pointData->at(i).x()) && !qIsNaN(pointData->at(i).y()))
-            mScatterStyle.drawShape(painter,  pointData->at(i));
+            positions.append(pointData->at(i));
+    mScatterStyle.drawShapes(painter, positions);
 }
 
 /*! \internal
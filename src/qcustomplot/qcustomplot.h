@@ -293,8 +293,11 @@ public:
   void applyTo(QCPPainter *painter, const QPen &defaultPen) const;
   void drawShape(QCPPainter *painter, QPointF pos) const;
   void drawShape(QCPPainter *painter, double x, double y) const;
+  void drawShapes(QCPPainter *painter, const QVector<QPointF> &positions) const;
 
 protected:
+  QPixmap sprite(QCPPainter *painter) const;
+
   // property members:
   double mSize;
   ScatterShape mShape;
@@ -371,8 +374,19 @@ class QCP_LIB_DECL QCPLayer : public QObject
   Q_PROPERTY(int index READ index)
   Q_PROPERTY(QList<QCPLayerable*> children READ children)
   Q_PROPERTY(bool visible READ visible WRITE setVisible)
+  Q_PROPERTY(LayerMode mode READ mode WRITE setMode)
   /// \endcond
 public:
+  /*!
+    Defines whether a layer is drawn into a paint buffer of its own.
+
+    \see setMode, replot
+  */
+  enum LayerMode { lmLogical   ///< The layer shares the paint buffer with the neighbouring logical layers, it is redrawn with them
+                   ,lmBuffered ///< The layer has its own paint buffer, \ref replot redraws only this layer
+                 };
+  Q_ENUMS(LayerMode)
+
   QCPLayer(QCustomPlot* parentPlot, const QString &layerName);
   ~QCPLayer();
   
@@ -382,9 +396,14 @@ public:
   int index() const { return mIndex; }
   QList<QCPLayerable*> children() const { return mChildren; }
   bool visible() const { return mVisible; }
+  LayerMode mode() const { return mMode; }
   
   // setters:
   void setVisible(bool visible);
+  void setMode(LayerMode mode);
+  
+  // non-property methods:
+  void replot();
   
 protected:
   // property members:
@@ -393,8 +412,13 @@ protected:
   int mIndex;
   QList<QCPLayerable*> mChildren;
   bool mVisible;
+  LayerMode mMode;
+  
+  // non-property members:
+  int mPaintBufferIndex;
   
   // non-virtual methods:
+  void draw(QCPPainter *painter);
   void addChild(QCPLayerable *layerable, bool prepend);
   void removeChild(QCPLayerable *layerable);
   
@@ -469,6 +493,7 @@ private:
   Q_DISABLE_COPY(QCPLayerable)
   
   friend class QCustomPlot;
+  friend class QCPLayer;
   friend class QCPAxisRect;
 };
 
@@ -1819,6 +1844,8 @@ public:
   QPixmap toPixmap(int width=0, int height=0, double scale=1.0);
   void toPainter(QCPPainter *painter, int width=0, int height=0);
   Q_SLOT void replot(QCustomPlot::RefreshPriority refreshPriority=QCustomPlot::rpHint);
+  double replotTime() const { return mReplotTime; }
+  int replotCount() const { return mReplotCount; }
   
   QCPAxis *xAxis, *yAxis, *xAxis2, *yAxis2;
   QCPLegend *legend;
@@ -1844,6 +1871,7 @@ signals:
   void selectionChangedByUser();
   void beforeReplot();
   void afterReplot();
+  void afterLayerReplot(QCPLayer *layer);
   
 protected:
   // property members:
@@ -1868,10 +1896,12 @@ protected:
   Qt::KeyboardModifier mMultiSelectModifier;
   
   // non-property members:
-  QPixmap mPaintBuffer;
+  QVector<QPixmap> mPaintBuffers;
   QPoint mMousePressPos;
   QPointer<QCPLayoutElement> mMouseEventElement;
   bool mReplotting;
+  double mReplotTime;
+  int mReplotCount;
   
   // reimplemented virtual methods:
   virtual QSize minimumSizeHint() const;
@@ -1893,6 +1923,8 @@ protected:
   void updateLayerIndices() const;
   QCPLayerable *layerableAt(const QPointF &pos, bool onlySelectable, QVariant *selectionDetails=0) const;
   void drawBackground(QCPPainter *painter);
+  void setupPaintBuffers();
+  bool drawPaintBuffer(int index);
   
   friend class QCPLegend;
   friend class QCPAxis;
@@ -2483,16 +2515,130 @@ public:
 };
 Q_DECLARE_TYPEINFO(QCPData, Q_MOVABLE_TYPE);
 
+class QCP_LIB_DECL QCPDataContainer
+{
+public:
+  class const_iterator;
+
+  class iterator
+  {
+  public:
+    iterator() : mItem(0) {}
+    explicit iterator(QCPData *item) : mItem(item) {}
+
+    double key() const { return mItem->key; }
+    QCPData &value() const { return *mItem; }
+    QCPData &operator*() const { return *mItem; }
+    QCPData *operator->() const { return mItem; }
+
+    iterator &operator++() { ++mItem; return *this; }
+    iterator operator++(int) { iterator old(*this); ++mItem; return old; }
+    iterator &operator--() { --mItem; return *this; }
+    iterator operator--(int) { iterator old(*this); --mItem; return old; }
+    iterator &operator+=(int n) { mItem += n; return *this; }
+    iterator &operator-=(int n) { mItem -= n; return *this; }
+    iterator operator+(int n) const { return iterator(mItem+n); }
+    iterator operator-(int n) const { return iterator(mItem-n); }
+
+  private:
+    QCPData *mItem;
+    friend class const_iterator;
+    friend class QCPDataContainer;
+  };
+
+  class const_iterator
+  {
+  public:
+    const_iterator() : mItem(0) {}
+    explicit const_iterator(const QCPData *item) : mItem(item) {}
+    const_iterator(const iterator &other) : mItem(other.mItem) {}
+
+    double key() const { return mItem->key; }
+    const QCPData &value() const { return *mItem; }
+    const QCPData &operator*() const { return *mItem; }
+    const QCPData *operator->() const { return mItem; }
+
+    const_iterator &operator++() { ++mItem; return *this; }
+    const_iterator operator++(int) { const_iterator old(*this); ++mItem; return old; }
+    const_iterator &operator--() { --mItem; return *this; }
+    const_iterator operator--(int) { const_iterator old(*this); --mItem; return old; }
+    const_iterator &operator+=(int n) { mItem += n; return *this; }
+    const_iterator &operator-=(int n) { mItem -= n; return *this; }
+    const_iterator operator+(int n) const { return const_iterator(mItem+n); }
+    const_iterator operator-(int n) const { return const_iterator(mItem-n); }
+
+    int operator-(const const_iterator &other) const { return int(mItem-other.mItem); }
+    bool operator==(const const_iterator &other) const { return mItem == other.mItem; }
+    bool operator!=(const const_iterator &other) const { return mItem != other.mItem; }
+    bool operator<(const const_iterator &other) const { return mItem < other.mItem; }
+
+  private:
+    const QCPData *mItem;
+  };
+
+  typedef iterator Iterator;
+  typedef const_iterator ConstIterator;
+
+  QCPDataContainer() {}
+
+  // getters:
+  int size() const { return mData.size(); }
+  bool isEmpty() const { return mData.isEmpty(); }
+  const QCPData &at(int i) const { return mData.at(i); }
+  double firstKey() const { return mData.first().key; }
+  double lastKey() const { return mData.last().key; }
+  const QVector<QCPData> &vector() const { return mData; }
+
+  // iterators, dereferencing the end of an empty container is not allowed:
+  iterator begin() { return iterator(mData.data()); }
+  iterator end() { return iterator(mData.data()+mData.size()); }
+  const_iterator begin() const { return constBegin(); }
+  const_iterator end() const { return constEnd(); }
+  const_iterator constBegin() const { return const_iterator(mData.constData()); }
+  const_iterator constEnd() const { return const_iterator(mData.constData()+mData.size()); }
+
+  // binary search:
+  iterator lowerBound(double key);
+  const_iterator lowerBound(double key) const;
+  iterator upperBound(double key);
+  const_iterator upperBound(double key) const;
+  iterator find(double key);
+  const_iterator find(double key) const;
+  bool contains(double key) const { return find(key) != constEnd(); }
+
+  // modification:
+  void clear() { mData.clear(); }
+  void reserve(int size) { mData.reserve(size); }
+  iterator insert(double key, const QCPData &data);
+  iterator insertMulti(double key, const QCPData &data);
+  QCPDataContainer &unite(const QCPDataContainer &other);
+  int remove(double key);
+  iterator erase(iterator it);
+  iterator erase(iterator first, iterator last);
+  void set(const double *keys, const double *values, int count);
+  void setValues(int index, const double *values, int count);
+
+private:
+  QVector<QCPData> mData;
+
+  int lowerIndex(double key) const;
+  int upperIndex(double key) const;
+};
+
+inline bool operator==(const QCPDataContainer::iterator &a, const QCPDataContainer::iterator &b) { return QCPDataContainer::const_iterator(a) == QCPDataContainer::const_iterator(b); }
+inline bool operator!=(const QCPDataContainer::iterator &a, const QCPDataContainer::iterator &b) { return QCPDataContainer::const_iterator(a) != QCPDataContainer::const_iterator(b); }
+inline bool operator==(const QCPDataContainer::iterator &a, const QCPDataContainer::const_iterator &b) { return QCPDataContainer::const_iterator(a) == b; }
+inline bool operator!=(const QCPDataContainer::iterator &a, const QCPDataContainer::const_iterator &b) { return QCPDataContainer::const_iterator(a) != b; }
+
 /*! \typedef QCPDataMap
   Container for storing \ref QCPData items in a sorted fashion. The key of the map
   is the key member of the QCPData instance.
   
-  This is the container in which QCPGraph holds its data.
-  \see QCPData, QCPGraph::setData
+  This is the container in which QCPGraph holds its data. It used to be a QMap, the name is kept
+  for compatibility.
+  \see QCPData, QCPDataContainer, QCPGraph::setData
 */
-typedef QMap<double, QCPData> QCPDataMap;
-typedef QMapIterator<double, QCPData> QCPDataMapIterator;
-typedef QMutableMapIterator<double, QCPData> QCPDataMutableMapIterator;
+typedef QCPDataContainer QCPDataMap;
 
 
 class QCP_LIB_DECL QCPGraph : public QCPAbstractPlottable
@@ -0,0 +1,254 @@
+/**
+ * @file sessionfile.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "sessionfile.h"
+
+#include <QFile>
+
+#include <cstring>
+#include <algorithm>
+
+using namespace FT1D;
+
+namespace
+{
+
+/**
+ * @brief The PendingSection struct is a section to be written, with its values
+ */
+struct PendingSection
+{
+    SessionSection section;
+    QVector<double> values;
+};
+
+
+/**
+ * @brief signalSection stores x coordinates and values of @a signal as one section
+ */
+PendingSection signalSection(SessionSectionType type, quint32 index, const Signal& signal)
+{
+    PendingSection pending;
+    std::memset(&pending.section, 0, sizeof(pending.section));
+    pending.section.type = type;
+    pending.section.index = index;
+    pending.section.count = static_cast<quint64>(signal.original.size());
+
+    const int count = signal.original.size();
+    pending.values.resize(2 * count);
+
+    int i = 0;
+    for(QMap<double, double>::const_iterator iter = signal.original.constBegin(); iter != signal.original.constEnd(); ++iter, ++i)
+    {
+        pending.values[i] = iter.key();
+        pending.values[count + i] = iter.value();
+    }
+    return pending;
+}
+
+
+inline quint64 aligned(quint64 offset)
+{
+    return (offset + FT1S_ALIGNMENT - 1) / FT1S_ALIGNMENT * FT1S_ALIGNMENT;
+}
+
+
+/**
+ * @brief valuesCount
+ * @return number of doubles stored for @a section
+ */
+inline quint64 valuesCount(const SessionSection& section)
+{
+    return section.type == SESSION_VIEW_RANGES ? section.count : 2 * section.count;
+}
+}
+
+
+bool SessionFile::write(const QString& path, const SessionState& state)
+{
+    QVector<PendingSection> sections;
+    sections.push_back(signalSection(SESSION_ORIGINAL, 0, state.original));
+    sections.push_back(signalSection(SESSION_MAGNITUDE, 0, state.magnitude));
+    sections.push_back(signalSection(SESSION_PHASE, 0, state.phase));
+    sections.push_back(signalSection(SESSION_FILTERED, 0, state.filtered));
+
+    for(int i = 0; i < state.history.size(); i++)
+    {
+        sections.push_back(signalSection(SESSION_HISTORY_MAGNITUDE, i, state.history[i].first));
+        sections.push_back(signalSection(SESSION_HISTORY_PHASE, i, state.history[i].second));
+    }
+
+    PendingSection ranges;
+    std::memset(&ranges.section, 0, sizeof(ranges.section));
+    ranges.section.type = SESSION_VIEW_RANGES;
+    ranges.section.count = static_cast<quint64>(state.viewRanges.size());
+    ranges.values = state.viewRanges;
+    sections.push_back(ranges);
+
+    SessionHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, FT1S_MAGIC, sizeof(FT1S_MAGIC));
+    header.version = FT1S_VERSION;
+    header.sectionCount = static_cast<quint32>(sections.size());
+    header.sampleRate = state.original.sample_rate;
+
+    // the values follow the section table, each section aligned
+    quint64 offset = aligned(FT1S_HEADER_SIZE + sections.size() * sizeof(SessionSection));
+    for(PendingSection& pending : sections)
+    {
+        pending.section.offset = offset;
+        offset = aligned(offset + pending.values.size() * sizeof(double));
+    }
+
+#if Q_BYTE_ORDER != Q_LITTLE_ENDIAN
+    // values are written as they are in memory
+    return false;
+#endif
+
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+            || file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header))
+    {
+        return false;
+    }
+
+    for(const PendingSection& pending : sections)
+    {
+        if(file.write(reinterpret_cast<const char*>(&pending.section), sizeof(SessionSection)) != sizeof(SessionSection))
+        {
+            return false;
+        }
+    }
+
+    for(const PendingSection& pending : sections)
+    {
+        const qint64 bytes = pending.values.size() * static_cast<qint64>(sizeof(double));
+        if(!file.seek(static_cast<qint64>(pending.section.offset))
+                || file.write(reinterpret_cast<const char*>(pending.values.constData()), bytes) != bytes)
+        {
+            return false;
+        }
+    }
+
+    // the file ends at the aligned end of the last section
+    return file.resize(static_cast<qint64>(offset));
+}
+
+
+bool SessionFile::read(const QString& path, SessionState& state)
+{
+#if Q_BYTE_ORDER != Q_LITTLE_ENDIAN
+    // values are mapped directly, they would have to be swapped
+    return false;
+#endif
+
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly) || file.size() < FT1S_HEADER_SIZE)
+    {
+        return false;
+    }
+
+    const quint64 size = static_cast<quint64>(file.size());
+    uchar* data = file.map(0, file.size());
+    if(!data)
+    {
+        return false;
+    }
+
+    const SessionHeader& header = *reinterpret_cast<const SessionHeader*>(data);
+    const SessionSection* sections = reinterpret_cast<const SessionSection*>(data + FT1S_HEADER_SIZE);
+
+    bool valid = std::memcmp(header.magic, FT1S_MAGIC, sizeof(FT1S_MAGIC)) == 0
+            && header.version >= 1 && header.version <= FT1S_VERSION
+            && FT1S_HEADER_SIZE + quint64(header.sectionCount) * sizeof(SessionSection) <= size;
+
+    // every section lies within the file and is aligned, the undo steps are complete
+    int historySize = 0;
+    for(quint32 i = 0; valid && i < header.sectionCount; i++)
+    {
+        const SessionSection& section = sections[i];
+        valid = section.offset % FT1S_ALIGNMENT == 0
+                && section.offset <= size
+                && section.count <= size / sizeof(double)
+                && valuesCount(section) <= (size - section.offset) / sizeof(double);
+
+        if(section.type == SESSION_HISTORY_MAGNITUDE || section.type == SESSION_HISTORY_PHASE)
+        {
+            historySize = std::max(historySize, static_cast<int>(section.index) + 1);
+            valid = valid && section.index < header.sectionCount;
+        }
+    }
+
+    if(!valid)
+    {
+        file.unmap(data);
+        return false;
+    }
+
+    SessionState restored;
+    restored.history.resize(historySize);
+
+    for(quint32 i = 0; i < header.sectionCount; i++)
+    {
+        const SessionSection& section = sections[i];
+        const double* values = reinterpret_cast<const double*>(data + section.offset);
+        const qint64 count = static_cast<qint64>(section.count);
+
+        Signal* target = nullptr;
+        switch(section.type)
+        {
+        case SESSION_ORIGINAL:
+            target = &restored.original;
+            break;
+        case SESSION_MAGNITUDE:
+            target = &restored.magnitude;
+            break;
+        case SESSION_PHASE:
+            target = &restored.phase;
+            break;
+        case SESSION_FILTERED:
+            target = &restored.filtered;
+            break;
+        case SESSION_HISTORY_MAGNITUDE:
+            target = &restored.history[section.index].first;
+            break;
+        case SESSION_HISTORY_PHASE:
+            target = &restored.history[section.index].second;
+            break;
+        case SESSION_VIEW_RANGES:
+            restored.viewRanges = QVector<double>(static_cast<int>(count));
+            std::copy(values, values + count, restored.viewRanges.begin());
+            break;
+        default:
+            // sections unknown to this version are skipped
+            break;
+        }
+
+        if(target)
+        {
+            target->set_samples(values, values + count, count);
+        }
+    }
+
+    // set_samples clears the sample rate
+    restored.original.sample_rate = header.version >= 2 && header.sampleRate > 0 ? header.sampleRate : 0;
+
+    file.unmap(data);
+    state = restored;
+    return true;
+}
+
+
+bool SessionFile::isSessionFile(const QString& path)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    char magic[sizeof(FT1S_MAGIC)];
+    return file.read(magic, sizeof(magic)) == sizeof(magic) && std::memcmp(magic, FT1S_MAGIC, sizeof(magic)) == 0;
+}
@@ -0,0 +1,128 @@
+#ifndef SESSIONFILE_H
+#define SESSIONFILE_H
+
+/**
+ * @file sessionfile.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of the session file format (.ft1s), which stores the whole working state.
+ */
+
+#include "signal.h"
+
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+namespace FT1D
+{
+
+// first eight bytes of every session file
+#define FT1S_MAGIC "FT1DSES"
+
+// current version of the format, files of newer versions are refused; version 2 added the sample rate
+#define FT1S_VERSION 2
+
+// the section table starts at this offset
+#define FT1S_HEADER_SIZE 64
+
+// every section starts at a multiple of this, so the mapped values are aligned
+#define FT1S_ALIGNMENT 64
+
+/**
+ * @brief The SessionSectionType enum denotes the content of a section of a session file
+ */
+enum SessionSectionType
+{
+    SESSION_ORIGINAL = 1,           // the original signal
+    SESSION_MAGNITUDE = 2,          // magnitudes of the current spectrum
+    SESSION_PHASE = 3,              // phases of the current spectrum
+    SESSION_FILTERED = 4,           // the filtered signal
+    SESSION_HISTORY_MAGNITUDE = 5,  // magnitudes of an undo step, index 0 is the oldest
+    SESSION_HISTORY_PHASE = 6,      // phases of an undo step, index 0 is the oldest
+    SESSION_VIEW_RANGES = 7         // visible ranges of the graphs, see SessionState::viewRanges
+};
+
+
+/**
+ * @brief The SessionHeader struct is the header of a session file. All values are little endian.
+ */
+struct SessionHeader
+{
+    char magic[8];          // FT1S_MAGIC, zero terminated
+    quint32 version;        // FT1S_VERSION
+    quint32 sectionCount;   // number of entries of the section table following the header
+    double sampleRate;      // Signal::sample_rate of the original signal, since version 2 (reserved and zero before)
+    char reserved[FT1S_HEADER_SIZE - 24];
+};
+
+static_assert(sizeof(SessionHeader) == FT1S_HEADER_SIZE, "unexpected size of the session header");
+
+
+/**
+ * @brief The SessionSection struct is an entry of the section table. A signal section contains count x coordinates
+ * followed by count values, other sections count values; all are doubles.
+ */
+struct SessionSection
+{
+    quint32 type;           // SessionSectionType
+    quint32 index;          // index of the undo step for history sections, 0 otherwise
+    quint64 offset;         // offset of the values from the start of the file, a multiple of FT1S_ALIGNMENT
+    quint64 count;          // number of samples
+    quint64 reserved;
+};
+
+static_assert(sizeof(SessionSection) == 32, "unexpected size of the session section");
+
+
+/**
+ * @brief The SessionState struct is the working state stored in a session file
+ */
+struct SessionState
+{
+    Signal original;
+    Signal magnitude;
+    Signal phase;
+    Signal filtered;
+
+    // magnitudes and phases of the undo steps, the oldest first
+    QVector<QPair<Signal, Signal> > history;
+
+    // x and y ranges of the graphs: x lower, x upper, y lower, y upper for each graph
+    QVector<double> viewRanges;
+};
+
+
+/**
+ * @brief The SessionFile class reads and writes session files. The file is memory mapped when read,
+ * the signals are filled directly from the mapped sections, nothing is parsed or transformed.
+ */
+class SessionFile
+{
+public:
+
+    /**
+     * @brief write writes @a state to @a path
+     * @param path path to the file
+     * @param state the working state
+     * @return true on success
+     */
+    static bool write(const QString& path, const SessionState& state);
+
+    /**
+     * @brief read reads a session file
+     * @param path path to the file
+     * @param state output, the working state; not changed if the file is not valid
+     * @return true, if the file is a valid session file
+     */
+    static bool read(const QString& path, SessionState& state);
+
+    /**
+     * @brief isSessionFile checks the magic bytes of a file
+     * @param path path to the file
+     * @return true, if the file starts with FT1S_MAGIC
+     */
+    static bool isSessionFile(const QString& path);
+};
+}
+#endif // SESSIONFILE_H
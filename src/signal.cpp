@@ -1,10 +1,18 @@
 #include "signal.h"
+#include "fftplan.h"
+#include "binarysignalfile.h"
+#include "compressedsignalfile.h"
+#include "signaltextparser.h"
+#include "audiofile.h"
+
+#include <QtConcurrent>
 
 #include <iostream>
 #include <fstream>
 #include <exception>
 #include <string>
 #include <sstream>
+#include <iomanip>
 #include <cmath>
 #include <limits>
 #include <algorithm>
@@ -15,13 +23,38 @@
 #include <utility>
 #include <iterator>
 #include <list>
+#include <numeric>
+#include <cctype>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+// kernels up to this length are convolved directly, longer ones using FFT
+#define DIRECT_CONVOLUTION_MAX_KERNEL 32
+
+// number of audio frames converted at once
+#define AUDIO_IMPORT_BLOCK 65536
+
+// inputs at least this long are convolved by several threads
+#define PARALLEL_CONVOLUTION_MIN_LENGTH 65536
+
 using namespace FT1D;
 
+namespace
+{
+
+/**
+ * @brief hasExtension checks, whether @a filename ends with @a extension, ignoring case
+ */
+bool hasExtension(const std::string& filename, const std::string& extension)
+{
+    return filename.size() >= extension.size()
+            && std::equal(extension.rbegin(), extension.rend(), filename.rbegin(),
+                          [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b)); });
+}
+}
+
 Signal::Signal()
 {
     copies_left = 0;
@@ -33,6 +66,7 @@ Signal::Signal()
     spacing = 1;
 
     original.clear();
+    sample_rate = 0;
 
     extended_x.clear();
     extended_y.clear();
@@ -41,6 +75,7 @@ Signal::Signal()
 
 Signal::Signal(const std::string& filename)
 {
+    sample_rate = 0;
     load_file(filename);
 
     copies_left = 0;
@@ -67,6 +102,7 @@ Signal::Signal(const QVector<double>& x, const QVector<double>& y)
     }
 
     original.clear();
+    sample_rate = 0;
 
     if(original_x.isEmpty())
     {
@@ -116,6 +152,7 @@ Signal::Signal(const Signal& other)
 {
     this->original = other.original;
     this->spacing = other.spacing;
+    this->sample_rate = other.sample_rate;
 
     this->extended_x = other.extended_x;
     this->extended_y = other.extended_y;
@@ -136,6 +173,7 @@ Signal Signal::operator=(const Signal& other)
 {
     this->original = other.original;
     this->spacing = other.spacing;
+    this->sample_rate = other.sample_rate;
 
     this->extended_x = other.extended_x;
     this->extended_y = other.extended_y;
@@ -164,42 +202,176 @@ void Signal::reset()
     extended_y = original.values().toVector();
 }
 
-bool Signal::load_file(const std::string& filename)
+void Signal::set_samples(const double* x, const double* y, qint64 count)
 {
-    ymax = std::numeric_limits<double>::min();
+    original.clear();
+    sample_rate = 0;
     ymin = std::numeric_limits<double>::max();
+    ymax = -std::numeric_limits<double>::max();
 
-    original.clear();
+    // keys are increasing, inserting at the end with a hint is amortized constant
+    for(qint64 i = 0; i < count; i++)
+    {
+        original.insert(original.constEnd(), x[i], y[i]);
+        ymin = std::min(ymin, y[i]);
+        ymax = std::max(ymax, y[i]);
+    }
 
-    std::ifstream file(filename);
-    if(!file.is_open())
+    if(original.isEmpty())
     {
-        return false;
+        spacing = 1;
+        ymin = -1;
+        ymax = 1;
+    }
+    else
+    {
+        spacing = count > 1 ? x[1] - x[0] : 1;
     }
 
-    while(file.good())
+    reset();
+}
+
+bool Signal::append_samples(const double* x, const double* y, qint64 count)
+{
+    double last = original.isEmpty() ? -std::numeric_limits<double>::infinity() : original.lastKey();
+    for(qint64 i = 0; i < count; i++)
     {
-        std::string line;
-        std::getline (file,line);
-        if(line.empty() || line[0] == '#')
+        if(!(x[i] > last))
         {
-            continue;
+            return false;
         }
+        last = x[i];
+    }
+
+    if(count == 0)
+    {
+        return true;
+    }
+
+    const int previous = original.size();
+    if(previous == 0)
+    {
+        ymin = std::numeric_limits<double>::max();
+        ymax = -std::numeric_limits<double>::max();
+    }
+
+    for(qint64 i = 0; i < count; i++)
+    {
+        original.insert(original.constEnd(), x[i], y[i]);
+        ymin = std::min(ymin, y[i]);
+        ymax = std::max(ymax, y[i]);
+    }
 
-        std::stringstream linestream(line);
-        double x;
-        double y;
+    // the spacing is given by the first two samples
+    if(previous < 2 && original.size() > 1)
+    {
+        spacing = (original.constBegin() + 1).key() - original.firstKey();
+    }
 
-        if (!(linestream >> x))
+    // without copies the extended signal is the original one, so it is extended as well
+    if(copies_left == 0 && copies_right == 0)
+    {
+        for(qint64 i = 0; i < count; i++)
         {
-            return false;
+            extended_x.push_back(x[i]);
+            extended_y.push_back(y[i]);
         }
-        if (!(linestream >> y))
+    }
+    else
+    {
+        reset();
+    }
+    return true;
+}
+
+Signal Signal::trailing(int count) const
+{
+    QVector<double> x, y;
+    x.reserve(std::min(count, original.size()));
+    y.reserve(std::min(count, original.size()));
+
+    QMap<double, double>::const_iterator iter = original.constEnd();
+    for(int i = 0; i < count && iter != original.constBegin(); i++)
+    {
+        --iter;
+    }
+    for(; iter != original.constEnd(); ++iter)
+    {
+        x.push_back(iter.key());
+        y.push_back(iter.value());
+    }
+
+    Signal result;
+    result.set_samples(x.constData(), y.constData(), x.size());
+    return result;
+}
+
+bool Signal::load_file(const std::string& filename, std::string* error)
+{
+    if(BinarySignalFile::isBinarySignalFile(QString::fromStdString(filename)))
+    {
+        const bool result = load_binary_file(filename);
+        if(!result && error)
         {
-            return false;
+            *error = "invalid binary signal file " + filename;
+        }
+        return result;
+    }
+
+    if(CompressedSignalFile::isCompressedSignalFile(QString::fromStdString(filename)))
+    {
+        const bool result = load_compressed_file(filename);
+        if(!result && error)
+        {
+            *error = "invalid compressed signal file " + filename;
+        }
+        return result;
+    }
+
+    if(AudioFile::isWavFile(QString::fromStdString(filename)))
+    {
+        AudioFile audio;
+        const bool result = audio.openWav(QString::fromStdString(filename)) && load_audio(audio, 0);
+        if(!result && error)
+        {
+            *error = "unsupported WAV file " + filename;
         }
+        return result;
+    }
+
+    QVector<double> xs;
+    QVector<double> ys;
+    SignalParseError parseError;
+
+    if(!SignalTextParser::parseFile(filename, xs, ys, parseError))
+    {
+        if(error)
+        {
+            *error = parseError.toString();
+        }
+        return false;
+    }
+
+    ymax = -std::numeric_limits<double>::max();
+    ymin = std::numeric_limits<double>::max();
+
+    original.clear();
+    sample_rate = 0;
+
+    for(int i = 0; i < xs.size(); i++)
+    {
+        const double x = xs[i];
+        const double y = ys[i];
 
-        original.insert(x,y);
+        // files are usually sorted, appending with a hint avoids searching the map
+        if(original.isEmpty() || x > (original.constEnd() - 1).key())
+        {
+            original.insert(original.constEnd(), x, y);
+        }
+        else
+        {
+            original.insert(x, y);
+        }
 
         if(y > ymax)
         {
@@ -209,11 +381,6 @@ bool Signal::load_file(const std::string& filename)
         {
             ymin = y;
         }
-
-        if(linestream >> x)
-        {
-            return false;
-        }
     }
 
     if(original.isEmpty())
@@ -246,17 +413,260 @@ bool Signal::load_file(const std::string& filename)
     return true;
 }
 
+bool Signal::load_binary_file(const std::string& filename, bool verify)
+{
+    BinarySignalFile file;
+    if(!file.open(QString::fromStdString(filename)) || file.isComplex() || (verify && !file.verify()))
+    {
+        return false;
+    }
+
+    const qint64 count = file.count();
+    const double x0 = file.header().x0;
+    const double step = file.header().spacing;
+
+    original.clear();
+    sample_rate = 0;
+    ymin = std::numeric_limits<double>::max();
+    ymax = -std::numeric_limits<double>::max();
+
+    // keys are increasing, inserting at the end with a hint is amortized constant
+    for(qint64 i = 0; i < count; i++)
+    {
+        const double y = file.sample(i);
+        original.insert(original.constEnd(), x0 + i * step, y);
+        ymin = std::min(ymin, y);
+        ymax = std::max(ymax, y);
+    }
+
+    if(original.isEmpty())
+    {
+        spacing = 1;
+        ymin = -1;
+        ymax = 1;
+    }
+    else
+    {
+        spacing = count > 1 ? step : 1;
+    }
+
+    reset();
+
+    return true;
+}
+
+
+bool Signal::load_compressed_file(const std::string& filename)
+{
+    CompressedSignalFile file;
+    if(!file.open(QString::fromStdString(filename)))
+    {
+        return false;
+    }
+
+    const qint64 count = file.count();
+    const double x0 = file.header().x0;
+    const double step = file.header().spacing;
+
+    QVector<double> y(static_cast<int>(count));
+    if(!file.readAll(y.data()))
+    {
+        return false;
+    }
+
+    original.clear();
+    sample_rate = 0;
+    ymin = std::numeric_limits<double>::max();
+    ymax = -std::numeric_limits<double>::max();
+
+    for(int i = 0; i < y.size(); i++)
+    {
+        original.insert(original.constEnd(), x0 + i * step, y[i]);
+        ymin = std::min(ymin, y[i]);
+        ymax = std::max(ymax, y[i]);
+    }
+
+    if(original.isEmpty())
+    {
+        spacing = 1;
+        ymin = -1;
+        ymax = 1;
+    }
+    else
+    {
+        spacing = count > 1 ? step : 1;
+    }
+
+    reset();
+
+    return true;
+}
+
+
+bool Signal::load_audio(const AudioFile& audio, int channel)
+{
+    if(!audio.isOpen() || channel >= audio.channels())
+    {
+        return false;
+    }
+
+    const qint64 count = audio.frames();
+    const double step = 1.0 / audio.sampleRate();
+
+    original.clear();
+    sample_rate = audio.sampleRate();
+    ymin = std::numeric_limits<double>::max();
+    ymax = -std::numeric_limits<double>::max();
+
+    // samples are converted block by block, the file itself stays mapped
+    QVector<double> block(AUDIO_IMPORT_BLOCK);
+    for(qint64 first = 0; first < count; first += AUDIO_IMPORT_BLOCK)
+    {
+        const qint64 size = audio.read(first, AUDIO_IMPORT_BLOCK, channel, block.data());
+        for(qint64 i = 0; i < size; i++)
+        {
+            const double y = block[static_cast<int>(i)];
+            original.insert(original.constEnd(), (first + i) * step, y);
+            ymin = std::min(ymin, y);
+            ymax = std::max(ymax, y);
+        }
+    }
+
+    if(original.isEmpty())
+    {
+        spacing = 1;
+        ymin = -1;
+        ymax = 1;
+    }
+    else
+    {
+        spacing = step;
+    }
+
+    reset();
+
+    return true;
+}
+
+
+bool Signal::uniform_samples(QVector<double>& y, double& x0, double& step) const
+{
+    const QVector<double> x = original.keys().toVector();
+    y = original.values().toVector();
+
+    // binary formats store only the first x coordinate and the spacing
+    x0 = x.isEmpty() ? 0 : x[0];
+    step = x.size() > 1 ? x[1] - x[0] : 1;
+    for(int i = 2; i < x.size(); i++)
+    {
+        if(std::abs(x[i] - x[i - 1] - step) > 1e-9 * std::max(1.0, std::abs(step)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool Signal::save_binary_file(const std::string& filename) const
+{
+    QVector<double> y;
+    double x0, step;
+    return uniform_samples(y, x0, step) && BinarySignalFile::write(QString::fromStdString(filename), x0, step, y.constData(), y.size());
+}
+
+
+bool Signal::save_compressed_file(const std::string& filename, CompressedSignalCoding coding) const
+{
+    QVector<double> y;
+    double x0, step;
+    return uniform_samples(y, x0, step) && CompressedSignalFile::write(QString::fromStdString(filename), x0, step, y.constData(), y.size(), coding);
+}
+
+
+bool Signal::convert_file(const std::string& input, const std::string& output)
+{
+    if(CompressedSignalFile::isCompressedSignalFile(QString::fromStdString(input)))
+    {
+        Signal signal;
+        return signal.load_compressed_file(input) && signal.save_file(output);
+    }
+
+    if(!BinarySignalFile::isBinarySignalFile(QString::fromStdString(input)))
+    {
+        Signal signal;
+        if(!signal.load_file(input))
+        {
+            return false;
+        }
+        return hasExtension(output, ".ft1z") ? signal.save_compressed_file(output) : signal.save_binary_file(output);
+    }
+
+    BinarySignalFile file;
+    if(!file.open(QString::fromStdString(input)))
+    {
+        return false;
+    }
+
+    std::ofstream text(output);
+    if(!text.is_open())
+    {
+        return false;
+    }
+
+    // enough digits to read back the same doubles
+    text << std::setprecision(std::numeric_limits<double>::max_digits10);
+    text << "# Function file generated by FTutor1D" << '\n';
+
+    const qint64 count = file.count();
+    const double x0 = file.header().x0;
+    const double step = file.header().spacing;
+
+    if(file.isComplex())
+    {
+        // exported spectra, the real and the imaginary part in two columns
+        const double* values = reinterpret_cast<const double*>(file.samples());
+        for(qint64 i = 0; i < count && text.good(); i++)
+        {
+            text << x0 + i * step << ' ' << values[2 * i] << ' ' << values[2 * i + 1] << '\n';
+        }
+    }
+    else
+    {
+        for(qint64 i = 0; i < count && text.good(); i++)
+        {
+            text << x0 + i * step << ' ' << file.sample(i) << '\n';
+        }
+    }
+
+    text.close();
+    return !text.fail();
+}
+
+
 bool Signal::save_file(const  std::string& filename) const
 {
+    if(hasExtension(filename, ".ft1b"))
+    {
+        return save_binary_file(filename);
+    }
+    if(hasExtension(filename, ".ft1z"))
+    {
+        return save_compressed_file(filename);
+    }
+
     std::ofstream file(filename);
     if(!file.is_open())
     {
         return false;
     }
 
+    // enough digits to read back the same doubles
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
+
     if(file.good())
     {
-        file << "# Function file generated by FTutor1D" << std::endl;
+        file << "# Function file generated by FTutor1D" << '\n';
     }
     else return false;
 
@@ -265,7 +675,7 @@ bool Signal::save_file(const  std::string& filename) const
     {
         if(file.good())
         {
-            file << iter.key() << " " << iter.value() << std::endl;
+            file << iter.key() << " " << iter.value() << '\n';
         }
         else return false;
     }
@@ -280,14 +690,23 @@ void Signal::extend_left()
 {
     if(original_length() == 0) return;
 
-    QVector<double> sig_x = original.keys().toVector();
+    // the copy is prepended at once, prepending sample by sample would move the whole extended signal for each of them
+    const double shift = (copies_left + 1) * (original_range_x() + spacing);
+    QVector<double> copy_x;
+    QVector<double> copy_y;
+    copy_x.reserve(original_length() + extended_x.size());
+    copy_y.reserve(original_length() + extended_y.size());
 
-    for(int i = original_length(); i > 0; i--)
+    for(QMap<double, double>::const_iterator iter = original.constBegin(); iter != original.constEnd(); ++iter)
     {
-        extended_x.push_front(sig_x[i - 1] - (copies_left + 1) * (original_range_x() + spacing));
-        extended_y.push_front(original[sig_x[i - 1]]);
+        copy_x.push_back(iter.key() - shift);
+        copy_y.push_back(iter.value());
     }
+    copy_x += extended_x;
+    copy_y += extended_y;
 
+    extended_x.swap(copy_x);
+    extended_y.swap(copy_y);
     copies_left++;
 }
 
@@ -296,12 +715,14 @@ void Signal::extend_right()
 {
     if(original_length() == 0) return;
 
-    QVector<double> sig_x = original.keys().toVector();
+    const double shift = (copies_right + 1) * (original_range_x() + spacing);
+    extended_x.reserve(extended_x.size() + original_length());
+    extended_y.reserve(extended_y.size() + original_length());
 
-    for(int i = 0; i < original_length(); i++)
+    for(QMap<double, double>::const_iterator iter = original.constBegin(); iter != original.constEnd(); ++iter)
     {
-        extended_x.push_back(sig_x[i] + (copies_right + 1) * (original_range_x() + spacing));
-        extended_y.push_back(original[sig_x[i]]);
+        extended_x.push_back(iter.key() + shift);
+        extended_y.push_back(iter.value());
     }
     copies_right++;
 }
@@ -310,11 +731,8 @@ void Signal::extend_right()
 void Signal::shrink_left()
 {
     if(original_length() == 0) return;
-    for(int i = 0; i < original_length(); i++)
-    {
-        extended_x.pop_front();
-        extended_y.pop_front();
-    }
+    extended_x.remove(0, original_length());
+    extended_y.remove(0, original_length());
     copies_left--;
 }
 
@@ -322,11 +740,8 @@ void Signal::shrink_left()
 void Signal::shrink_right()
 {
     if(original_length() == 0) return;
-    for(int i = 0; i < original_length(); i++)
-    {
-        extended_x.pop_back();
-        extended_y.pop_back();
-    }
+    extended_x.remove(extended_x.size() - original_length(), original_length());
+    extended_y.remove(extended_y.size() - original_length(), original_length());
     copies_right--;
 }
 
@@ -541,6 +956,44 @@ void Signal::fourierTransform(Signal& input, Signal& magnitudeSignal, Signal& ph
     phaseSignal.reset();
 }
 
+QVector<double> Signal::interpolatedSpectrum(const Signal& input, int factor)
+{
+    QVector<double> result;
+    if(input.empty() || factor < 1)
+    {
+        return result;
+    }
+
+    const QVector<double> values = input.original.values().toVector();
+    const int length = values.size();
+    const int paddedLength = length * factor;
+
+    const FFTPlan plan(length);
+    const double normalization = 1.0 / sqrt(length);
+
+    result.resize(paddedLength);
+    QVector<std::complex<double> > buffer(length);
+
+    // X[k * factor + r] = sum_n (x[n] exp(-2 pi i n r / paddedLength)) exp(-2 pi i n k / length)
+    for(int r = 0; r < factor; r++)
+    {
+        for(int n = 0; n < length; n++)
+        {
+            const long long angle = (static_cast<long long>(n) * r) % paddedLength;
+            buffer[n] = values[n] * std::polar(1.0, -2.0 * M_PI * angle / paddedLength);
+        }
+
+        plan.forward(buffer.data());
+
+        for(int k = 0; k < length; k++)
+        {
+            result[k * factor + r] = std::abs(buffer[k]) * normalization;
+        }
+    }
+    return result;
+}
+
+
 void Signal::inverseFourierTransform(Signal& magnitude, Signal& phase, Signal& output, QVector<double> x)
 {
     output.clear();
@@ -605,7 +1058,7 @@ Signal Signal::applyFilter(Signal& filter) const
 
     QMap<double,double>::const_iterator inputIterator;
     QMap<double,double>::const_iterator filterIterator;
-    for(inputIterator = this->original.begin(), filterIterator = filter.original.begin(); inputIterator != this->original.end(); inputIterator++, filterIterator++)
+    for(inputIterator = this->original.constBegin(), filterIterator = filter.original.constBegin(); inputIterator != this->original.constEnd(); inputIterator++, filterIterator++)
     {
         double value = inputIterator.value() * filterIterator.value();
         filteredSignal.original.insert(inputIterator.key(), value);
@@ -633,6 +1086,255 @@ Signal Signal::applyFilter(Signal& filter) const
     return filteredSignal;
 }
 
+bool Signal::applyFilterInPlace(const QVector<double>& gains)
+{
+    const int length = original_length();
+    if(gains.size() != length)
+    {
+        return false;
+    }
+    if(length == 0)
+    {
+        return true;
+    }
+
+    const int copies = copies_left + 1 + copies_right;
+    if(extended_y.size() != copies * length)
+    {
+        // extended part is out of sync with the original, rebuild it with the same number of copies
+        const int left = copies_left;
+        const int right = copies_right;
+        reset();
+        for(int i = 0; i < left; i++)
+        {
+            extend_left();
+        }
+        for(int i = 0; i < right; i++)
+        {
+            extend_right();
+        }
+    }
+
+    // the original part is stored contiguously in the extended values, between the left and the right copies
+    double* values = extended_y.data() + copies_left * length;
+    const double* g = gains.constData();
+
+    double newMax = -std::numeric_limits<double>::max();
+    double newMin = std::numeric_limits<double>::max();
+
+    for(int i = 0; i < length; i++)
+    {
+        const double value = values[i] * g[i];
+        values[i] = value;
+        newMax = value > newMax ? value : newMax;
+        newMin = value < newMin ? value : newMin;
+    }
+
+    ymax = newMax;
+    ymin = newMin;
+
+    double* extended = extended_y.data();
+    for(int copy = 0; copy < copies; copy++)
+    {
+        if(copy != copies_left)
+        {
+            std::copy(values, values + length, extended + copy * length);
+        }
+    }
+
+    int i = 0;
+    for(QMap<double,double>::iterator iter = original.begin(); iter != original.end(); iter++, i++)
+    {
+        iter.value() = values[i];
+    }
+
+    return true;
+}
+
+Signal Signal::convolve(const Signal& kernel) const
+{
+    if(this->empty() || kernel.empty())
+    {
+        return *this;
+    }
+
+    QVector<double> kernelValues = kernel.original.values().toVector();
+
+    // output sample n is aligned with the middle of the kernel
+    const int center = (kernelValues.size() - 1) / 2;
+
+    QVector<double> result = convolution(original.values().toVector(), kernelValues, center, original_length());
+
+    Signal convolved(original.keys().toVector(), result);
+    convolved.spacing = this->spacing;
+    return convolved;
+}
+
+Signal Signal::correlate(const Signal& kernel) const
+{
+    if(this->empty() || kernel.empty())
+    {
+        return *this;
+    }
+
+    // correlation is the convolution with reversed kernel
+    QVector<double> kernelValues = kernel.original.values().toVector();
+    std::reverse(kernelValues.begin(), kernelValues.end());
+
+    const int center = kernelValues.size() - 1 - (kernelValues.size() - 1) / 2;
+
+    QVector<double> result = convolution(original.values().toVector(), kernelValues, center, original_length());
+
+    Signal correlated(original.keys().toVector(), result);
+    correlated.spacing = this->spacing;
+    return correlated;
+}
+
+QVector<double> Signal::convolution(const QVector<double>& input, const QVector<double>& kernel, int start, int count)
+{
+    if(kernel.size() <= DIRECT_CONVOLUTION_MAX_KERNEL)
+    {
+        return directConvolution(input, kernel, start, count);
+    }
+    return overlapSaveConvolution(input, kernel, start, count);
+}
+
+QVector<double> Signal::directConvolution(const QVector<double>& input, const QVector<double>& kernel, int start, int count)
+{
+    QVector<double> output(count, 0.0);
+
+    const double* x = input.constData();
+    const double* h = kernel.constData();
+    const int inputLength = input.size();
+    const int kernelLength = kernel.size();
+
+    for(int i = 0; i < count; i++)
+    {
+        const int o = start + i;
+
+        // only kernel indices k with 0 <= o - k < inputLength contribute
+        const int first = std::max(0, o - inputLength + 1);
+        const int last = std::min(kernelLength - 1, o);
+
+        double sum = 0;
+        for(int k = first; k <= last; k++)
+        {
+            sum += h[k] * x[o - k];
+        }
+        output[i] = sum;
+    }
+    return output;
+}
+
+QVector<double> Signal::overlapSaveConvolution(const QVector<double>& input, const QVector<double>& kernel, int start, int count)
+{
+    QVector<double> output(count, 0.0);
+
+    const int inputLength = input.size();
+    const int kernelLength = kernel.size();
+
+    const int fftLength = convolutionBlockLength(kernelLength, count);
+    const FFTPlan plan(fftLength);
+
+    // every block yields this many valid output samples, the first kernelLength - 1 are wrapped around
+    const int blockLength = fftLength - kernelLength + 1;
+    const int blockCount = (count + blockLength - 1) / blockLength;
+
+    // spectrum of the kernel, scaled by the normalization of the inverse transform
+    QVector<std::complex<double> > kernelSpectrum(fftLength);
+    for(int k = 0; k < kernelLength; k++)
+    {
+        kernelSpectrum[k] = kernel[k] / fftLength;
+    }
+    plan.forward(kernelSpectrum.data());
+
+    const double* x = input.constData();
+    double* y = output.data();
+    const std::complex<double>* spectrum = kernelSpectrum.constData();
+
+    // the kernel is real, so two real blocks are transformed at once, one in the real and one in the imaginary part
+    auto processBlockPair = [&](int pair)
+    {
+        QVector<std::complex<double> > buffer(fftLength);
+        std::complex<double>* data = buffer.data();
+
+        const int firstBlock = 2 * pair;
+        const int secondBlock = firstBlock + 1;
+
+        for(int t = 0; t < fftLength; t++)
+        {
+            const int i1 = start + firstBlock * blockLength - (kernelLength - 1) + t;
+            const int i2 = i1 + blockLength;
+
+            const double re = (i1 >= 0 && i1 < inputLength) ? x[i1] : 0.0;
+            const double im = (secondBlock < blockCount && i2 >= 0 && i2 < inputLength) ? x[i2] : 0.0;
+            data[t] = std::complex<double>(re, im);
+        }
+
+        plan.forward(data);
+        for(int t = 0; t < fftLength; t++)
+        {
+            data[t] *= spectrum[t];
+        }
+        plan.inverse(data);
+
+        for(int j = 0; j < blockLength; j++)
+        {
+            const int o1 = firstBlock * blockLength + j;
+            const int o2 = o1 + blockLength;
+
+            if(o1 < count)
+            {
+                y[o1] = data[kernelLength - 1 + j].real();
+            }
+            if(secondBlock < blockCount && o2 < count)
+            {
+                y[o2] = data[kernelLength - 1 + j].imag();
+            }
+        }
+    };
+
+    const int pairCount = (blockCount + 1) / 2;
+
+    if(inputLength >= PARALLEL_CONVOLUTION_MIN_LENGTH && pairCount > 1)
+    {
+        // blocks write disjoint parts of the output, so they can be processed in any order
+        QVector<int> pairs(pairCount);
+        std::iota(pairs.begin(), pairs.end(), 0);
+        QtConcurrent::blockingMap(pairs, [&](const int& pair) { processBlockPair(pair); });
+    }
+    else
+    {
+        for(int pair = 0; pair < pairCount; pair++)
+        {
+            processBlockPair(pair);
+        }
+    }
+
+    return output;
+}
+
+int Signal::convolutionBlockLength(int kernelLength, int outputLength)
+{
+    // no point in blocks longer than the whole output plus the wrapped part
+    const int longest = FFTPlan::nextPowerOfTwo(outputLength + kernelLength - 1);
+
+    int best = FFTPlan::nextPowerOfTwo(2 * kernelLength);
+    double bestCost = std::numeric_limits<double>::max();
+
+    for(int length = best; length <= std::max(longest, best) && length <= (1 << 24); length *= 2)
+    {
+        // cost of forward and inverse transform per valid output sample
+        const double cost = length * std::log2(static_cast<double>(length)) / (length - kernelLength + 1);
+        if(cost < bestCost)
+        {
+            bestCost = cost;
+            best = length;
+        }
+    }
+    return best;
+}
+
 void Signal::ensureComplexConjugateness(QVector<double> &magnitude, QVector<double> &phase)
 {
     int n = magnitude.size();
@@ -726,5 +1428,6 @@ void  Signal::findYMinMax()
 void Signal::clear()
 {
     original.clear();
+    sample_rate = 0;
     reset();
 }
@@ -6,6 +6,8 @@
  * @author Ján Bella <xbella1@fi.muni.cz>
  */
 
+#include "compressedsignalfile.h"
+
 #include <QVector>
 #include <QMap>
 
@@ -15,6 +17,9 @@
 
 namespace FT1D
 {
+
+class AudioFile;
+
 /**
  * @brief The Signal class represents a signal
  */
@@ -43,6 +48,9 @@ public:
     // x-axis distance between two consecutive points
     double spacing;
 
+    // samples per second of a signal loaded from audio, whose x coordinates are in seconds; 0 for other signals
+    double sample_rate;
+
     /**
      * Constructor, creates an empty signal
      **/
@@ -75,19 +83,97 @@ public:
     Signal operator=(const Signal& other);
 
     /**
-     * @brief load_file loads signal from the given file.
+     * @brief set_samples replaces the signal by @a count samples, the x coordinates must be increasing
+     * @param x x coordinates
+     * @param y values
+     * @param count number of samples
+     */
+    void set_samples(const double* x, const double* y, qint64 count);
+
+    /**
+     * @brief append_samples appends @a count samples after the last sample of the signal
+     * @param x x coordinates, increasing and greater than the x coordinate of the last sample
+     * @param y values
+     * @param count number of samples
+     * @return false, if the x coordinates do not follow the signal; nothing is appended then
+     */
+    bool append_samples(const double* x, const double* y, qint64 count);
+
+    /**
+     * @brief trailing
+     * @param count number of samples
+     * @return signal of the last @a count samples, the whole signal if it is shorter
+     */
+    Signal trailing(int count) const;
+
+    /**
+     * @brief load_file loads signal from the given file. Binary and compressed signal files and WAV files (the first channel) are recognized
+     * by their header, any other file is read as a text file.
      * @param filename path to the file to load
+     * @param error if not null, receives description of the problem including its line and column
      * @return true in case of success, false otherwise (e.g. when the file format is invalid)
      */
-    bool load_file(const std::string& filename);
+    bool load_file(const std::string& filename, std::string* error = nullptr);
 
     /**
-     * @brief save_file saves signal to the specified file
+     * @brief save_file saves signal to the specified file. Files ending with .ft1b are binary signal files,
+     * files ending with .ft1z compressed signal files, any other file is a text file.
      * @param filename where to save the signal
      * @return true in case of success
      */
     bool save_file(const  std::string& filename) const;
 
+    /**
+     * @brief load_binary_file loads signal from a memory mapped binary signal file (.ft1b), without any parsing.
+     * Only the header and the size of the file are checked, unless @a verify is set.
+     * @param filename path to the file to load
+     * @param verify true to compare the checksum of the samples too, which reads the whole file once more
+     * @return true in case of success, false if the file is not a valid binary signal file or its checksum does not match
+     */
+    bool load_binary_file(const std::string& filename, bool verify = false);
+
+    /**
+     * @brief load_compressed_file loads signal from a compressed signal file (.ft1z), the blocks are decompressed in parallel
+     * @param filename path to the file to load
+     * @return true in case of success, false if the file is not a valid compressed signal file or a block is damaged
+     */
+    bool load_compressed_file(const std::string& filename);
+
+    /**
+     * @brief load_audio loads one channel of an audio file. The x coordinates are in seconds, spacing is 1 / sample rate,
+     * so frequencies are in Hz. sample_rate is set to the rate of the file.
+     * @param audio an open audio file
+     * @param channel channel to load, -1 for the average of all channels
+     * @return true in case of success
+     */
+    bool load_audio(const AudioFile& audio, int channel);
+
+    /**
+     * @brief save_binary_file saves signal to the specified binary signal file (.ft1b)
+     * @param filename where to save the signal
+     * @return true in case of success, false also if the signal is not sampled uniformly
+     */
+    bool save_binary_file(const std::string& filename) const;
+
+    /**
+     * @brief save_compressed_file saves signal to the specified compressed signal file (.ft1z)
+     * @param filename where to save the signal
+     * @param coding prediction applied to the samples before compression
+     * @return true in case of success, false also if the signal is not sampled uniformly
+     */
+    bool save_compressed_file(const std::string& filename, CompressedSignalCoding coding = FT1Z_XOR) const;
+
+    /**
+     * @brief convert_file converts a binary or compressed signal file to a text file, or any other signal file to a binary
+     * signal file; to a compressed signal file, if @a output ends with .ft1z.
+     * A binary file is streamed from the mapping directly to the text file, without constructing a signal.
+     * Complex binary files (exported spectra) are written with the real and the imaginary part in two columns.
+     * @param input path to the file to convert
+     * @param output path to the converted file
+     * @return true in case of success
+     */
+    static bool convert_file(const std::string& input, const std::string& output);
+
     /**
      * @brief x obtain all x-coordinates
      * @return
@@ -306,6 +392,31 @@ public:
      */
     Signal applyFilter(Signal& filter) const;
 
+    /**
+     * @brief applyFilterInPlace multiplies the signal by filter values @a gains, without constructing an intermediate signal.
+     * The original part of the extended values is multiplied and the y extrema are found in one pass, then it is copied
+     * to the other copies and written back to the original values.
+     * @param gains filter values, one for each point of the original part of the signal
+     * @return false if the length of @a gains differs from the length of the signal, true otherwise
+     */
+    bool applyFilterInPlace(const QVector<double>& gains);
+
+    /**
+     * @brief convolve computes the convolution of this signal with @a kernel. The result has the same x coordinates as this signal,
+     * the kernel is centered at its middle sample and the signal is extended by zeros on both sides.
+     * @param kernel convolution kernel, only its values are used
+     * @return result of the convolution
+     */
+    Signal convolve(const Signal& kernel) const;
+
+    /**
+     * @brief correlate computes the cross-correlation of this signal with @a kernel. The result has the same x coordinates as this signal,
+     * the kernel is centered at its middle sample and the signal is extended by zeros on both sides.
+     * @param kernel correlation kernel, only its values are used
+     * @return result of the correlation
+     */
+    Signal correlate(const Signal& kernel) const;
+
     /**
      * @brief fourierTransform computes the fourier transform of signal @a input
      * @param input signal for which to compute the transform
@@ -314,6 +425,16 @@ public:
      */
     static void fourierTransform(Signal& input, Signal& magnitude, Signal& phase);
 
+    /**
+     * @brief interpolatedSpectrum computes magnitudes of the fourier transform of signal @a input zero-padded to @a factor times its length.
+     * The padded transform is evaluated by a pruned FFT, as @a factor transforms of the original length, which skip the padding.
+     * Values are normalized as in fourierTransform, so every @a factor -th value is the magnitude of a fourier coefficient of @a input.
+     * @param input signal for which to compute the spectrum
+     * @param factor zero-padding factor, value at index i belongs to frequency i / factor
+     * @return factor * original_length() magnitudes, empty if the signal is empty
+     */
+    static QVector<double> interpolatedSpectrum(const Signal& input, int factor);
+
     /**
      * @brief inverseFourierTransform computes the inverse fourier transform of signal @a magnitude and @a phase
      * @param magnitude signal of magnitudes of the fourier coefficients (input)
@@ -326,6 +447,15 @@ public:
 
 private:
 
+    /**
+     * @brief uniform_samples gets the samples of a uniformly sampled signal, as stored in binary and compressed files
+     * @param y output, the values
+     * @param x0 output, the x coordinate of the first sample
+     * @param step output, the x distance of two consecutive samples
+     * @return false, if the signal is not sampled uniformly
+     */
+    bool uniform_samples(QVector<double>& y, double& x0, double& step) const;
+
     /**
      * @brief fft computes the fourier transform using the fast fourier transform algorithm
      * @param input real input signal
@@ -378,6 +508,35 @@ private:
      */
     static void ensureComplexConjugateness(QVector<double> &magnitude, QVector<double> &phase);
 
+    /**
+     * @brief convolution computes @a count samples of the full linear convolution of @a input and @a kernel, starting at index @a start.
+     * Small kernels are convolved directly, larger ones by FFT using the overlap-save method.
+     * @param input input values
+     * @param kernel kernel values
+     * @param start index of the first output sample in the full convolution (of length input.size() + kernel.size() - 1)
+     * @param count number of output samples
+     * @return computed part of the convolution
+     */
+    static QVector<double> convolution(const QVector<double>& input, const QVector<double>& kernel, int start, int count);
+
+    /**
+     * @brief directConvolution computes the convolution by definition, parameters are the same as for convolution()
+     */
+    static QVector<double> directConvolution(const QVector<double>& input, const QVector<double>& kernel, int start, int count);
+
+    /**
+     * @brief overlapSaveConvolution computes the convolution block by block using FFT, parameters are the same as for convolution()
+     */
+    static QVector<double> overlapSaveConvolution(const QVector<double>& input, const QVector<double>& kernel, int start, int count);
+
+    /**
+     * @brief convolutionBlockLength picks the FFT length for overlap-save, which minimizes the work per output sample
+     * @param kernelLength length of the kernel
+     * @param outputLength number of samples to compute
+     * @return power of two FFT length
+     */
+    static int convolutionBlockLength(int kernelLength, int outputLength);
+
 };
 }
 #endif // SIGNAL_H
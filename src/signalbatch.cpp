@@ -0,0 +1,285 @@
+/**
+ * @file signalbatch.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "signalbatch.h"
+
+#include <QFile>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+using namespace FT1D;
+
+namespace
+{
+
+inline bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+
+/**
+ * @brief The CsvField struct is one field of a row, without the surrounding blanks and quotes
+ */
+struct CsvField
+{
+    const char* begin;
+    const char* end;
+};
+
+
+/**
+ * @brief splitRow splits the row @a begin .. @a end at @a delimiter, or at runs of blanks if @a delimiter is 0
+ */
+void splitRow(const char* begin, const char* end, char delimiter, QVector<CsvField>& fields)
+{
+    fields.clear();
+
+    const char* p = begin;
+    while(p <= end)
+    {
+        const char* fieldEnd;
+        if(delimiter)
+        {
+            fieldEnd = static_cast<const char*>(std::memchr(p, delimiter, end - p));
+            if(!fieldEnd)
+            {
+                fieldEnd = end;
+            }
+        }
+        else
+        {
+            while(p < end && isBlank(*p))
+            {
+                p++;
+            }
+            if(p == end)
+            {
+                break;
+            }
+            fieldEnd = p;
+            while(fieldEnd < end && !isBlank(*fieldEnd))
+            {
+                fieldEnd++;
+            }
+        }
+
+        CsvField field = {p, fieldEnd};
+        while(field.begin < field.end && isBlank(*field.begin))
+        {
+            field.begin++;
+        }
+        while(field.end > field.begin && isBlank(field.end[-1]))
+        {
+            field.end--;
+        }
+        if(field.end - field.begin >= 2 && *field.begin == '"' && field.end[-1] == '"')
+        {
+            field.begin++;
+            field.end--;
+        }
+        fields.push_back(field);
+
+        p = fieldEnd + 1;
+    }
+}
+}
+
+
+bool SignalBatch::load_csv(const std::string& filename, std::string* error)
+{
+    SignalParseError parseError;
+
+    QFile file(QString::fromStdString(filename));
+    if(!file.open(QIODevice::ReadOnly) || file.size() == 0)
+    {
+        if(error)
+        {
+            *error = "cannot read " + filename;
+        }
+        return false;
+    }
+
+    const qint64 size = file.size();
+    const uchar* mapped = file.map(0, size);
+    QByteArray bytes;
+    if(!mapped)
+    {
+        bytes = file.readAll();
+    }
+    const char* data = mapped ? reinterpret_cast<const char*>(mapped) : bytes.constData();
+    const char* end = data + size;
+
+    // column 0 is x, the others are channels; filled row by row, each column stays contiguous
+    QVector<QVector<double> > columns;
+    QStringList header;
+    QVector<CsvField> fields;
+
+    char delimiter = 0;
+    bool firstRow = true;
+    qint64 line = 0;
+
+    const char* p = data;
+    while(p < end && parseError.line == 0)
+    {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if(!lineEnd)
+        {
+            lineEnd = end;
+        }
+        const char* lineStart = p;
+        p = lineEnd + 1;
+        line++;
+
+        const char* rowEnd = lineEnd;
+        while(rowEnd > lineStart && isBlank(rowEnd[-1]))
+        {
+            rowEnd--;
+        }
+        if(rowEnd == lineStart || *lineStart == '#')
+        {
+            continue;
+        }
+
+        if(firstRow)
+        {
+            // the most frequent of the usual delimiters, blanks if there is none
+            const int commas = std::count(lineStart, rowEnd, ',');
+            const int semicolons = std::count(lineStart, rowEnd, ';');
+            const int tabs = std::count(lineStart, rowEnd, '\t');
+            if(commas > 0 && commas >= semicolons && commas >= tabs) delimiter = ',';
+            else if(semicolons > 0 && semicolons >= tabs) delimiter = ';';
+            else if(tabs > 0) delimiter = '\t';
+        }
+
+        splitRow(lineStart, rowEnd, delimiter, fields);
+
+        if(firstRow)
+        {
+            firstRow = false;
+            if(fields.size() < 2)
+            {
+                parseError.line = line;
+                parseError.column = 1;
+                parseError.message = "expected a column of x coordinates and at least one channel";
+                break;
+            }
+
+            columns.resize(fields.size());
+            const qint64 estimate = size / (fields.size() * 12);
+            for(QVector<double>& column : columns)
+            {
+                column.reserve(static_cast<int>(std::min<qint64>(estimate, std::numeric_limits<int>::max())));
+            }
+
+            double value;
+            const char* message;
+            if(!SignalTextParser::readNumber(fields[0].begin, fields[0].end, value, message))
+            {
+                // a header row with the names of the columns
+                for(int i = 1; i < fields.size(); i++)
+                {
+                    header << QString::fromUtf8(fields[i].begin, fields[i].end - fields[i].begin);
+                }
+                continue;
+            }
+        }
+
+        if(fields.size() != columns.size())
+        {
+            parseError.line = line;
+            parseError.column = (fields.size() > columns.size() ? fields[columns.size()].begin : rowEnd) - lineStart + 1;
+            parseError.message = "expected " + std::to_string(columns.size()) + " columns, found " + std::to_string(fields.size());
+            break;
+        }
+
+        for(int i = 0; i < fields.size(); i++)
+        {
+            double value;
+            const char* message = nullptr;
+            const char* next = SignalTextParser::readNumber(fields[i].begin, fields[i].end, value, message);
+            if(next && next != fields[i].end)
+            {
+                message = "unexpected text after the number";
+                next = nullptr;
+            }
+            if(!next)
+            {
+                parseError.line = line;
+                parseError.column = fields[i].begin - lineStart + 1;
+                parseError.message = message;
+                break;
+            }
+            columns[i].push_back(value);
+        }
+    }
+
+    if(mapped)
+    {
+        file.unmap(const_cast<uchar*>(mapped));
+    }
+
+    if(parseError.line == 0 && (columns.isEmpty() || columns[0].isEmpty()))
+    {
+        parseError.message = "no samples in " + filename;
+    }
+
+    if(!parseError.message.empty())
+    {
+        if(error)
+        {
+            *error = parseError.toString();
+        }
+        return false;
+    }
+
+    x = columns.takeFirst();
+    channels = columns;
+
+    names = header;
+    for(int i = names.size(); i < channels.size(); i++)
+    {
+        names << QString::number(i + 1);
+    }
+
+    magnitudes = QVector<Signal>(channels.size());
+    phases = QVector<Signal>(channels.size());
+    cached = QVector<bool>(channels.size(), false);
+
+    return true;
+}
+
+
+void SignalBatch::clear()
+{
+    x.clear();
+    channels.clear();
+    names.clear();
+    magnitudes.clear();
+    phases.clear();
+    cached.clear();
+}
+
+
+Signal SignalBatch::signal(int channel) const
+{
+    return Signal(x, channels[channel]);
+}
+
+
+void SignalBatch::spectrum(int channel, Signal& magnitude, Signal& phase)
+{
+    if(!cached[channel])
+    {
+        Signal source = signal(channel);
+        Signal::fourierTransform(source, magnitudes[channel], phases[channel]);
+        cached[channel] = true;
+    }
+
+    magnitude = magnitudes[channel];
+    phase = phases[channel];
+}
@@ -0,0 +1,95 @@
+#ifndef SIGNALBATCH_H
+#define SIGNALBATCH_H
+
+/**
+ * @file signalbatch.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of a batch of signals sharing one x grid, loaded from a multi-column CSV file.
+ */
+
+#include "signal.h"
+#include "signaltextparser.h"
+
+#include <QStringList>
+#include <QVector>
+
+#include <string>
+
+namespace FT1D
+{
+
+/**
+ * @brief The SignalBatch class holds several channels sampled at the same x coordinates. The x grid is stored once
+ * and the values of each channel contiguously. Fourier transforms of the channels are cached, so switching between
+ * the channels does not recompute them.
+ */
+class SignalBatch
+{
+public:
+
+    /**
+     * @brief load_csv reads a CSV file in one pass. The first column contains the x coordinates, every other column one channel.
+     * The delimiter (comma, semicolon, tab or whitespace) is detected from the first row; if the first row is not numeric,
+     * it contains the names of the channels. Empty lines and lines starting with '#' are skipped.
+     * @param filename path to the file
+     * @param error if not null, receives description of the problem including its line and column
+     * @return true in case of success
+     */
+    bool load_csv(const std::string& filename, std::string* error = nullptr);
+
+    /**
+     * @brief clear removes all channels
+     */
+    void clear();
+
+    /**
+     * @brief channelCount
+     * @return number of channels, the x column is not counted
+     */
+    inline int channelCount() const
+    {
+        return channels.size();
+    }
+
+    /**
+     * @brief channelName
+     * @param channel
+     * @return name of the channel from the header row, or its number if the file has no header
+     */
+    inline QString channelName(int channel) const
+    {
+        return names.value(channel);
+    }
+
+    /**
+     * @brief signal
+     * @param channel
+     * @return the channel @a channel as a signal
+     */
+    Signal signal(int channel) const;
+
+    /**
+     * @brief spectrum computes the fourier transform of channel @a channel, or returns the cached one
+     * @param channel
+     * @param magnitude output, magnitudes of the fourier coefficients
+     * @param phase output, phases of the fourier coefficients
+     */
+    void spectrum(int channel, Signal& magnitude, Signal& phase);
+
+private:
+
+    // shared x coordinates
+    QVector<double> x;
+
+    // values of each channel, x.size() each
+    QVector<QVector<double> > channels;
+    QStringList names;
+
+    // cached transforms, valid if cached[channel] is true
+    QVector<Signal> magnitudes;
+    QVector<Signal> phases;
+    QVector<bool> cached;
+};
+}
+#endif // SIGNALBATCH_H
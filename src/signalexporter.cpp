@@ -0,0 +1,405 @@
+/**
+ * @file signalexporter.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "signalexporter.h"
+#include "binarysignalfile.h"
+#include "compressedsignalfile.h"
+
+#include <QFile>
+#include <QtConcurrent>
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+// size of the buffer, in which lines of text are formatted before they are written
+#define EXPORT_BUFFER_SIZE (1 << 20)
+
+// the buffer is written when less than this is free; enough for one line of three numbers
+#define EXPORT_MAX_LINE 128
+
+// number of samples written to a binary file at once
+#define EXPORT_BINARY_CHUNK 65536
+
+using namespace FT1D;
+
+namespace
+{
+
+/**
+ * @brief valuesOf copies the values of @a signal in the order of the x coordinates
+ */
+void valuesOf(const Signal& signal, QVector<double>& x, QVector<double>& y)
+{
+    x.clear();
+    y.clear();
+    x.reserve(signal.original.size());
+    y.reserve(signal.original.size());
+
+    for(QMap<double, double>::const_iterator iter = signal.original.constBegin(); iter != signal.original.constEnd(); ++iter)
+    {
+        x.push_back(iter.key());
+        y.push_back(iter.value());
+    }
+}
+
+
+/**
+ * @brief The ProgressReporter class calls the progress callback only when the percentage changes
+ */
+class ProgressReporter
+{
+public:
+    ProgressReporter(const std::function<void(int)>& callback, qint64 total) : callback(callback), total(std::max<qint64>(total, 1)), last(-1)
+    {
+    }
+
+    void report(qint64 done)
+    {
+        const int percent = static_cast<int>(done * 100 / total);
+        if(percent != last && callback)
+        {
+            last = percent;
+            callback(percent);
+        }
+    }
+
+private:
+    const std::function<void(int)>& callback;
+    qint64 total;
+    int last;
+};
+
+
+bool writeText(QFile& file, const QVector<double>& x, const QVector<double>& first, const QVector<double>& second,
+               const QAtomicInt* cancelled, ProgressReporter& progress)
+{
+    const bool complex = !second.isEmpty();
+
+    std::vector<char> buffer(EXPORT_BUFFER_SIZE);
+    char* const begin = buffer.data();
+    char* const end = begin + buffer.size();
+
+    static const char header[] = "# Function file generated by FTutor1D\n";
+    char* p = std::copy(header, header + sizeof(header) - 1, begin);
+
+    for(int i = 0; i < x.size(); i++)
+    {
+        // the shortest representation, which reads back as the same double
+        p = std::to_chars(p, end, x[i]).ptr;
+        *p++ = ' ';
+        p = std::to_chars(p, end, first[i]).ptr;
+        if(complex)
+        {
+            *p++ = ' ';
+            p = std::to_chars(p, end, second[i]).ptr;
+        }
+        *p++ = '\n';
+
+        if(end - p < EXPORT_MAX_LINE || i + 1 == x.size())
+        {
+            if(file.write(begin, p - begin) != p - begin)
+            {
+                return false;
+            }
+            p = begin;
+
+            if(cancelled && cancelled->loadAcquire())
+            {
+                return false;
+            }
+            progress.report(i + 1);
+        }
+    }
+    return true;
+}
+
+
+/**
+ * @brief uniformStep finds the spacing of @a x, binary formats store only the first x coordinate and the spacing
+ * @return false, if @a x is not sampled uniformly
+ */
+bool uniformStep(const QVector<double>& x, double& step, QString& error)
+{
+    step = x.size() > 1 ? x[1] - x[0] : 1;
+    for(int i = 2; i < x.size(); i++)
+    {
+        if(std::abs(x[i] - x[i - 1] - step) > 1e-9 * std::max(1.0, std::abs(step)))
+        {
+            error = QStringLiteral("the binary format requires uniformly sampled values");
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool writeBinary(QFile& file, const QVector<double>& x, const QVector<double>& first, const QVector<double>& second,
+                 const QAtomicInt* cancelled, ProgressReporter& progress, QString& error)
+{
+    const bool complex = !second.isEmpty();
+
+    double step;
+    if(!uniformStep(x, step, error))
+    {
+        return false;
+    }
+
+    BinarySignalHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, FT1B_MAGIC, sizeof(FT1B_MAGIC));
+    header.version = FT1B_VERSION;
+    header.dtype = complex ? FT1B_COMPLEX128 : FT1B_FLOAT64;
+    header.count = static_cast<quint64>(x.size());
+    header.x0 = x.isEmpty() ? 0 : x[0];
+    header.spacing = step;
+
+    // the checksum is filled in after the samples are written
+    if(file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header))
+    {
+        return false;
+    }
+
+    quint64 hash = FT1B_CHECKSUM_SEED;
+    QVector<double> interleaved(complex ? 2 * EXPORT_BINARY_CHUNK : 0);
+
+    for(int start = 0; start < x.size(); start += EXPORT_BINARY_CHUNK)
+    {
+        const int count = std::min(EXPORT_BINARY_CHUNK, x.size() - start);
+
+        const double* values = first.constData() + start;
+        qint64 bytes = count * static_cast<qint64>(sizeof(double));
+        if(complex)
+        {
+            for(int i = 0; i < count; i++)
+            {
+                interleaved[2 * i] = first[start + i];
+                interleaved[2 * i + 1] = second[start + i];
+            }
+            values = interleaved.constData();
+            bytes *= 2;
+        }
+
+        hash = BinarySignalFile::checksum(reinterpret_cast<const uchar*>(values), bytes, hash);
+        if(file.write(reinterpret_cast<const char*>(values), bytes) != bytes)
+        {
+            return false;
+        }
+
+        if(cancelled && cancelled->loadAcquire())
+        {
+            return false;
+        }
+        progress.report(start + count);
+    }
+
+    header.checksum = hash;
+    return file.seek(0) && file.write(reinterpret_cast<const char*>(&header), sizeof(header)) == sizeof(header);
+}
+
+
+bool writeCompressed(QFile& file, const QVector<double>& x, const QVector<double>& first, const QVector<double>& second,
+                     const QAtomicInt* cancelled, ProgressReporter& progress, QString& error)
+{
+    if(!second.isEmpty())
+    {
+        error = QStringLiteral("compressed signal files store only real values");
+        return false;
+    }
+
+    double step;
+    if(!uniformStep(x, step, error))
+    {
+        return false;
+    }
+
+    // the blocks are compressed by all cores, the progress is reported and the cancellation checked after each batch
+    file.close();
+    if(!CompressedSignalFile::write(file.fileName(), x.isEmpty() ? 0 : x[0], step, first.constData(), first.size(), FT1Z_XOR,
+                                    cancelled, [&](qint64 done) { progress.report(done); }))
+    {
+        if(!cancelled || !cancelled->loadAcquire())
+        {
+            error = QStringLiteral("cannot write ") + file.fileName();
+        }
+        return false;
+    }
+    progress.report(x.size());
+    return true;
+}
+}
+
+
+SignalExporter::SignalExporter(QObject* parent) : QObject(parent)
+{
+    format = EXPORT_TEXT;
+    polar = false;
+    generation = 0;
+
+    // emitted from the worker thread, delivered in the thread of this object
+    connect(this, &SignalExporter::workerProgress, this, [=](int workerGeneration, int percent)
+    {
+        if(workerGeneration == generation)
+        {
+            emit progress(percent);
+        }
+    });
+
+    connect(this, &SignalExporter::workerFinished, this, [=](int workerGeneration, bool success, const QString& error)
+    {
+        if(workerGeneration == generation)
+        {
+            // the copies are not needed any more
+            x.clear();
+            first.clear();
+            second.clear();
+
+            emit finished(success, path, error);
+        }
+    });
+}
+
+
+SignalExporter::~SignalExporter()
+{
+    cancel();
+}
+
+
+bool SignalExporter::exportSignal(const QString& path, ExportFormat format, const Signal& signal)
+{
+    if(isRunning())
+    {
+        return false;
+    }
+
+    valuesOf(signal, x, first);
+    second.clear();
+    polar = false;
+
+    this->path = path;
+    this->format = format;
+    start();
+    return true;
+}
+
+
+bool SignalExporter::exportSpectrum(const QString& path, ExportFormat format, ExportContent content, const Signal& magnitude, const Signal& phase)
+{
+    if(isRunning())
+    {
+        return false;
+    }
+
+    // magnitudes and phases share the frequencies
+    QVector<double> frequencies;
+    switch(content)
+    {
+    case EXPORT_PHASE:
+        valuesOf(phase, x, first);
+        second.clear();
+        polar = false;
+        break;
+    case EXPORT_COMPLEX:
+        // converted to the real and the imaginary part by the worker
+        valuesOf(magnitude, x, first);
+        valuesOf(phase, frequencies, second);
+        polar = true;
+        break;
+    default:
+        valuesOf(magnitude, x, first);
+        second.clear();
+        polar = false;
+        break;
+    }
+
+    this->path = path;
+    this->format = format;
+    start();
+    return true;
+}
+
+
+void SignalExporter::cancel()
+{
+    cancelled.storeRelease(1);
+    future.waitForFinished();
+
+    // drops notifications of the cancelled export, which are still queued
+    generation++;
+}
+
+
+void SignalExporter::start()
+{
+    generation++;
+    cancelled.storeRelease(0);
+
+    const int currentGeneration = generation;
+    future = QtConcurrent::run([=]()
+    {
+        if(polar)
+        {
+            for(int i = 0; i < first.size(); i++)
+            {
+                const double magnitude = first[i];
+                first[i] = magnitude * std::cos(second[i]);
+                second[i] = magnitude * std::sin(second[i]);
+            }
+        }
+
+        QString error;
+        const bool success = write(path, format, x, first, second, &cancelled, [=](int percent)
+        {
+            emit workerProgress(currentGeneration, percent);
+        }, error);
+
+        emit workerFinished(currentGeneration, success, error);
+    });
+}
+
+
+bool SignalExporter::write(const QString& path, ExportFormat format, const QVector<double>& x, const QVector<double>& first,
+                           const QVector<double>& second, const QAtomicInt* cancelled, const std::function<void(int)>& progress,
+                           QString& error)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        error = QStringLiteral("cannot write ") + path;
+        return false;
+    }
+
+    ProgressReporter reporter(progress, x.size());
+    reporter.report(0);
+
+    bool success;
+    switch(format)
+    {
+    case EXPORT_BINARY:
+        success = writeBinary(file, x, first, second, cancelled, reporter, error);
+        break;
+    case EXPORT_COMPRESSED:
+        success = writeCompressed(file, x, first, second, cancelled, reporter, error);
+        break;
+    default:
+        success = writeText(file, x, first, second, cancelled, reporter);
+        break;
+    }
+    file.close();
+
+    // an incomplete file is not left behind
+    if(!success || file.error() != QFileDevice::NoError)
+    {
+        file.remove();
+        if(error.isEmpty())
+        {
+            error = cancelled && cancelled->loadAcquire() ? QStringLiteral("cancelled") : QStringLiteral("cannot write ") + path;
+        }
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,163 @@
+#ifndef SIGNALEXPORTER_H
+#define SIGNALEXPORTER_H
+
+/**
+ * @file signalexporter.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of the background writer of signals and spectra.
+ */
+
+#include "signal.h"
+
+#include <QObject>
+#include <QVector>
+#include <QFuture>
+#include <QAtomicInt>
+#include <QString>
+
+#include <functional>
+
+namespace FT1D
+{
+
+/**
+ * @brief The ExportContent enum denotes what is written to the exported file
+ */
+enum ExportContent
+{
+    EXPORT_SIGNAL,      // x and y of a signal
+    EXPORT_MAGNITUDE,   // frequency and magnitude of the fourier coefficients
+    EXPORT_PHASE,       // frequency and phase of the fourier coefficients
+    EXPORT_COMPLEX      // frequency, real and imaginary part of the fourier coefficients
+};
+
+
+/**
+ * @brief The ExportFormat enum denotes the format of the exported file
+ */
+enum ExportFormat
+{
+    EXPORT_TEXT,        // text signal file (.ft1d), complex spectra have three columns
+    EXPORT_BINARY,      // binary signal file (.ft1b), requires uniform sampling
+    EXPORT_COMPRESSED   // compressed signal file (.ft1z), requires uniform sampling, real values only
+};
+
+
+/**
+ * @brief The SignalExporter class writes signals and spectra to files on a worker thread.
+ * The values are copied when the export starts, so the signals may change while it is running.
+ * Numbers are formatted with std::to_chars into a large buffer, which is written at once.
+ */
+class SignalExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief SignalExporter constructor
+     * @param parent parent object
+     */
+    explicit SignalExporter(QObject* parent = nullptr);
+
+    /**
+     * @brief ~SignalExporter destructor, cancels the export in progress
+     */
+    virtual ~SignalExporter();
+
+    /**
+     * @brief exportSignal starts writing @a signal to @a path
+     * @param path path to the file
+     * @param format format of the file
+     * @param signal the signal
+     * @return false, if another export is running
+     */
+    bool exportSignal(const QString& path, ExportFormat format, const Signal& signal);
+
+    /**
+     * @brief exportSpectrum starts writing the spectrum given by @a magnitude and @a phase to @a path
+     * @param path path to the file
+     * @param format format of the file
+     * @param content EXPORT_MAGNITUDE, EXPORT_PHASE or EXPORT_COMPLEX
+     * @param magnitude magnitudes of the fourier coefficients
+     * @param phase phases of the fourier coefficients
+     * @return false, if another export is running
+     */
+    bool exportSpectrum(const QString& path, ExportFormat format, ExportContent content, const Signal& magnitude, const Signal& phase);
+
+    /**
+     * @brief cancel stops the export in progress, waits for the worker thread and removes the incomplete file
+     */
+    void cancel();
+
+    /**
+     * @brief isRunning
+     * @return true, if an export is in progress
+     */
+    inline bool isRunning() const
+    {
+        return future.isRunning();
+    }
+
+    /**
+     * @brief write writes the values to @a path in the calling thread
+     * @param path path to the file
+     * @param format format of the file
+     * @param x x coordinates
+     * @param first y coordinates, or real parts of complex values
+     * @param second imaginary parts of complex values, empty for real values
+     * @param cancelled if not null and set to non-zero, the writing stops
+     * @param progress if set, called with the written percentage each time it changes
+     * @param error output, description of the problem
+     * @return true, if the whole file was written
+     */
+    static bool write(const QString& path, ExportFormat format, const QVector<double>& x, const QVector<double>& first,
+                      const QVector<double>& second, const QAtomicInt* cancelled, const std::function<void(int)>& progress,
+                      QString& error);
+
+signals:
+    /**
+     * @brief progress notifies about the written percentage
+     * @param percent 0 .. 100
+     */
+    void progress(int percent);
+
+    /**
+     * @brief finished notifies that the export ended. Not emitted for cancelled exports.
+     * @param success true, if the whole file was written
+     * @param path path to the file
+     * @param error description of the problem, empty on success
+     */
+    void finished(bool success, const QString& path, const QString& error);
+
+    /**
+     * @brief workerProgress internal notification from the worker thread, filtered by generation before progress is emitted
+     */
+    void workerProgress(int generation, int percent);
+
+    /**
+     * @brief workerFinished internal notification from the worker thread, filtered by generation before finished is emitted
+     */
+    void workerFinished(int generation, bool success, const QString& error);
+
+private:
+    /**
+     * @brief start starts the worker, which writes x, first and second to path
+     */
+    void start();
+
+    QString path;
+    ExportFormat format;
+    QVector<double> x;
+    QVector<double> first;
+    QVector<double> second;
+
+    // first and second are magnitudes and phases, which the worker converts to real and imaginary parts
+    bool polar;
+
+    QFuture<void> future;
+    QAtomicInt cancelled;
+    int generation;
+};
+}
+#endif // SIGNALEXPORTER_H
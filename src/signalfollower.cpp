@@ -0,0 +1,168 @@
+/**
+ * @file signalfollower.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "signalfollower.h"
+
+#include <QFile>
+#include <QByteArray>
+
+#include <algorithm>
+
+using namespace FT1D;
+
+SignalFollower::SignalFollower(QObject* parent) : QObject(parent)
+{
+    offset = 0;
+    lines = 0;
+
+    watcher = new QFileSystemWatcher(this);
+    connect(watcher, &QFileSystemWatcher::fileChanged, this, &SignalFollower::fileChanged);
+
+    refreshTimer = new QTimer(this);
+    refreshTimer->setSingleShot(true);
+    refreshTimer->setInterval(FOLLOW_REFRESH_INTERVAL);
+    connect(refreshTimer, &QTimer::timeout, this, &SignalFollower::readAppended);
+}
+
+
+SignalFollower::~SignalFollower()
+{
+    stop();
+    delete refreshTimer;
+    delete watcher;
+}
+
+
+bool SignalFollower::start(const QString& path, QVector<double>& x, QVector<double>& y, SignalParseError& error)
+{
+    stop();
+    offset = 0;
+    lines = 0;
+    x.clear();
+    y.clear();
+    error = SignalParseError();
+
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        error.message = "the file could not be opened";
+        return false;
+    }
+
+    const qint64 size = file.size();
+    if(size > 0)
+    {
+        uchar* data = file.map(0, size);
+        if(!data)
+        {
+            error.message = "the file could not be mapped";
+            return false;
+        }
+
+        const bool valid = parse(reinterpret_cast<const char*>(data), size, x, y, error);
+        file.unmap(data);
+        if(!valid)
+        {
+            return false;
+        }
+    }
+
+    followedPath = path;
+    watcher->addPath(path);
+    return true;
+}
+
+
+void SignalFollower::stop()
+{
+    refreshTimer->stop();
+    if(!watcher->files().isEmpty())
+    {
+        watcher->removePaths(watcher->files());
+    }
+    followedPath.clear();
+}
+
+
+void SignalFollower::fileChanged()
+{
+    // writers replacing the file remove it from the watcher
+    if(isFollowing() && !watcher->files().contains(followedPath) && QFile::exists(followedPath))
+    {
+        watcher->addPath(followedPath);
+    }
+
+    if(isFollowing() && !refreshTimer->isActive())
+    {
+        refreshTimer->start();
+    }
+}
+
+
+void SignalFollower::readAppended()
+{
+    if(!isFollowing())
+    {
+        return;
+    }
+
+    QFile file(followedPath);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        // the writer may be replacing the file, the next change is awaited
+        return;
+    }
+
+    const qint64 size = file.size();
+    if(size < offset)
+    {
+        const QString path = followedPath;
+        stop();
+        emit failed(path + QStringLiteral(": the file was truncated"));
+        return;
+    }
+    if(size == offset || !file.seek(offset))
+    {
+        return;
+    }
+
+    const QByteArray appended = file.read(size - offset);
+
+    QVector<double> x, y;
+    SignalParseError error;
+    if(!parse(appended.constData(), appended.size(), x, y, error))
+    {
+        const QString path = followedPath;
+        stop();
+        emit failed(path + QStringLiteral(": ") + QString::fromStdString(error.toString()));
+        return;
+    }
+
+    if(!x.isEmpty())
+    {
+        emit samplesAppended(x, y);
+    }
+}
+
+
+bool SignalFollower::parse(const char* data, qint64 size, QVector<double>& x, QVector<double>& y, SignalParseError& error)
+{
+    // the last line is complete once its end of line is written
+    const char* end = data + size;
+    while(end > data && end[-1] != '\n')
+    {
+        end--;
+    }
+
+    if(!SignalTextParser::parse(data, end - data, x, y, error))
+    {
+        error.line += lines;
+        return false;
+    }
+
+    offset += end - data;
+    lines += std::count(data, end, '\n');
+    return true;
+}
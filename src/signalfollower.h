@@ -0,0 +1,123 @@
+#ifndef SIGNALFOLLOWER_H
+#define SIGNALFOLLOWER_H
+
+/**
+ * @file signalfollower.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of the follower of text signal files, which are being appended to.
+ */
+
+#include "signaltextparser.h"
+
+#include <QObject>
+#include <QVector>
+#include <QString>
+#include <QFileSystemWatcher>
+#include <QTimer>
+
+namespace FT1D
+{
+
+// minimal time between two notifications in milliseconds, caps the refresh rate of the plots
+#define FOLLOW_REFRESH_INTERVAL 200
+
+// number of trailing samples whose spectrum is displayed while a file is followed
+#define FOLLOW_SPECTRUM_WINDOW 4096
+
+/**
+ * @brief The SignalFollower class watches a text signal file (.ft1d), which another process appends samples to.
+ * Only the bytes appended since the last read are parsed; a line is taken when its end of line is written,
+ * so a partially written line is read again, complete, next time. The file is never read again as a whole.
+ */
+class SignalFollower : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief SignalFollower constructor
+     * @param parent parent object
+     */
+    explicit SignalFollower(QObject* parent = nullptr);
+
+    /**
+     * @brief ~SignalFollower destructor, stops following
+     */
+    virtual ~SignalFollower();
+
+    /**
+     * @brief start parses the complete lines of @a path and starts watching it
+     * @param path path to the file
+     * @param x output, x coordinates of the samples in the file
+     * @param y output, y coordinates of the samples in the file
+     * @param error output, location of the first error, line 0 if the file could not be opened
+     * @return true, if the file was read and is valid
+     */
+    bool start(const QString& path, QVector<double>& x, QVector<double>& y, SignalParseError& error);
+
+    /**
+     * @brief stop stops watching the file
+     */
+    void stop();
+
+    /**
+     * @brief isFollowing
+     * @return true, if a file is watched
+     */
+    inline bool isFollowing() const
+    {
+        return !followedPath.isEmpty();
+    }
+
+    /**
+     * @brief path
+     * @return path to the watched file, empty if no file is watched
+     */
+    inline QString path() const
+    {
+        return followedPath;
+    }
+
+signals:
+    /**
+     * @brief samplesAppended notifies about samples appended to the file, at most once per FOLLOW_REFRESH_INTERVAL
+     * @param x x coordinates of the new samples
+     * @param y y coordinates of the new samples
+     */
+    void samplesAppended(const QVector<double>& x, const QVector<double>& y);
+
+    /**
+     * @brief failed notifies that following stopped, because the appended text is not valid or the file was truncated
+     * @param message description of the problem
+     */
+    void failed(const QString& message);
+
+private:
+    /**
+     * @brief fileChanged schedules reading of the file, unless it is already scheduled
+     */
+    void fileChanged();
+
+    /**
+     * @brief readAppended parses the complete lines appended since the last read and emits samplesAppended
+     */
+    void readAppended();
+
+    /**
+     * @brief parse parses the complete lines of @a data and advances offset and lines past them
+     * @return false, if the text is not valid; @a error is relative to the whole file
+     */
+    bool parse(const char* data, qint64 size, QVector<double>& x, QVector<double>& y, SignalParseError& error);
+
+    QFileSystemWatcher* watcher;
+    QTimer* refreshTimer;
+
+    QString followedPath;
+
+    // bytes and lines parsed so far, always up to the end of a line
+    qint64 offset;
+    qint64 lines;
+};
+}
+#endif // SIGNALFOLLOWER_H
@@ -0,0 +1,157 @@
+/**
+ * @file signalgenerator.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "signalgenerator.h"
+
+#include <QtConcurrent>
+
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+
+// samples evaluated by one task; the loops over a block have no dependencies between samples, so they are vectorized
+#define GENERATOR_BLOCK 4096
+
+using namespace FT1D;
+
+namespace
+{
+
+/**
+ * @brief The Rotation struct holds sin and cos of k * step for k = 0 .. GENERATOR_BLOCK - 1
+ */
+struct Rotation
+{
+    Rotation(double step) : step(step), sin(GENERATOR_BLOCK), cos(GENERATOR_BLOCK)
+    {
+        for(int k = 0; k < GENERATOR_BLOCK; k++)
+        {
+            sin[k] = std::sin(k * step);
+            cos[k] = std::cos(k * step);
+        }
+    }
+
+    double step;
+    QVector<double> sin;
+    QVector<double> cos;
+};
+
+
+/**
+ * @brief sine evaluates amplitude * sin(phase + i * step) for i = first .. first + count - 1, count <= GENERATOR_BLOCK.
+ * sin(a + k * step) = sin(a) cos(k * step) + cos(a) sin(k * step), so there is one call of sin and cos per block
+ * and the error does not accumulate along the signal.
+ */
+void sine(qint64 first, int count, double phase, const Rotation& rotation, double amplitude, double* out)
+{
+    const double start = std::fmod(phase + first * rotation.step, 2.0 * M_PI);
+    const double s = amplitude * std::sin(start);
+    const double c = amplitude * std::cos(start);
+    const double* rs = rotation.sin.constData();
+    const double* rc = rotation.cos.constData();
+
+    for(int k = 0; k < count; k++)
+    {
+        out[k] = s * rc[k] + c * rs[k];
+    }
+}
+}
+
+
+void SignalGenerator::generate(const GeneratorParameters& parameters, QVector<double>& y)
+{
+    const qint64 length = std::max<qint64>(parameters.length, 0);
+    y.resize(static_cast<int>(length));
+
+    const GeneratedShape shape = parameters.shape;
+    const double amplitude = parameters.amplitude;
+    const double position = parameters.position >= 0.0 ? parameters.position : std::floor(length / 2.0);
+    const double width = parameters.width > 0.0 ? parameters.width : std::max(1.0, shape == SHAPE_RAMP ? length / 2.0 : length / 8.0);
+
+    if(shape == SHAPE_IMPULSE)
+    {
+        std::fill(y.begin(), y.end(), 0.0);
+        const qint64 index = std::llround(position);
+        if(index < length)
+        {
+            y[static_cast<int>(index)] = amplitude;
+        }
+        return;
+    }
+
+    QVector<int> blocks(static_cast<int>((length + GENERATOR_BLOCK - 1) / GENERATOR_BLOCK));
+    std::iota(blocks.begin(), blocks.end(), 0);
+
+    // sinc uses the sine of pi / width per sample
+    const Rotation rotation(shape == SHAPE_SINC ? M_PI / width : 2.0 * M_PI * parameters.frequency / std::max<qint64>(length, 1));
+
+    double* values = y.data();
+    QtConcurrent::blockingMap(blocks, [&](const int& b)
+    {
+        const qint64 first = b * static_cast<qint64>(GENERATOR_BLOCK);
+        const int count = static_cast<int>(std::min<qint64>(GENERATOR_BLOCK, length - first));
+        double* out = values + first;
+
+        switch(shape)
+        {
+        case SHAPE_SINE:
+            sine(first, count, 0.0, rotation, amplitude, out);
+            break;
+        case SHAPE_COSINE:
+            sine(first, count, M_PI / 2.0, rotation, amplitude, out);
+            break;
+        case SHAPE_GAUSSIAN:
+        {
+            const double scale = -1.0 / (2.0 * width * width);
+            for(int k = 0; k < count; k++)
+            {
+                const double d = first + k - position;
+                out[k] = amplitude * std::exp(scale * d * d);
+            }
+            break;
+        }
+        case SHAPE_STEP:
+            for(int k = 0; k < count; k++)
+            {
+                out[k] = first + k >= position ? amplitude : 0.0;
+            }
+            break;
+        case SHAPE_RAMP:
+            for(int k = 0; k < count; k++)
+            {
+                out[k] = amplitude * std::min(1.0, std::max(-1.0, 2.0 * (first + k - position) / width));
+            }
+            break;
+        case SHAPE_CONSTANT:
+            std::fill(out, out + count, amplitude);
+            break;
+        case SHAPE_SINC:
+        {
+            // sin(u) / u with u = pi (i - position) / width, the numerator is a sine of the sample index
+            sine(first, count, -position * rotation.step, rotation, amplitude, out);
+            for(int k = 0; k < count; k++)
+            {
+                const double u = (first + k - position) * rotation.step;
+                out[k] = u == 0.0 ? amplitude : out[k] / u;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    });
+}
+
+
+void SignalGenerator::generate(const GeneratorParameters& parameters, Signal& signal)
+{
+    QVector<double> y;
+    generate(parameters, y);
+
+    QVector<double> x(y.size());
+    std::iota(x.begin(), x.end(), 0.0);
+
+    signal.set_samples(x.constData(), y.constData(), y.size());
+}
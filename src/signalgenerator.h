@@ -0,0 +1,73 @@
+#ifndef SIGNALGENERATOR_H
+#define SIGNALGENERATOR_H
+
+/**
+ * @file signalgenerator.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains the procedural generator of the predefined signals.
+ */
+
+#include "signal.h"
+
+#include <QVector>
+
+namespace FT1D
+{
+
+/**
+ * @brief The GeneratedShape enum denotes the predefined signals the generator can produce
+ */
+enum GeneratedShape
+{
+    SHAPE_SINE,
+    SHAPE_COSINE,
+    SHAPE_GAUSSIAN,
+    SHAPE_IMPULSE,
+    SHAPE_STEP,
+    SHAPE_RAMP,
+    SHAPE_CONSTANT,
+    SHAPE_SINC
+};
+
+
+/**
+ * @brief The GeneratorParameters struct describes a generated signal. Positions and widths are in samples,
+ * sample i has the x coordinate i. A negative position or a width that is not positive selects the default,
+ * which scales with the length.
+ */
+struct GeneratorParameters
+{
+    GeneratedShape shape = SHAPE_SINE;
+    qint64 length = 32;         // number of samples
+    double amplitude = 1.0;     // peak value
+    double frequency = 1.0;     // periods over the whole signal (sine, cosine)
+    double position = -1.0;     // impulse, edge of the step, peak of gaussian and sinc, middle of the ramp; default length / 2
+    double width = -1.0;        // deviation of gaussian, distance of the first zero of sinc (default length / 8), length of the ramp (default length / 2)
+};
+
+
+/**
+ * @brief The SignalGenerator class evaluates the predefined signals for any length, without reading any file.
+ * The output is deterministic, so it can be used as an input of benchmarks.
+ */
+class SignalGenerator
+{
+public:
+
+    /**
+     * @brief generate evaluates the values of a signal
+     * @param parameters the signal to generate
+     * @param y output, parameters.length values
+     */
+    static void generate(const GeneratorParameters& parameters, QVector<double>& y);
+
+    /**
+     * @brief generate replaces @a signal by the generated signal
+     * @param parameters the signal to generate
+     * @param signal output
+     */
+    static void generate(const GeneratorParameters& parameters, Signal& signal);
+};
+}
+#endif // SIGNALGENERATOR_H
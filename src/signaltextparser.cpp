@@ -0,0 +1,319 @@
+/**
+ * @file signaltextparser.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "signaltextparser.h"
+
+#include <QtConcurrent>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QThread>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+
+// inputs at least this long are split and parsed by several threads
+#define PARALLEL_PARSE_MIN_SIZE (1 << 20)
+
+using namespace FT1D;
+
+namespace
+{
+
+/**
+ * @brief The ParseChunk struct is a part of the input consisting of whole lines, parsed by one thread
+ */
+struct ParseChunk
+{
+    const char* begin;
+    const char* end;
+    QVector<double> x;
+    QVector<double> y;
+    qint64 lines;
+    SignalParseError error;
+};
+
+
+inline bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+
+inline const char* skipBlanks(const char* p, const char* end)
+{
+    while(p < end && isBlank(*p))
+    {
+        p++;
+    }
+    return p;
+}
+
+
+/**
+ * @brief parseLine parses one line without the line feed, appends the coordinates to @a chunk
+ * @return false and fills chunk.error if the line is not valid
+ */
+bool parseLine(const char* begin, const char* end, ParseChunk& chunk, qint64 line)
+{
+    if(begin == end || *begin == '#')
+    {
+        return true;
+    }
+
+    const char* p = skipBlanks(begin, end);
+    if(p == end)
+    {
+        return true;
+    }
+
+    const char* message = nullptr;
+    double x;
+    double y;
+
+    const char* next = SignalTextParser::readNumber(p, end, x, message);
+    if(next)
+    {
+        p = next;
+        if(p < end && !isBlank(*p))
+        {
+            message = "expected whitespace after the x coordinate";
+            next = nullptr;
+        }
+    }
+
+    if(next)
+    {
+        p = skipBlanks(p, end);
+        if(p == end || *p == '#')
+        {
+            message = "missing y coordinate";
+            next = nullptr;
+        }
+        else
+        {
+            next = SignalTextParser::readNumber(p, end, y, message);
+        }
+    }
+
+    if(next)
+    {
+        p = skipBlanks(next, end);
+        if(p < end && *p != '#')
+        {
+            message = "unexpected text after the y coordinate";
+            next = nullptr;
+        }
+    }
+
+    if(!next)
+    {
+        chunk.error.line = line;
+        chunk.error.column = p - begin + 1;
+        chunk.error.message = message;
+        return false;
+    }
+
+    chunk.x.push_back(x);
+    chunk.y.push_back(y);
+    return true;
+}
+
+
+void parseChunk(ParseChunk& chunk)
+{
+    // a rough guess of the number of samples, avoids most reallocations
+    const qint64 estimate = (chunk.end - chunk.begin) / 24;
+    chunk.x.reserve(static_cast<int>(estimate));
+    chunk.y.reserve(static_cast<int>(estimate));
+
+    qint64 line = 0;
+    const char* p = chunk.begin;
+
+    while(p < chunk.end)
+    {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', chunk.end - p));
+        if(!lineEnd)
+        {
+            lineEnd = chunk.end;
+        }
+
+        line++;
+        if(!parseLine(p, lineEnd, chunk, line))
+        {
+            break;
+        }
+        p = lineEnd + 1;
+    }
+
+    chunk.lines = line;
+}
+}
+
+
+const char* SignalTextParser::readNumber(const char* p, const char* end, double& value, const char*& message)
+{
+    // std::from_chars does not accept the plus sign, stream extraction does
+    if(p + 1 < end && *p == '+' && p[1] != '-' && p[1] != '+')
+    {
+        p++;
+    }
+
+    const std::from_chars_result result = std::from_chars(p, end, value);
+    if(result.ec == std::errc::result_out_of_range)
+    {
+        message = "number out of range";
+        return nullptr;
+    }
+    if(result.ec != std::errc())
+    {
+        message = "expected a number";
+        return nullptr;
+    }
+    return result.ptr;
+}
+
+
+std::string SignalParseError::toString() const
+{
+    if(line == 0)
+    {
+        return message;
+    }
+    return "line " + std::to_string(line) + ", column " + std::to_string(column) + ": " + message;
+}
+
+
+bool SignalTextParser::parse(const char* data, qint64 size, QVector<double>& x, QVector<double>& y, SignalParseError& error)
+{
+    error = SignalParseError();
+    x.clear();
+    y.clear();
+
+    const int parts = size >= PARALLEL_PARSE_MIN_SIZE ? std::max(1, QThread::idealThreadCount()) : 1;
+
+    // split the input at line boundaries
+    QVector<ParseChunk> chunks(parts);
+    const char* end = data + size;
+    const char* begin = data;
+    for(int i = 0; i < parts; i++)
+    {
+        const char* split = i == parts - 1 ? end : data + size * (i + 1) / parts;
+        if(split < begin)
+        {
+            split = begin;
+        }
+        if(split < end)
+        {
+            const char* lineFeed = static_cast<const char*>(std::memchr(split, '\n', end - split));
+            split = lineFeed ? lineFeed + 1 : end;
+        }
+
+        chunks[i].begin = begin;
+        chunks[i].end = split;
+        chunks[i].lines = 0;
+        begin = split;
+    }
+
+    if(parts > 1)
+    {
+        QtConcurrent::blockingMap(chunks, parseChunk);
+    }
+    else
+    {
+        parseChunk(chunks[0]);
+    }
+
+    // lines are numbered within chunks, all chunks before the first error were parsed completely
+    qint64 lines = 0;
+    qint64 total = 0;
+    for(const ParseChunk& chunk : chunks)
+    {
+        if(chunk.error.line != 0)
+        {
+            error = chunk.error;
+            error.line += lines;
+            return false;
+        }
+        lines += chunk.lines;
+        total += chunk.x.size();
+    }
+
+    x.reserve(static_cast<int>(total));
+    y.reserve(static_cast<int>(total));
+    for(const ParseChunk& chunk : chunks)
+    {
+        x.append(chunk.x);
+        y.append(chunk.y);
+    }
+    return true;
+}
+
+
+bool SignalTextParser::parseFile(const std::string& filename, QVector<double>& x, QVector<double>& y, SignalParseError& error)
+{
+    error = SignalParseError();
+    x.clear();
+    y.clear();
+
+    QFile file(QString::fromStdString(filename));
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        error.message = "cannot open " + filename;
+        return false;
+    }
+
+    const qint64 size = file.size();
+    if(size == 0)
+    {
+        return true;
+    }
+
+    uchar* data = file.map(0, size);
+    if(data)
+    {
+        const bool result = parse(reinterpret_cast<const char*>(data), size, x, y, error);
+        file.unmap(data);
+        return result;
+    }
+
+    // files which cannot be mapped are read at once
+    const QByteArray bytes = file.readAll();
+    return parse(bytes.constData(), bytes.size(), x, y, error);
+}
+
+
+double SignalTextParser::benchmark(const std::string& filename, int repetitions)
+{
+    QVector<double> x;
+    QVector<double> y;
+    SignalParseError error;
+
+    const qint64 size = QFile(QString::fromStdString(filename)).size();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for(int i = 0; i < repetitions; i++)
+    {
+        if(!parseFile(filename, x, y, error))
+        {
+            std::cout << filename << ": " << error.toString() << std::endl;
+            return -1;
+        }
+    }
+
+    const double seconds = std::max<qint64>(timer.nsecsElapsed(), 1) * 1e-9;
+    const double megabytes = size * static_cast<double>(repetitions) / 1e6;
+    const double throughput = megabytes / seconds;
+
+    std::cout << filename << ": " << x.size() << " samples, " << std::fixed << std::setprecision(1)
+              << size / 1e6 << " MB, " << seconds * 1e3 / repetitions << " ms per pass, "
+              << throughput << " MB/s" << std::endl;
+
+    return throughput;
+}
@@ -0,0 +1,85 @@
+#ifndef SIGNALTEXTPARSER_H
+#define SIGNALTEXTPARSER_H
+
+/**
+ * @file signaltextparser.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of the parser of text signal files (.ft1d).
+ */
+
+#include <QVector>
+
+#include <string>
+
+namespace FT1D
+{
+
+/**
+ * @brief The SignalParseError struct describes the first error found in a text signal file
+ */
+struct SignalParseError
+{
+    qint64 line = 0;        // line of the error, starting from 1; 0 if there is no error
+    qint64 column = 0;      // byte within the line, starting from 1
+    std::string message;    // what is wrong
+
+    /**
+     * @brief toString
+     * @return human readable description including the location, empty if there is no error
+     */
+    std::string toString() const;
+};
+
+
+/**
+ * @brief The SignalTextParser class parses text signal files. Each line contains the x and the y coordinate
+ * separated by whitespace; empty lines and lines starting with '#' are skipped, text following '#' after the
+ * two values is a comment as well.
+ * Large inputs are split at line boundaries and the parts are parsed in parallel using std::from_chars.
+ */
+class SignalTextParser
+{
+public:
+
+    /**
+     * @brief parse parses text of a signal file
+     * @param data the text, does not need to be zero terminated
+     * @param size length of the text in bytes
+     * @param x output, x coordinates in the order of the file
+     * @param y output, y coordinates in the order of the file
+     * @param error output, location of the first error
+     * @return true, if the whole text is valid
+     */
+    static bool parse(const char* data, qint64 size, QVector<double>& x, QVector<double>& y, SignalParseError& error);
+
+    /**
+     * @brief parseFile maps the file @a filename and parses it
+     * @param filename path to the file
+     * @param x output, x coordinates in the order of the file
+     * @param y output, y coordinates in the order of the file
+     * @param error output, location of the first error, line 0 if the file could not be opened
+     * @return true, if the file was read and is valid
+     */
+    static bool parseFile(const std::string& filename, QVector<double>& x, QVector<double>& y, SignalParseError& error);
+
+    /**
+     * @brief readNumber reads one number at @a p, accepting the same notation as stream extraction
+     * @param p first character of the number
+     * @param end end of the text
+     * @param value output, the number
+     * @param message output, description of the problem, if there is no valid number at @a p
+     * @return position after the number, nullptr if there is no valid number at @a p
+     */
+    static const char* readNumber(const char* p, const char* end, double& value, const char*& message);
+
+    /**
+     * @brief benchmark parses the file @a filename repeatedly and prints the throughput to standard output
+     * @param filename path to the file
+     * @param repetitions how many times the file is parsed
+     * @return throughput in MB/s, negative if the file is not valid
+     */
+    static double benchmark(const std::string& filename, int repetitions);
+};
+}
+#endif // SIGNALTEXTPARSER_H
@@ -0,0 +1,283 @@
+/**
+ * @file spectrogram.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "spectrogram.h"
+#include "fftplan.h"
+#include "pagedsignal.h"
+
+#include <QtConcurrent>
+
+#include <cmath>
+#include <complex>
+#include <numeric>
+#include <algorithm>
+#include <limits>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// the first batch is small, so the first columns are displayed immediately
+#define SPECTROGRAM_FIRST_BATCH 16
+
+// batches grow up to this number of frames
+#define SPECTROGRAM_MAX_BATCH 1024
+
+// streamed spectrograms of long signals are limited to this number of frames, which bounds the memory of the result
+#define SPECTROGRAM_MAX_STREAMED_FRAMES 4096
+
+// shape parameter of the Kaiser window
+#define KAISER_BETA 8.6
+
+using namespace FT1D;
+
+Spectrogram::Spectrogram(QObject* parent) : QObject(parent)
+{
+    windowSum = 1;
+    source = nullptr;
+    sampleCount = 0;
+    length = 0;
+    hopSize = 1;
+    frames = 0;
+    bins = 0;
+    generation = 0;
+
+    // emitted from the worker thread, delivered in the thread of this object
+    connect(this, &Spectrogram::framesComputed, this, [=](int computedGeneration, int first, int count)
+    {
+        if(computedGeneration != generation)
+        {
+            return;
+        }
+
+        emit framesReady(first, count);
+
+        if(first + count == frames)
+        {
+            emit finished();
+        }
+    }, Qt::QueuedConnection);
+}
+
+
+Spectrogram::~Spectrogram()
+{
+    cancel();
+}
+
+
+void Spectrogram::cancel()
+{
+    cancelled.storeRelease(1);
+    future.waitForFinished();
+}
+
+
+void Spectrogram::compute(const QVector<double>& samples, SpectrogramWindow window, int windowLength, int hop)
+{
+    cancel();
+
+    this->samples = samples;
+    source = nullptr;
+    sampleCount = samples.size();
+
+    start(window, windowLength, hop);
+}
+
+
+void Spectrogram::computeStreamed(const PagedSignal* signal, SpectrogramWindow window, int windowLength, int hop)
+{
+    cancel();
+
+    samples.clear();
+    source = signal;
+    sampleCount = signal ? signal->count() : 0;
+
+    hop = std::max(1, hop);
+    if(sampleCount > windowLength)
+    {
+        const qint64 minimalHop = (sampleCount - windowLength + SPECTROGRAM_MAX_STREAMED_FRAMES - 2) / (SPECTROGRAM_MAX_STREAMED_FRAMES - 1);
+        hop = static_cast<int>(std::min<qint64>(std::max<qint64>(hop, minimalHop), std::numeric_limits<int>::max()));
+    }
+
+    start(window, windowLength, hop);
+}
+
+
+void Spectrogram::start(SpectrogramWindow window, int windowLength, int hop)
+{
+    generation++;
+
+    if(!plan || plan->length() != windowLength)
+    {
+        plan = QSharedPointer<FFTPlan>(new FFTPlan(windowLength));
+    }
+
+    length = windowLength;
+    hopSize = std::max(1, hop);
+    bins = length / 2 + 1;
+
+    if(sampleCount == 0)
+    {
+        frames = 0;
+    }
+    else if(sampleCount <= length)
+    {
+        // a single zero padded frame
+        frames = 1;
+    }
+    else
+    {
+        frames = static_cast<int>(1 + (sampleCount - length) / hopSize);
+    }
+
+    windowValues = Spectrogram::window(window, length);
+    windowSum = std::accumulate(windowValues.constBegin(), windowValues.constEnd(), 0.0);
+    if(windowSum == 0)
+    {
+        windowSum = 1;
+    }
+
+    magnitudes.fill(0, frames * bins);
+
+    if(frames == 0)
+    {
+        emit finished();
+        return;
+    }
+
+    cancelled.storeRelease(0);
+
+    const int currentGeneration = generation;
+    future = QtConcurrent::run([=]()
+    {
+        run(currentGeneration);
+    });
+}
+
+
+void Spectrogram::run(int generation)
+{
+    int first = 0;
+    int batch = SPECTROGRAM_FIRST_BATCH;
+
+    while(first < frames && !cancelled.loadAcquire())
+    {
+        const int count = std::min(batch, frames - first);
+
+        QVector<int> indices(count);
+        std::iota(indices.begin(), indices.end(), first);
+
+        QtConcurrent::blockingMap(indices, [=](const int& index) { computeFrame(index); });
+
+        if(cancelled.loadAcquire())
+        {
+            return;
+        }
+
+        emit framesComputed(generation, first, count);
+
+        first += count;
+        batch = std::min(2 * batch, SPECTROGRAM_MAX_BATCH);
+    }
+}
+
+
+void Spectrogram::computeFrame(int index)
+{
+    QVector<std::complex<double> > buffer(length);
+    std::complex<double>* data = buffer.data();
+
+    const double* w = windowValues.constData();
+
+    const qint64 start = static_cast<qint64>(index) * hopSize;
+    const int available = static_cast<int>(std::min<qint64>(length, sampleCount - start));
+
+    QVector<double> streamed;
+    const double* x = samples.constData() + start;
+    if(source)
+    {
+        streamed.resize(available);
+        source->read(start, available, streamed.data());
+        x = streamed.constData();
+    }
+
+    for(int n = 0; n < available; n++)
+    {
+        data[n] = x[n] * w[n];
+    }
+
+    plan->forward(data);
+
+    // amplitude of a sinusoid, independent of the window
+    const double scale = 2.0 / windowSum;
+
+    float* out = magnitudes.data() + index * bins;
+    for(int k = 0; k < bins; k++)
+    {
+        const double amplitude = std::abs(data[k]) * scale;
+        out[k] = static_cast<float>(20.0 * std::log10(std::max(amplitude, 1e-12)));
+    }
+}
+
+
+QVector<double> Spectrogram::window(SpectrogramWindow type, int length)
+{
+    QVector<double> values(length, 1.0);
+    if(length <= 1)
+    {
+        return values;
+    }
+
+    const double denominator = length - 1;
+
+    for(int n = 0; n < length; n++)
+    {
+        const double phase = 2.0 * M_PI * n / denominator;
+
+        switch(type)
+        {
+        case HANN:
+            values[n] = 0.5 - 0.5 * std::cos(phase);
+            break;
+        case HAMMING:
+            values[n] = 0.54 - 0.46 * std::cos(phase);
+            break;
+        case BLACKMAN:
+            values[n] = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+            break;
+        case KAISER:
+        {
+            const double ratio = 2.0 * n / denominator - 1.0;
+            values[n] = besselI0(KAISER_BETA * std::sqrt(std::max(0.0, 1.0 - ratio * ratio))) / besselI0(KAISER_BETA);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return values;
+}
+
+
+double Spectrogram::besselI0(double x)
+{
+    // power series sum ((x/2)^k / k!)^2, converges quickly for the arguments used by the window
+    double sum = 1;
+    double term = 1;
+    const double half = x / 2.0;
+
+    for(int k = 1; k < 50; k++)
+    {
+        term *= half / k;
+        const double squared = term * term;
+        sum += squared;
+        if(squared < sum * 1e-16)
+        {
+            break;
+        }
+    }
+    return sum;
+}
@@ -0,0 +1,205 @@
+#ifndef SPECTROGRAM_H
+#define SPECTROGRAM_H
+
+/**
+ * @file spectrogram.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of the short-time fourier transform engine.
+ */
+
+#include <QObject>
+#include <QVector>
+#include <QFuture>
+#include <QAtomicInt>
+#include <QSharedPointer>
+
+namespace FT1D
+{
+
+class FFTPlan;
+class PagedSignal;
+
+/**
+ * @brief The SpectrogramWindow enum denotes the window function applied to each frame
+ */
+enum SpectrogramWindow
+{
+    HANN,       // raised cosine, touching zero at both ends
+    HAMMING,    // raised cosine, not touching zero
+    BLACKMAN,   // three term cosine window, low side lobes
+    KAISER      // Kaiser-Bessel window with beta = 8.6
+};
+
+
+/**
+ * @brief The Spectrogram class computes the short-time fourier transform of a signal.
+ * Frames are computed in batches on worker threads, sharing one FFT plan. After each batch framesReady is emitted,
+ * so the first columns can be displayed while the rest is still being computed.
+ */
+class Spectrogram : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Spectrogram constructor
+     * @param parent parent object
+     */
+    explicit Spectrogram(QObject* parent = nullptr);
+
+    /**
+     * @brief ~Spectrogram destructor, stops the computation in progress
+     */
+    virtual ~Spectrogram();
+
+    /**
+     * @brief compute starts computing the spectrogram of @a samples. Computation in progress is cancelled first.
+     * @param samples values of the signal
+     * @param window window function
+     * @param windowLength length of a frame, must be a power of two
+     * @param hop distance between starts of two consecutive frames
+     */
+    void compute(const QVector<double>& samples, SpectrogramWindow window, int windowLength, int hop);
+
+    /**
+     * @brief computeStreamed starts computing the spectrogram of an out-of-core signal. Each frame reads only its own samples
+     * from @a signal, so memory use does not depend on the length of the signal. The hop is increased if needed,
+     * so that there are at most SPECTROGRAM_MAX_STREAMED_FRAMES frames; hop() returns the hop actually used.
+     * @param signal the signal, must stay open until the computation finishes or is cancelled
+     * @param window window function
+     * @param windowLength length of a frame
+     * @param hop requested distance between starts of two consecutive frames
+     */
+    void computeStreamed(const PagedSignal* signal, SpectrogramWindow window, int windowLength, int hop);
+
+    /**
+     * @brief cancel stops the computation in progress and waits for the worker threads
+     */
+    void cancel();
+
+    /**
+     * @brief frameCount
+     * @return number of frames (time columns) of the current spectrogram
+     */
+    inline int frameCount() const
+    {
+        return frames;
+    }
+
+    /**
+     * @brief binCount
+     * @return number of frequency bins of one frame, windowLength / 2 + 1
+     */
+    inline int binCount() const
+    {
+        return bins;
+    }
+
+    /**
+     * @brief windowLength
+     * @return length of one frame
+     */
+    inline int windowLength() const
+    {
+        return length;
+    }
+
+    /**
+     * @brief hop
+     * @return distance between starts of two consecutive frames
+     */
+    inline int hop() const
+    {
+        return hopSize;
+    }
+
+    /**
+     * @brief frame access to a computed frame. Valid only for frames already announced by framesReady.
+     * @param index index of the frame
+     * @return binCount() magnitudes in decibels
+     */
+    inline const float* frame(int index) const
+    {
+        return magnitudes.constData() + index * bins;
+    }
+
+    /**
+     * @brief window computes values of the window function
+     * @param type window function
+     * @param length number of values
+     * @return window values
+     */
+    static QVector<double> window(SpectrogramWindow type, int length);
+
+signals:
+    /**
+     * @brief framesReady notifies that frames @a first .. @a first + @a count - 1 are computed
+     * @param first index of the first computed frame
+     * @param count number of computed frames
+     */
+    void framesReady(int first, int count);
+
+    /**
+     * @brief finished notifies that all frames are computed
+     */
+    void finished();
+
+    /**
+     * @brief framesComputed internal notification from the worker thread, filtered by generation before framesReady is emitted
+     */
+    void framesComputed(int generation, int first, int count);
+
+private:
+    /**
+     * @brief run the worker routine, computes all frames batch by batch
+     * @param generation identifier of the computation, used to drop notifications of cancelled runs
+     */
+    void run(int generation);
+
+    /**
+     * @brief start prepares the window and the output for sampleCount samples and starts the worker
+     * @param window window function
+     * @param windowLength length of a frame
+     * @param hop distance between starts of two consecutive frames
+     */
+    void start(SpectrogramWindow window, int windowLength, int hop);
+
+    /**
+     * @brief computeFrame computes one frame and stores its magnitudes
+     * @param index index of the frame
+     */
+    void computeFrame(int index);
+
+    /**
+     * @brief besselI0 modified Bessel function of the first kind and order zero, used by the Kaiser window
+     * @param x
+     * @return I0(x)
+     */
+    static double besselI0(double x);
+
+    QVector<double> samples;
+
+    // source of the samples instead of samples, if not null
+    const PagedSignal* source;
+    qint64 sampleCount;
+    QVector<double> windowValues;
+    double windowSum;
+
+    // plan shared by all frames, kept until the window length changes
+    QSharedPointer<FFTPlan> plan;
+
+    // frames * bins magnitudes in decibels, frame after frame
+    QVector<float> magnitudes;
+
+    int length;
+    int hopSize;
+    int frames;
+    int bins;
+
+    QFuture<void> future;
+    QAtomicInt cancelled;
+    int generation;
+};
+}
+#endif // SPECTROGRAM_H
@@ -0,0 +1,276 @@
+/**
+ * @file spectrogramwidget.cpp
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ */
+
+#include "spectrogramwidget.h"
+
+#include <algorithm>
+#include <limits>
+
+// dynamic range of the colour scale
+#define SPECTROGRAM_RANGE_DB 80.0
+
+using namespace FT1D;
+
+FT1D::SpectrogramWidget::SpectrogramWidget(QWidget *parent) : QWidget(parent)
+{
+    paged = nullptr;
+    firstX = 0;
+    spacing = 1;
+    maxLevel = -std::numeric_limits<double>::infinity();
+    dirty = false;
+
+    resize(470, 300);
+
+    plot = new QCustomPlot(this);
+    plot->setGeometry(QRect(0, 0, 465, 240));
+    plot->setInteractions(QCP::iRangeDrag | QCP::iRangeZoom);
+
+    colorMap = new QCPColorMap(plot->xAxis, plot->yAxis);
+    plot->addPlottable(colorMap);
+    colorMap->setGradient(QCPColorGradient::gpJet);
+    colorMap->setInterpolate(false);
+
+    plot->xAxis->setNumberFormat("g");
+    plot->xAxis->setNumberPrecision(3);
+    plot->yAxis->setNumberFormat("g");
+    plot->yAxis->setNumberPrecision(3);
+
+    QLabel* plotxAxisLabel = new QLabel(QStringLiteral("x"), plot);
+    plotxAxisLabel->setFont(QFont("sans-serif",10));
+    plotxAxisLabel->setGeometry(plot->width()-15,plot->height() - 27,20,20);
+
+    QLabel* plotyAxisLabel = new QLabel(QStringLiteral("ω"), plot);
+    plotyAxisLabel->setFont(QFont("sans-serif",10));
+    plotyAxisLabel->setGeometry(27,-3,30,20);
+
+    windowLabel = new QLabel(this);
+    windowLabel->setGeometry(5, 243, 55, 22);
+
+    windowComboBox = new QComboBox(this);
+    windowComboBox->setGeometry(60, 243, 95, 22);
+    windowComboBox->addItem(QStringLiteral("Hann"), HANN);
+    windowComboBox->addItem(QStringLiteral("Hamming"), HAMMING);
+    windowComboBox->addItem(QStringLiteral("Blackman"), BLACKMAN);
+    windowComboBox->addItem(QStringLiteral("Kaiser"), KAISER);
+
+    lengthLabel = new QLabel(this);
+    lengthLabel->setGeometry(165, 243, 55, 22);
+
+    lengthComboBox = new QComboBox(this);
+    lengthComboBox->setGeometry(220, 243, 75, 22);
+    for(int length = 16; length <= 4096; length *= 2)
+    {
+        lengthComboBox->addItem(QString::number(length), length);
+    }
+    lengthComboBox->setCurrentIndex(lengthComboBox->findData(256));
+
+    hopLabel = new QLabel(this);
+    hopLabel->setGeometry(305, 243, 40, 22);
+
+    hopSpinBox = new QSpinBox(this);
+    hopSpinBox->setGeometry(345, 243, 70, 22);
+    hopSpinBox->setRange(1, 256);
+    hopSpinBox->setValue(64);
+
+    spectrogram = new Spectrogram(this);
+
+    connect(spectrogram, &Spectrogram::framesReady, this, &SpectrogramWidget::displayFrames);
+
+    connect(windowComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, [=](int)
+    {
+        recompute();
+    });
+
+    connect(lengthComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, [=](int)
+    {
+        const int length = lengthComboBox->currentData().toInt();
+
+        // keep the overlap ratio, when the window length changes
+        const int hop = std::max(1, length / 4);
+        hopSpinBox->blockSignals(true);
+        hopSpinBox->setRange(1, length);
+        hopSpinBox->setValue(hop);
+        hopSpinBox->blockSignals(false);
+
+        recompute();
+    });
+
+    connect(hopSpinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, [=](int)
+    {
+        recompute();
+    });
+
+    setDefaultTexts();
+}
+
+
+FT1D::SpectrogramWidget::~SpectrogramWidget()
+{
+    spectrogram->cancel();
+    delete spectrogram;
+
+    delete windowLabel;
+    delete windowComboBox;
+    delete lengthLabel;
+    delete lengthComboBox;
+    delete hopLabel;
+    delete hopSpinBox;
+
+    delete plot;
+}
+
+
+void FT1D::SpectrogramWidget::setSignal(const Signal& signal)
+{
+    samples = signal.original.values().toVector();
+    paged = nullptr;
+    firstX = signal.original_min_x();
+    spacing = signal.spacing > 0 ? signal.spacing : 1;
+
+    dirty = true;
+    if(isVisible())
+    {
+        recompute();
+    }
+    else
+    {
+        // results for the previous signal are useless now
+        spectrogram->cancel();
+    }
+}
+
+
+void FT1D::SpectrogramWidget::setPagedSignal(const PagedSignal* signal)
+{
+    samples.clear();
+    paged = signal;
+    firstX = signal->min_x();
+    spacing = signal->spacing() > 0 ? signal->spacing() : 1;
+
+    dirty = true;
+    if(isVisible())
+    {
+        recompute();
+    }
+    else
+    {
+        // results for the previous signal are useless now
+        spectrogram->cancel();
+    }
+}
+
+
+void FT1D::SpectrogramWidget::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    if(dirty)
+    {
+        recompute();
+    }
+}
+
+
+void FT1D::SpectrogramWidget::recompute()
+{
+    if(!isVisible())
+    {
+        dirty = true;
+        return;
+    }
+    dirty = false;
+
+    const int length = lengthComboBox->currentData().toInt();
+    const int hop = hopSpinBox->value();
+    const SpectrogramWindow window = static_cast<SpectrogramWindow>(windowComboBox->currentData().toInt());
+
+    if(paged)
+    {
+        spectrogram->computeStreamed(paged, window, length, hop);
+    }
+    else
+    {
+        spectrogram->compute(samples, window, length, hop);
+    }
+
+    const int frames = spectrogram->frameCount();
+    const int bins = spectrogram->binCount();
+
+    maxLevel = -std::numeric_limits<double>::infinity();
+
+    if(frames == 0)
+    {
+        colorMap->data()->clear();
+        plot->replot();
+        return;
+    }
+
+    // frames are placed at the x coordinate of their centre, bins at their frequency
+    const double firstCentre = firstX + (length / 2) * spacing;
+    const double lastCentre = firstCentre + (frames - 1) * static_cast<double>(spectrogram->hop()) * spacing;
+    const double maxFrequency = (bins - 1) / (length * spacing);
+
+    QCPRange keyRange(firstCentre, lastCentre);
+    if(frames == 1)
+    {
+        keyRange = QCPRange(firstX, firstX + length * spacing);
+    }
+
+    colorMap->data()->setSize(frames, bins);
+    colorMap->data()->setRange(keyRange, QCPRange(0, maxFrequency));
+    colorMap->data()->fill(-SPECTROGRAM_RANGE_DB);
+    colorMap->setDataRange(QCPRange(-SPECTROGRAM_RANGE_DB, 0));
+
+    plot->xAxis->setRange(keyRange);
+    plot->yAxis->setRange(0, maxFrequency);
+    plot->replot();
+}
+
+
+void FT1D::SpectrogramWidget::displayFrames(int first, int count)
+{
+    const int bins = spectrogram->binCount();
+    QCPColorMapData* data = colorMap->data();
+
+    for(int index = first; index < first + count; index++)
+    {
+        const float* magnitudes = spectrogram->frame(index);
+        for(int k = 0; k < bins; k++)
+        {
+            data->setCell(index, k, magnitudes[k]);
+            maxLevel = std::max(maxLevel, static_cast<double>(magnitudes[k]));
+        }
+    }
+
+    colorMap->setDataRange(QCPRange(maxLevel - SPECTROGRAM_RANGE_DB, maxLevel));
+    plot->replot();
+}
+
+
+void FT1D::SpectrogramWidget::setDefaultTexts()
+{
+    windowLabel->setText(QStringLiteral("Window:"));
+    lengthLabel->setText(QStringLiteral("Length:"));
+    hopLabel->setText(QStringLiteral("Hop:"));
+}
+
+
+void FT1D::SpectrogramWidget::setLocalizedTexts(const Translation* language)
+{
+    if(!language)
+    {
+        setDefaultTexts();
+    }
+    else
+    {
+        windowLabel->setText(language->getChildElementText("windowLabel"));
+        if(windowLabel->text().isEmpty()) windowLabel->setText(QStringLiteral("Window:"));
+
+        lengthLabel->setText(language->getChildElementText("lengthLabel"));
+        if(lengthLabel->text().isEmpty()) lengthLabel->setText(QStringLiteral("Length:"));
+
+        hopLabel->setText(language->getChildElementText("hopLabel"));
+        if(hopLabel->text().isEmpty()) hopLabel->setText(QStringLiteral("Hop:"));
+    }
+}
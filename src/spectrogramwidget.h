@@ -0,0 +1,117 @@
+#ifndef SPECTROGRAMWIDGET_H
+#define SPECTROGRAMWIDGET_H
+
+/**
+ * @file spectrogramwidget.h
+ * @author Ján Bella <xbella1@fi.muni.cz>
+ *
+ * The file contains definition of the widget displaying the spectrogram (time-frequency view) of a signal.
+ */
+
+#include "qcustomplot/qcustomplot.h"
+#include "signal.h"
+#include "spectrogram.h"
+#include "pagedsignal.h"
+#include "localization.h"
+
+namespace FT1D
+{
+
+/**
+ * @brief The SpectrogramWidget class displays the short-time fourier transform of a signal as a colour map.
+ * The spectrogram is computed only when the widget is visible, columns are shown as soon as they are computed.
+ */
+class SpectrogramWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief SpectrogramWidget constructor
+     * @param parent parent object (MainWindow)
+     */
+    explicit SpectrogramWidget(QWidget *parent = 0);
+
+    /**
+     * @brief ~SpectrogramWidget destructor
+     */
+    virtual ~SpectrogramWidget();
+
+    /**
+     * @brief setSignal sets the signal, whose spectrogram is displayed. If the widget is hidden,
+     * the computation is postponed until it is shown.
+     * @param signal signal to display
+     */
+    void setSignal(const Signal& signal);
+
+    /**
+     * @brief setPagedSignal sets an out-of-core signal, whose spectrogram is displayed. Frames are streamed from the file,
+     * for long signals the hop is increased to limit the number of frames.
+     * @param signal signal to display, must stay open while it is displayed
+     */
+    void setPagedSignal(const PagedSignal* signal);
+
+    /**
+     * @brief setDefaultTexts sets defaults values to each text or title or label in the window.
+     */
+    void setDefaultTexts();
+
+    /**
+     * @brief setLocalizedTexts sets text, title or label values according to given Translation object`
+     * @param language Translation object used to set texts
+     */
+    void setLocalizedTexts(const Translation* language);
+
+protected:
+
+    /**
+     * @brief showEvent starts the postponed computation
+     */
+    void showEvent(QShowEvent* event) Q_DECL_OVERRIDE;
+
+private:
+
+    /**
+     * @brief recompute starts computation of the spectrogram with the current settings
+     */
+    void recompute();
+
+    /**
+     * @brief displayFrames copies computed frames to the colour map and replots
+     * @param first index of the first frame
+     * @param count number of frames
+     */
+    void displayFrames(int first, int count);
+
+// attributes
+    QCustomPlot* plot;
+    QCPColorMap* colorMap;
+
+    QLabel* windowLabel;
+    QComboBox* windowComboBox;
+
+    QLabel* lengthLabel;
+    QComboBox* lengthComboBox;
+
+    QLabel* hopLabel;
+    QSpinBox* hopSpinBox;
+
+    Spectrogram* spectrogram;
+
+    // copy of the displayed signal
+    QVector<double> samples;
+
+    // the displayed out-of-core signal, used instead of samples if not null
+    const PagedSignal* paged;
+    double firstX;
+    double spacing;
+
+    // the highest level displayed so far, the colour scale spans 80 dB below it
+    double maxLevel;
+
+    // true, if the signal or settings changed since the last computation
+    bool dirty;
+};
+}
+#endif // SPECTROGRAMWIDGET_H